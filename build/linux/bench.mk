@@ -0,0 +1,10 @@
+.PHONY: bench
+bench: \
+bin/bench
+
+
+bin/bench: \
+obj/bench/main.o | \
+bin/unicode.so
+	$(GPP) -o $@ obj/bench/main.o bin/unicode.so
+	bin/bench
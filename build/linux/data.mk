@@ -12,22 +12,35 @@ obj/data/getdata.o: \
 src/data/data.cpp
 
 
+obj/data/getsinglebyte.o: \
+src/data/singlebyte.cpp
+
+
 .PHONY: cleandata
 cleandata:
 	-@rm -r -f UCD
 	-@rm -r -f UCA
+	-@rm -r -f MAPPINGS
 	-@rm -f UCD.zip
 	-@rm -f src/data/collation.cpp
 	-@rm -f src/data/data.cpp
+	-@rm -f src/data/singlebyte.cpp
 
 
 .PHONY: data
 data: \
-bin/data
+bin/data \
+bin/singlebyte
+
+
+.PHONY: datafile
+datafile: \
+bin/unicode.dat
 
 
 bin/collation: \
 obj/data/getdata.o \
+obj/datafilewriter.o \
 obj/parsing/codeoutput.o \
 obj/parsing/ducet.o \
 obj/parsing/ducet_main.o | \
@@ -43,6 +56,20 @@ obj/parsing/parser.o \
 obj/parsing/tointeger.o | \
 bin/unicodedata.so
 	$(GPP) -o $@ $^ bin/unicodedata.so
+
+
+bin/singlebyte: \
+obj/parsing/codeoutput.o \
+obj/parsing/singlebyte.o \
+obj/parsing/singlebyte_main.o | \
+bin/unicodedata.so
+	$(GPP) -o $@ $^ bin/unicodedata.so
+	
+	
+bin/unicode.dat: \
+bin/collation | \
+UCA/allkeys.txt
+	bin/collation ./UCA/allkeys.txt "" ./bin/unicode.dat
 	
 	
 src/data/collation.cpp: \
@@ -59,6 +86,35 @@ UCD
 	bin/data ./UCD ./src/data/data.cpp
 	
 	
+src/data/singlebyte.cpp: \
+bin/singlebyte | \
+MAPPINGS/CP1250.TXT \
+MAPPINGS/CP1251.TXT \
+MAPPINGS/CP1252.TXT \
+MAPPINGS/CP1253.TXT \
+MAPPINGS/CP1254.TXT \
+MAPPINGS/CP1255.TXT \
+MAPPINGS/CP1256.TXT \
+MAPPINGS/CP1257.TXT \
+MAPPINGS/CP1258.TXT \
+MAPPINGS/8859-2.TXT \
+MAPPINGS/8859-3.TXT \
+MAPPINGS/8859-4.TXT \
+MAPPINGS/8859-5.TXT \
+MAPPINGS/8859-6.TXT \
+MAPPINGS/8859-7.TXT \
+MAPPINGS/8859-8.TXT \
+MAPPINGS/8859-9.TXT \
+MAPPINGS/8859-10.TXT \
+MAPPINGS/8859-11.TXT \
+MAPPINGS/8859-13.TXT \
+MAPPINGS/8859-14.TXT \
+MAPPINGS/8859-15.TXT \
+MAPPINGS/8859-16.TXT
+	$(call MKDIR,$@)
+	bin/singlebyte ./MAPPINGS ./src/data/singlebyte.cpp
+	
+	
 UCD: | \
 UCD.zip
 	unzip UCD.zip -d UCD
@@ -75,4 +131,123 @@ UCA:
 UCA/allkeys.txt: | \
 UCA
 	wget -P ./UCA http://www.unicode.org/Public/UCA/latest/allkeys.txt
+	
+	
+MAPPINGS:
+	$(call MKDIR,$@)
+
+	
+MAPPINGS/CP1250.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/VENDORS/MICSFT/WINDOWS/CP1250.TXT
+	
+	
+MAPPINGS/CP1251.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/VENDORS/MICSFT/WINDOWS/CP1251.TXT
+	
+	
+MAPPINGS/CP1252.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/VENDORS/MICSFT/WINDOWS/CP1252.TXT
+	
+	
+MAPPINGS/CP1253.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/VENDORS/MICSFT/WINDOWS/CP1253.TXT
+	
+	
+MAPPINGS/CP1254.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/VENDORS/MICSFT/WINDOWS/CP1254.TXT
+	
+	
+MAPPINGS/CP1255.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/VENDORS/MICSFT/WINDOWS/CP1255.TXT
+	
+	
+MAPPINGS/CP1256.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/VENDORS/MICSFT/WINDOWS/CP1256.TXT
+	
+	
+MAPPINGS/CP1257.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/VENDORS/MICSFT/WINDOWS/CP1257.TXT
+	
+	
+MAPPINGS/CP1258.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/VENDORS/MICSFT/WINDOWS/CP1258.TXT
+	
+	
+MAPPINGS/8859-2.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/ISO8859/8859-2.TXT
+	
+	
+MAPPINGS/8859-3.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/ISO8859/8859-3.TXT
+	
+	
+MAPPINGS/8859-4.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/ISO8859/8859-4.TXT
+	
+	
+MAPPINGS/8859-5.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/ISO8859/8859-5.TXT
+	
+	
+MAPPINGS/8859-6.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/ISO8859/8859-6.TXT
+	
+	
+MAPPINGS/8859-7.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/ISO8859/8859-7.TXT
+	
+	
+MAPPINGS/8859-8.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/ISO8859/8859-8.TXT
+	
+	
+MAPPINGS/8859-9.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/ISO8859/8859-9.TXT
+	
+	
+MAPPINGS/8859-10.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/ISO8859/8859-10.TXT
+	
+	
+MAPPINGS/8859-11.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/ISO8859/8859-11.TXT
+	
+	
+MAPPINGS/8859-13.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/ISO8859/8859-13.TXT
+	
+	
+MAPPINGS/8859-14.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/ISO8859/8859-14.TXT
+	
+	
+MAPPINGS/8859-15.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/ISO8859/8859-15.TXT
+	
+	
+MAPPINGS/8859-16.TXT: | \
+MAPPINGS
+	wget -P ./MAPPINGS http://www.unicode.org/Public/MAPPINGS/ISO8859/8859-16.TXT
 	
\ No newline at end of file
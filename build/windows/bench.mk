@@ -0,0 +1,10 @@
+.PHONY: bench
+bench: \
+bin/bench.exe
+
+
+bin/bench.exe: \
+obj/bench/main.o | \
+bin/unicode.dll
+	$(GPP) -o $@ $^ bin/unicode.dll
+	bin/bench.exe
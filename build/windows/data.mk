@@ -3,11 +3,18 @@ all: data
 
 .PHONY: data
 data: \
-bin/data.exe
+bin/data.exe \
+bin/singlebyte.exe
+
+
+.PHONY: datafile
+datafile: \
+bin/unicode.dat
 
 
 bin/collation.exe: \
 obj/data/getdata.o \
+obj/datafilewriter.o \
 obj/parsing/codeoutput.o \
 obj/parsing/ducet.o \
 obj/parsing/ducet_main.o | \
@@ -23,6 +30,20 @@ obj/parsing/parser.o \
 obj/parsing/tointeger.o | \
 bin/unicodedata.dll
 	$(GPP) -o $@ $^ bin/unicodedata.dll
+
+
+bin/singlebyte.exe: \
+obj/parsing/codeoutput.o \
+obj/parsing/singlebyte.o \
+obj/parsing/singlebyte_main.o | \
+bin/unicodedata.dll
+	$(GPP) -o $@ $^ bin/unicodedata.dll
+	
+	
+bin/unicode.dat: \
+bin/collation.exe | \
+UCA/allkeys.txt
+	bin/collation.exe ./UCA/allkeys.txt "" ./bin/unicode.dat
 	
 	
 src/data/collation.cpp: \
@@ -36,4 +57,11 @@ src/data/data.cpp: \
 bin/data.exe | \
 UCD
 	$(call MKDIR,$@)
-	bin/data.exe ./UCD ./src/data/data.cpp
\ No newline at end of file
+	bin/data.exe ./UCD ./src/data/data.cpp
+	
+	
+src/data/singlebyte.cpp: \
+bin/singlebyte.exe | \
+MAPPINGS
+	$(call MKDIR,$@)
+	bin/singlebyte.exe ./MAPPINGS ./src/data/singlebyte.cpp
\ No newline at end of file
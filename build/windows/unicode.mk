@@ -17,15 +17,25 @@ obj/condition.o \
 obj/conditions.o \
 obj/data/getcollation.o \
 obj/data/getdata.o \
+obj/data/getsinglebyte.o \
+obj/datafile.o \
+obj/datafilewriter.o \
 obj/defaultlocale.o \
+obj/detectencoding.o \
 obj/encoding.o \
 obj/encodingaction.o \
 obj/encodingerror.o \
+obj/encodingerrorlog.o \
+obj/encodingerrorsink.o \
 obj/endianencoding.o \
 obj/error.o \
 obj/latin1.o \
+obj/loadfile.o \
 obj/locale.o \
+obj/mappedfile.o \
 obj/normalizer.o \
+obj/singlebyte.o \
+obj/streamdecoder.o \
 obj/string.o \
 obj/ucs2.o \
 obj/utf8.o \
@@ -39,6 +39,31 @@ namespace Unicode {
 	bool IsGraphemeClusterBoundary (const CodePoint * loc, const CodePoint * begin, const CodePoint * end, const Locale & locale=Locale::Get()) noexcept;
 	
 	
+	/**
+	 *	Determines where grapheme cluster boundaries occur within a
+	 *	string.
+	 *
+	 *	Equivalent to invoking IsGraphemeClusterBoundary at each
+	 *	location within the string (including the end),
+	 *	but properties are retrieved for the entire string
+	 *	at once, which is much faster.
+	 *
+	 *	\param [in] begin
+	 *		An iterator to the beginning of the string.
+	 *	\param [in] end
+	 *		An iterator to the end of the string.
+	 *	\param [out] out
+	 *		A pointer to an array of at least
+	 *		(\em end-\em begin)+1 elements.  The element
+	 *		at index \em i shall be set to the result of
+	 *		invoking IsGraphemeClusterBoundary with \em begin+\em i.
+	 *	\param [in] locale
+	 *		The locale to use.  Optional.  Defaults to
+	 *		the current locale.
+	 */
+	void FindGraphemeClusterBoundaries (const CodePoint * begin, const CodePoint * end, bool * out, const Locale & locale=Locale::Get());
+	
+	
 	/**
 	 *	Determines if a word boundary occurs
 	 *	immediately before a certain code point.
@@ -64,6 +89,31 @@ namespace Unicode {
 	bool IsWordBoundary (const CodePoint * loc, const CodePoint * begin, const CodePoint * end, const Locale & locale=Locale::Get()) noexcept;
 	
 	
+	/**
+	 *	Determines where word boundaries occur within a
+	 *	string.
+	 *
+	 *	Equivalent to invoking IsWordBoundary at each
+	 *	location within the string (including the end),
+	 *	but properties are retrieved for the entire string
+	 *	at once, which is much faster.
+	 *
+	 *	\param [in] begin
+	 *		An iterator to the beginning of the string.
+	 *	\param [in] end
+	 *		An iterator to the end of the string.
+	 *	\param [out] out
+	 *		A pointer to an array of at least
+	 *		(\em end-\em begin)+1 elements.  The element
+	 *		at index \em i shall be set to the result of
+	 *		invoking IsWordBoundary with \em begin+\em i.
+	 *	\param [in] locale
+	 *		The locale to use.  Optional.  Defaults to
+	 *		the current locale.
+	 */
+	void FindWordBoundaries (const CodePoint * begin, const CodePoint * end, bool * out, const Locale & locale=Locale::Get());
+	
+	
 	/**
 	 *	Determines if a mandatory line break occurs
 	 *	immediately before a certain code point.
@@ -86,6 +136,56 @@ namespace Unicode {
 	 *		before \em loc, \em false otherwise.
 	 */
 	bool IsLineBreak (const CodePoint * loc, const CodePoint * begin, const CodePoint * end, const Locale & locale=Locale::Get()) noexcept;
+	
+	
+	/**
+	 *	Determines where mandatory line breaks occur within a
+	 *	string.
+	 *
+	 *	Equivalent to invoking IsLineBreak at each
+	 *	location within the string (including the end),
+	 *	but properties are retrieved for the entire string
+	 *	at once, which is much faster.
+	 *
+	 *	\param [in] begin
+	 *		An iterator to the beginning of the string.
+	 *	\param [in] end
+	 *		An iterator to the end of the string.
+	 *	\param [out] out
+	 *		A pointer to an array of at least
+	 *		(\em end-\em begin)+1 elements.  The element
+	 *		at index \em i shall be set to the result of
+	 *		invoking IsLineBreak with \em begin+\em i.
+	 *	\param [in] locale
+	 *		The locale to use.  Optional.  Defaults to
+	 *		the current locale.
+	 */
+	void FindLineBreaks (const CodePoint * begin, const CodePoint * end, bool * out, const Locale & locale=Locale::Get());
+	
+	
+	/**
+	 *	Finds the first line terminator within a string,
+	 *	i.e.\ the first code point after which a mandatory
+	 *	line break occurs.  A CR followed by an LF is a
+	 *	single line terminator, and is found as the CR.
+	 *
+	 *	Much faster than invoking IsLineBreak at each
+	 *	location, since only code points which may be line
+	 *	terminators are examined in detail.
+	 *
+	 *	\param [in] begin
+	 *		An iterator to the beginning of the string.
+	 *	\param [in] end
+	 *		An iterator to the end of the string.
+	 *	\param [in] locale
+	 *		The locale to use.  Optional.  Defaults to
+	 *		the current locale.
+	 *
+	 *	\return
+	 *		An iterator to the first line terminator, or
+	 *		\em end if there is none.
+	 */
+	const CodePoint * FindLineTerminator (const CodePoint * begin, const CodePoint * end, const Locale & locale=Locale::Get()) noexcept;
 
 
 }
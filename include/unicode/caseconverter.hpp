@@ -43,6 +43,14 @@ namespace Unicode {
 			) const noexcept;
 			
 			
+			Array<CodePoint> get (
+				const CodePointInfo *,
+				const CodePoint *,
+				const CodePoint *,
+				const CodePoint *,
+				std::optional<CodePoint::Type> (CodePointInfo::*),
+				Array<CaseMapping> (CodePointInfo::*)
+			) const noexcept;
 			Array<CodePoint> get (
 				const CodePoint *,
 				const CodePoint *,
@@ -9,6 +9,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <string>
 #include <type_traits>
 
 
@@ -21,6 +22,7 @@ namespace Unicode {
 
 
 	class CodePointInfo;
+	class DataFile;
 	class Locale;
 	
 	
@@ -132,7 +134,26 @@ namespace Unicode {
 			 *		\em true if this code point is valid,
 			 *		\em false otherwise.
 			 */
-			bool IsValid () const noexcept;
+			constexpr bool IsValid () const noexcept {
+			
+				//	To large to be valid Unicode
+				if (cp>Max) return false;
+				
+				//	UTF-16 lead/trail surrogate
+				if ((cp>=0xD800U) && (cp<=0xDFFFU)) return false;
+				
+				//	Arbitrary contiguous range of 32 non-character
+				//	code points
+				if ((cp>=0xFDD0U) && (cp<=0xFDEFU)) return false;
+				
+				//	Invalid Unicode
+				auto low=cp&65535U;
+				if ((low==0xFFFEU) || (low==0xFFFFU)) return false;
+				
+				//	All good
+				return true;
+			
+			}
 			
 			
 			/** 
@@ -154,6 +175,21 @@ namespace Unicode {
 			const CodePointInfo * GetInfo (const Locale & locale=get_locale()) const noexcept;
 			
 			
+			/**
+			 *	Retrieves the name of this code point.
+			 *
+			 *	\param [in] locale
+			 *		The locale from which to get information
+			 *		about this code point.  Optional.  Defaults
+			 *		to the current locale.
+			 *
+			 *	\return
+			 *		The name of this code point, or the empty
+			 *		string if it has no name.
+			 */
+			std::string GetName (const Locale & locale=get_locale()) const;
+			
+			
 			/**
 			 *	Determines whether this code point is
 			 *	white space.
@@ -306,6 +342,212 @@ namespace Unicode {
 	}
 	
 	
+	/**
+	 *	A two stage lookup table which maps code points
+	 *	to indices into an array of records.
+	 *
+	 *	The code space is divided into blocks of
+	 *	2<sup>Shift</sup> consecutive code points.  The
+	 *	first stage maps the number of a block to a
+	 *	block in the second stage, and the second stage
+	 *	maps each code point within that block to an
+	 *	index.  Identical blocks in the second stage are
+	 *	shared, so unassigned regions of the code space
+	 *	cost only a single entry in the first stage.
+	 */
+	class CodePointIndex {
+	
+	
+		public:
+		
+		
+			/**
+			 *	The base two logarithm of the number of
+			 *	code points in each block.
+			 */
+			static constexpr std::size_t Shift=7;
+			/**
+			 *	The index which indicates that there is no
+			 *	record for a certain code point.
+			 */
+			static constexpr std::uint16_t None=0xFFFFU;
+			
+			
+			/**
+			 *	The first stage, which maps block numbers
+			 *	(i.e. code points shifted right by Shift
+			 *	bits) to blocks in the second stage.
+			 */
+			Array<std::uint16_t> Blocks;
+			/**
+			 *	The second stage, which consists of blocks
+			 *	of indices, each 2<sup>Shift</sup> entries
+			 *	long.
+			 */
+			Array<std::uint16_t> Indices;
+			
+			
+			/**
+			 *	Determines whether this index is empty.
+			 *
+			 *	\return
+			 *		\em true if this index contains no entries,
+			 *		\em false otherwise.
+			 */
+			constexpr bool IsEmpty () const noexcept {
+			
+				return Blocks.Size==0;
+			
+			}
+			
+			
+			/**
+			 *	Determines the position of a code point within
+			 *	the second stage.
+			 *
+			 *	Arrays parallel to the second stage may be
+			 *	indexed by this position.
+			 *
+			 *	\param [in] cp
+			 *		The code point.
+			 *
+			 *	\return
+			 *		The position of \em cp within Indices, or
+			 *		the size of Indices if \em cp is outside the
+			 *		range covered by this index.
+			 */
+			std::size_t Offset (CodePoint::Type cp) const noexcept {
+			
+				std::size_t block=cp>>Shift;
+				if (block>=Blocks.Size) return Indices.Size;
+				
+				return (static_cast<std::size_t>(Blocks[block])<<Shift)|
+					(cp&((static_cast<CodePoint::Type>(1)<<Shift)-1));
+			
+			}
+			
+			
+			/**
+			 *	Looks up a code point.
+			 *
+			 *	\param [in] cp
+			 *		The code point to look up.
+			 *
+			 *	\return
+			 *		The index associated with \em cp, or
+			 *		None if there is no such index.
+			 */
+			std::uint16_t Get (CodePoint::Type cp) const noexcept {
+			
+				auto offset=Offset(cp);
+				
+				return (offset==Indices.Size) ? None : Indices[offset];
+			
+			}
+	
+	
+	};
+	
+	
+	/**
+	 *	An array of unsigned integers, each of which
+	 *	is packed into a fixed number of bits.
+	 *
+	 *	Values are packed starting at the least significant
+	 *	bits of each byte.
+	 *
+	 *	\tparam Bits
+	 *		The number of bits in each value.  Must
+	 *		divide eight.
+	 */
+	template <std::size_t Bits>
+	class PackedArray {
+	
+	
+		static_assert(
+			(Bits!=0) && (Bits<=8) && ((8%Bits)==0),
+			"Number of bits must divide eight"
+		);
+		
+		
+		public:
+		
+		
+			/**
+			 *	The number of values in each byte.
+			 */
+			static constexpr std::size_t PerByte=8/Bits;
+			
+			
+			/**
+			 *	The underlying bytes.
+			 */
+			Array<std::uint8_t> Data;
+			
+			
+			/**
+			 *	Determines whether this array is empty.
+			 *
+			 *	\return
+			 *		\em true if this array contains no values,
+			 *		\em false otherwise.
+			 */
+			constexpr bool IsEmpty () const noexcept {
+			
+				return Data.Size==0;
+			
+			}
+			
+			
+			/**
+			 *	Retrieves a value.
+			 *
+			 *	\param [in] i
+			 *		The index of the value to retrieve.
+			 *
+			 *	\return
+			 *		The value.
+			 */
+			constexpr std::uint8_t operator [] (std::size_t i) const noexcept {
+			
+				return static_cast<std::uint8_t>(
+					(Data[i/PerByte]>>((i%PerByte)*Bits))&((1U<<Bits)-1)
+				);
+			
+			}
+	
+	
+	};
+	
+	
+	/**
+	 *	Packed tables of frequently accessed properties,
+	 *	each of which is parallel to the second stage of
+	 *	a CodePointIndex.
+	 *
+	 *	Each value is the numeric value of the property
+	 *	for the corresponding code point.  Code points
+	 *	for which there is no CodePointInfo structure have
+	 *	the property's default value.
+	 */
+	class PropertyTables {
+	
+	
+		public:
+		
+		
+			PackedArray<8> CanonicalCombiningClass;
+			PackedArray<8> GeneralCategory;
+			PackedArray<4> GraphemeClusterBreak;
+			PackedArray<8> WordBreak;
+			PackedArray<8> LineBreak;
+			PackedArray<2> NFCQuickCheck;
+			PackedArray<2> NFDQuickCheck;
+	
+	
+	};
+	
+	
 	/**
 	 *	Possible general categories for a Unicode code point.
 	 */
@@ -572,6 +814,9 @@ namespace Unicode {
 		private:
 		
 		
+			friend class DataFile;
+			
+			
 			bool negated;
 			const char * cond;
 			
@@ -642,7 +887,57 @@ namespace Unicode {
 	
 	
 	/**
-	 *	Contains information about a Unicode code point.
+	 *	Binary properties of code points, each of which
+	 *	is a single bit of CodePointInfo::Flags.
+	 *
+	 *	Masks formed by combining these with bitwise OR
+	 *	test several properties at once.
+	 */
+	namespace BinaryProperty {
+	
+	
+		constexpr std::uint64_t WhiteSpace=static_cast<std::uint64_t>(1)<<0;	/**<	White_Space	*/
+		constexpr std::uint64_t Alphabetic=static_cast<std::uint64_t>(1)<<1;	/**<	Alphabetic	*/
+		constexpr std::uint64_t NoncharacterCodePoint=static_cast<std::uint64_t>(1)<<2;	/**<	Noncharacter_Code_Point	*/
+		constexpr std::uint64_t DefaultIgnorableCodePoint=static_cast<std::uint64_t>(1)<<3;	/**<	Default_Ignorable_Code_Point	*/
+		constexpr std::uint64_t Deprecated=static_cast<std::uint64_t>(1)<<4;	/**<	Deprecated	*/
+		constexpr std::uint64_t LogicalOrderException=static_cast<std::uint64_t>(1)<<5;	/**<	Logical_Order_Exception	*/
+		constexpr std::uint64_t VariationSelector=static_cast<std::uint64_t>(1)<<6;	/**<	Variation_Selector	*/
+		constexpr std::uint64_t Uppercase=static_cast<std::uint64_t>(1)<<7;	/**<	Uppercase	*/
+		constexpr std::uint64_t Lowercase=static_cast<std::uint64_t>(1)<<8;	/**<	Lowercase	*/
+		constexpr std::uint64_t SoftDotted=static_cast<std::uint64_t>(1)<<9;	/**<	Soft_Dotted	*/
+		constexpr std::uint64_t Cased=static_cast<std::uint64_t>(1)<<10;	/**<	Cased	*/
+		constexpr std::uint64_t CaseIgnorable=static_cast<std::uint64_t>(1)<<11;	/**<	Case_Ignorable	*/
+		constexpr std::uint64_t HexDigit=static_cast<std::uint64_t>(1)<<12;	/**<	Hex_Digit	*/
+		constexpr std::uint64_t ASCIIHexDigit=static_cast<std::uint64_t>(1)<<13;	/**<	ASCII_Hex_Digit	*/
+		constexpr std::uint64_t CompositionExclusion=static_cast<std::uint64_t>(1)<<14;	/**<	Composition_Exclusion	*/
+		constexpr std::uint64_t FullCompositionExclusion=static_cast<std::uint64_t>(1)<<15;	/**<	Full_Composition_Exclusion	*/
+		constexpr std::uint64_t BidirectionalControl=static_cast<std::uint64_t>(1)<<16;	/**<	Bidi_Control	*/
+		constexpr std::uint64_t Mirrored=static_cast<std::uint64_t>(1)<<17;	/**<	Bidi_Mirrored	*/
+		constexpr std::uint64_t Ideographic=static_cast<std::uint64_t>(1)<<18;	/**<	Ideographic	*/
+		constexpr std::uint64_t UnifiedIdeograph=static_cast<std::uint64_t>(1)<<19;	/**<	Unified_Ideograph	*/
+		constexpr std::uint64_t Radical=static_cast<std::uint64_t>(1)<<20;	/**<	Radical	*/
+		constexpr std::uint64_t Math=static_cast<std::uint64_t>(1)<<21;	/**<	Math	*/
+		constexpr std::uint64_t QuotationMark=static_cast<std::uint64_t>(1)<<22;	/**<	Quotation_Mark	*/
+		constexpr std::uint64_t Dash=static_cast<std::uint64_t>(1)<<23;	/**<	Dash	*/
+		constexpr std::uint64_t Hyphen=static_cast<std::uint64_t>(1)<<24;	/**<	Hyphen	*/
+		constexpr std::uint64_t STerm=static_cast<std::uint64_t>(1)<<25;	/**<	STerm	*/
+		constexpr std::uint64_t TerminalPunctuation=static_cast<std::uint64_t>(1)<<26;	/**<	Terminal_Punctuation	*/
+		constexpr std::uint64_t Diacritic=static_cast<std::uint64_t>(1)<<27;	/**<	Diacritic	*/
+		constexpr std::uint64_t Extender=static_cast<std::uint64_t>(1)<<28;	/**<	Extender	*/
+		constexpr std::uint64_t GraphemeBase=static_cast<std::uint64_t>(1)<<29;	/**<	Grapheme_Base	*/
+		constexpr std::uint64_t GraphemeLink=static_cast<std::uint64_t>(1)<<30;	/**<	Grapheme_Link	*/
+	
+	
+	}
+	
+	
+	/**
+	 *	Contains the properties of a Unicode code point.
+	 *
+	 *	Code points whose properties are identical share
+	 *	a single structure, so this structure does not
+	 *	identify or name any code point.  See CodePointRecord.
 	 */
 	class CodePointInfo {
 
@@ -650,26 +945,19 @@ namespace Unicode {
 		public:
 		
 		
-			Unicode::CodePoint::Type CodePoint;
-		
 			//	General
-			const char * Name;
 			const char * Alias;
 			const char * Abbreviation;
-			const char * Block;
+			std::uint16_t Block;
 			Unicode::GeneralCategory GeneralCategory;
-			const char * Script;
-			bool WhiteSpace;
-			bool Alphabetic;
-			bool NoncharacterCodePoint;
-			bool DefaultIgnorableCodePoint;
-			bool Deprecated;
-			bool LogicalOrderException;
-			bool VariationSelector;
+			std::uint16_t Script;
+			/**
+			 *	The binary properties of the code point,
+			 *	as a combination of BinaryProperty constants.
+			 */
+			std::uint64_t Flags;
 			
 			//	Case
-			bool Uppercase;
-			bool Lowercase;
 			Array<CaseMapping> LowercaseMappings;
 			Array<CaseMapping> TitlecaseMappings;
 			Array<CaseMapping> UppercaseMappings;
@@ -678,20 +966,13 @@ namespace Unicode {
 			std::optional<Unicode::CodePoint::Type> SimpleTitlecaseMapping;
 			std::optional<Unicode::CodePoint::Type> SimpleUppercaseMapping;
 			std::optional<Unicode::CodePoint::Type> SimpleCaseFolding;
-			bool SoftDotted;
-			bool Cased;
-			bool CaseIgnorable;
 			
 			//	Numeric
 			std::optional<Unicode::Numeric> Numeric;
-			bool HexDigit;
-			bool ASCIIHexDigit;
 			
 			//	Normalization
 			std::size_t CanonicalCombiningClass;
 			Array<Unicode::CodePoint::Type> DecompositionMapping;
-			bool CompositionExclusion;
-			bool FullCompositionExclusion;
 			QuickCheck NFCQuickCheck;
 			QuickCheck NFDQuickCheck;
 			
@@ -703,30 +984,88 @@ namespace Unicode {
 			
 			//	Bidirectional
 			Unicode::BidirectionalClass BidirectionalClass;
-			bool BidirectionalControl;
-			bool Mirrored;
-			
-			//	CJK
-			bool Ideographic;
-			bool UnifiedIdeograph;
-			bool Radical;
-			
-			//	Miscellaneous
-			bool Math;
-			bool QuotationMark;
-			bool Dash;
-			bool Hyphen;
-			bool STerm;
-			bool TerminalPunctuation;
-			bool Diacritic;
-			bool Extender;
-			bool GraphemeBase;
-			bool GraphemeLink;
+			
+			
+			/**
+			 *	Determines whether the code point has any of
+			 *	a set of binary properties.
+			 *
+			 *	\param [in] mask
+			 *		A combination of BinaryProperty constants.
+			 *
+			 *	\return
+			 *		\em true if the code point has at least one
+			 *		of the properties in \em mask, \em false
+			 *		otherwise.
+			 */
+			constexpr bool HasAny (std::uint64_t mask) const noexcept {
+			
+				return (Flags&mask)!=0;
+			
+			}
+			/**
+			 *	Determines whether the code point has all of
+			 *	a set of binary properties.
+			 *
+			 *	\param [in] mask
+			 *		A combination of BinaryProperty constants.
+			 *
+			 *	\return
+			 *		\em true if the code point has every one
+			 *		of the properties in \em mask, \em false
+			 *		otherwise.
+			 */
+			constexpr bool HasAll (std::uint64_t mask) const noexcept {
+			
+				return (Flags&mask)==mask;
+			
+			}
 
 
 	};
 	
 	
+	/**
+	 *	Associates a Unicode code point, or a contiguous
+	 *	range of code points which share all their properties,
+	 *	with its name and its CodePointInfo structure.
+	 */
+	class CodePointRecord {
+	
+	
+		public:
+		
+		
+			/**
+			 *	The first code point described by this
+			 *	record.
+			 */
+			Unicode::CodePoint::Type CodePoint;
+			/**
+			 *	The last code point described by this
+			 *	record.  Equal to CodePoint unless this
+			 *	record describes a range.
+			 */
+			Unicode::CodePoint::Type Last;
+			/**
+			 *	The offset of the name of the code point
+			 *	within a block of null terminated names, or,
+			 *	if the name of the code point is derived
+			 *	algorithmically, the offset of a prefix to
+			 *	which the code point in hexadecimal is appended.
+			 *	Use Locale::GetName to retrieve complete names.
+			 */
+			std::uint32_t Name;
+			/**
+			 *	The index of the CodePointInfo structure
+			 *	which gives the properties of the code point.
+			 */
+			std::uint16_t Info;
+	
+	
+	};
+	
+	
 	/**
 	 *	Contains information about a Unicode
 	 *	composition.
@@ -8,6 +8,7 @@
 
 #include <unicode/codepoint.hpp>
 #include <unicode/locale.hpp>
+#include <cstdint>
 #include <optional>
 #include <vector>
 
@@ -57,6 +58,10 @@ namespace Unicode {
 			//	Null means all levels, zero means
 			//	identical, otherwise it's numerical
 			std::optional<std::size_t> strength;
+			//	The blocks whose unified ideographs are
+			//	weighted before all others
+			std::uint16_t cjk_unified;
+			std::uint16_t cjk_compatibility;
 			
 			
 			bool is_backwards () const noexcept;
@@ -82,7 +87,9 @@ namespace Unicode {
 			 */
 			Collator (const Locale & locale=Locale::Get()) noexcept
 				:	locale(locale),
-					vo(VariableOrdering::NonIgnorable)
+					vo(VariableOrdering::NonIgnorable),
+					cjk_unified(locale.FindBlock("CJK Unified Ideographs")),
+					cjk_compatibility(locale.FindBlock("CJK Compatibility Ideographs"))
 			{	}
 			
 			
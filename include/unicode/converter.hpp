@@ -578,7 +578,7 @@ namespace Unicode {
 				for (;begin!=end;++begin) {
 				
 					auto cpi=begin->GetInfo(locale);
-					if ((cpi==nullptr) || (!cpi->WhiteSpace)) break;
+					if ((cpi==nullptr) || !cpi->HasAny(BinaryProperty::WhiteSpace)) break;
 				
 				}
 			
@@ -14,6 +14,13 @@ namespace Unicode {
 
 
 	Array<CodePointInfo> Data () noexcept;
+	Array<CodePointRecord> DataRecords () noexcept;
+	Array<char> DataNames () noexcept;
+	Array<const char *> DataBlockNames () noexcept;
+	Array<const char *> DataScriptNames () noexcept;
+	CodePointIndex DataIndex () noexcept;
+	Array<const CodePointInfo *> DataLatin1 () noexcept;
+	PropertyTables DataProperties () noexcept;
 	Array<Composition> Compositions () noexcept;
 	Array<CollationTableEntry> CollationTable () noexcept;
 
@@ -0,0 +1,230 @@
+/**
+ *	\file
+ */
+
+
+#pragma once
+
+
+#include <unicode/locale.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+namespace Unicode {
+
+
+	/**
+	 *	\cond
+	 */
+	
+	
+	class MappedFile;
+	
+	
+	//	An array within a data file, which refers to its
+	//	elements by their distance in bytes from itself
+	//	so that the file may be mapped at any address
+	template <typename T>
+	class RelativeArray {
+	
+	
+		public:
+		
+		
+			std::int64_t Offset;
+			std::uint64_t Size;
+	
+	
+	};
+	
+	
+	//	Appears at the beginning of every data file
+	//
+	//	Tables whose elements contain arrays or strings
+	//	are followed by pools which hold the contents of
+	//	those arrays and strings.  Within the elements an
+	//	array's Data holds the index of its first element
+	//	in the appropriate pool, and a string holds one
+	//	more than its offset into Strings (so that null
+	//	remains null).
+	class DataFileHeader {
+	
+	
+		public:
+		
+		
+			//	Identifies data files
+			static const char Identifier [8];
+			//	Data files may only be read by builds which
+			//	agree on the representation of everything
+			//	stored in them
+			static const std::uint32_t Representation [9];
+			
+			
+			char Magic [sizeof(Identifier)];
+			std::uint32_t Format;
+			std::uint32_t Layout [sizeof(Representation)/sizeof(*Representation)];
+			std::uint64_t Size;
+			std::uint64_t Version;
+			
+			//	Tables
+			RelativeArray<CodePointInfo> Info;
+			RelativeArray<CodePointRecord> Records;
+			RelativeArray<char> Names;
+			RelativeArray<std::uint64_t> BlockNames;
+			RelativeArray<std::uint64_t> ScriptNames;
+			RelativeArray<std::uint16_t> Blocks;
+			RelativeArray<std::uint16_t> Indices;
+			RelativeArray<std::uint8_t> CanonicalCombiningClass;
+			RelativeArray<std::uint8_t> GeneralCategory;
+			RelativeArray<std::uint8_t> GraphemeClusterBreak;
+			RelativeArray<std::uint8_t> WordBreak;
+			RelativeArray<std::uint8_t> LineBreak;
+			RelativeArray<std::uint8_t> NFCQuickCheck;
+			RelativeArray<std::uint8_t> NFDQuickCheck;
+			RelativeArray<Composition> Compositions;
+			RelativeArray<CollationTableEntry> CollationTable;
+			
+			//	Pools
+			RelativeArray<char> Strings;
+			RelativeArray<CodePoint::Type> CodePoints;
+			RelativeArray<std::uint16_t> Weights;
+			RelativeArray<Condition> Conditions;
+			RelativeArray<CaseMapping> CaseMappings;
+			RelativeArray<CollationElement> CollationElements;
+	
+	
+	};
+	
+	
+	/**
+	 *	\endcond
+	 */
+	
+	
+	/**
+	 *	A binary file containing the tables of a locale,
+	 *	mapped into memory.
+	 *
+	 *	The tables are stored in their in memory
+	 *	representation, so loading a data file performs
+	 *	no parsing.  Tables which contain no pointers are
+	 *	used in place, so the file is mapped read only,
+	 *	is never modified, and is shared between all
+	 *	processes which map it.  Tables whose elements
+	 *	contain arrays or strings are copied once when
+	 *	the file is loaded, and the references within
+	 *	their elements are checked and resolved.
+	 *
+	 *	Data files are only valid for the platform and
+	 *	build of the library which wrote them.  The
+	 *	collation generator (bin/collation) writes one
+	 *	from the parsed Unicode Character Database and
+	 *	Default Unicode Collation Element Table, so the
+	 *	version of Unicode may be changed without
+	 *	rebuilding the library.
+	 */
+	class DataFile {
+	
+	
+		private:
+		
+		
+			class writer;
+			
+			
+			std::unique_ptr<MappedFile> file;
+			const char * version;
+			std::vector<Condition> conditions;
+			std::vector<CaseMapping> mappings;
+			std::vector<CodePointInfo> info;
+			std::vector<const char *> blocks;
+			std::vector<const char *> scripts;
+			std::vector<Composition> compositions;
+			std::vector<CollationElement> elements;
+			std::vector<CollationTableEntry> collation;
+			const CodePointInfo * latin1 [256];
+		
+		
+		public:
+		
+		
+			/**
+			 *	The current version of the format of data
+			 *	files.  Files with any other version cannot
+			 *	be loaded.
+			 */
+			static constexpr std::size_t FormatVersion=5;
+			
+			
+			/**
+			 *	A locale whose Records, Names, InfoIndex, and
+			 *	Properties are views into the data file, and
+			 *	whose Info, BlockNames, ScriptNames, Compositions,
+			 *	and CollationTable are copied from it when it is
+			 *	loaded.  Latin1Info is built from InfoIndex when
+			 *	the file is loaded.
+			 *	All other members are copied from DefaultLocale.
+			 *
+			 *	Valid only for the lifetime of this object.
+			 */
+			Unicode::Locale Locale;
+			
+			
+			DataFile () = delete;
+			DataFile (const DataFile &) = delete;
+			DataFile (DataFile &&) = delete;
+			DataFile & operator = (const DataFile &) = delete;
+			DataFile & operator = (DataFile &&) = delete;
+			
+			
+			/**
+			 *	Maps a data file into memory.  Files which
+			 *	cannot be mapped, such as pipes, are read
+			 *	instead.
+			 *
+			 *	\param [in] filename
+			 *		A C string containing the name of the
+			 *		data file.
+			 */
+			DataFile (const char * filename);
+			/**
+			 *	Unmaps the data file.
+			 */
+			~DataFile () noexcept;
+			
+			
+			/**
+			 *	Retrieves the version string which was stored
+			 *	in the data file when it was written.
+			 *
+			 *	\return
+			 *		A C string containing the version, which
+			 *		is empty if no version was stored.
+			 */
+			const char * Version () const noexcept;
+			
+			
+			/**
+			 *	Writes the tables of a locale to a data file.
+			 *
+			 *	\param [in] locale
+			 *		The locale whose tables shall be written.
+			 *	\param [in] filename
+			 *		A C string containing the name of the file
+			 *		to write.
+			 *	\param [in] version
+			 *		A C string identifying the version of
+			 *		the data, e.g. the version of The Unicode
+			 *		Standard.  Optional.
+			 */
+			static void Write (const Unicode::Locale & locale, const char * filename, const char * version="");
+	
+	
+	};
+
+
+}
@@ -0,0 +1,82 @@
+/**
+ *	\file
+ */
+
+
+#pragma once
+
+
+#include <unicode/encoding.hpp>
+#include <cstddef>
+#include <memory>
+
+
+namespace Unicode {
+
+
+	/**
+	 *	The result of detecting the encoding of a
+	 *	sequence of bytes.
+	 */
+	class DetectedEncoding {
+	
+	
+		public:
+		
+		
+			/**
+			 *	An encoding configured to decode the bytes,
+			 *	including their byte order and whether or not
+			 *	they begin with a byte order mark.  Encoding
+			 *	with it produces bytes in the same form.
+			 */
+			std::unique_ptr<Unicode::Encoding> Encoding;
+			/**
+			 *	How certain the detection is, from zero (a guess
+			 *	based on nothing at all) to one (certain).
+			 */
+			double Confidence;
+	
+	
+	};
+	
+	
+	/**
+	 *	Detects the encoding of a sequence of bytes which
+	 *	may not be labelled in any way.
+	 *
+	 *	Only a bounded prefix of the bytes is examined, in
+	 *	a single pass which counts null bytes at each
+	 *	position and bytes outside ASCII, followed by
+	 *	validating the prefix in the most likely encoding.
+	 *	The encodings which may be detected are:
+	 *
+	 *	-	UTF-8, UTF-16, and UTF-32 beginning with a
+	 *		byte order mark (certain)
+	 *	-	UTF-32 and UTF-16 in either byte order, from
+	 *		the null bytes that text in them contains
+	 *	-	ASCII, if every byte is ASCII
+	 *	-	UTF-8, if the bytes are valid UTF-8, with
+	 *		more certainty the more multi-byte sequences
+	 *		they contain
+	 *	-	Latin-1, if nothing else fits, since any
+	 *		bytes are valid Latin-1
+	 *
+	 *	If only part of the bytes were examined and they
+	 *	were all ASCII, UTF-8 is detected rather than ASCII.
+	 *
+	 *	\param [in] begin
+	 *		An iterator to the beginning of the bytes.
+	 *	\param [in] end
+	 *		An iterator to the end of the bytes.
+	 *	\param [in] max
+	 *		The greatest number of bytes to examine.
+	 *		Defaults to 65536.
+	 *
+	 *	\return
+	 *		The detected encoding.
+	 */
+	DetectedEncoding DetectEncoding (const void * begin, const void * end, std::size_t max=65536);
+
+
+}
@@ -14,12 +14,17 @@
 #include <cstddef>
 #include <iterator>
 #include <optional>
+#include <string>
 #include <utility>
+#include <vector>
 
 
 namespace Unicode {
 
 
+	class StreamDecoder;
+
+
 	/**
 	 *	An enumeration of the various types of errors
 	 *	that can be encountered when encoding or
@@ -224,6 +229,182 @@ namespace Unicode {
 				action=Action::Nothing;
 			
 			}
+			
+			
+			/**
+			 *	Determines what replacement executing the error
+			 *	action would make, substituting a replacement for
+			 *	throwing.
+			 *
+			 *	\param [in] fallback
+			 *		The code point to replace with if the action
+			 *		is to throw.
+			 *
+			 *	\return
+			 *		A disengaged optional if no replacement is to be
+			 *		made.  An engaged optional containing a replacement
+			 *		code point otherwise.
+			 */
+			std::optional<CodePoint> Replacement (CodePoint fallback) const noexcept;
+	
+	
+	};
+	
+	
+	/**
+	 *	Receives errors encountered while encoding or
+	 *	decoding, so that they need not be thrown.
+	 */
+	class EncodingErrorSink {
+	
+	
+		public:
+		
+		
+			EncodingErrorSink () = default;
+			EncodingErrorSink (const EncodingErrorSink &) = default;
+			EncodingErrorSink (EncodingErrorSink &&) = default;
+			EncodingErrorSink & operator = (const EncodingErrorSink &) = default;
+			EncodingErrorSink & operator = (EncodingErrorSink &&) = default;
+			virtual ~EncodingErrorSink () noexcept;
+			
+			
+			/**
+			 *	Invoked for each error which is not ignored.
+			 *
+			 *	\param [in] type
+			 *		The type of error.
+			 *	\param [in] where
+			 *		The location at which the error occurred.
+			 *		When decoding this points into the bytes being
+			 *		decoded, and when encoding into the code points
+			 *		being encoded.  When decoding with a
+			 *		StreamDecoder this may point into bytes carried
+			 *		from an earlier chunk, and StreamDecoder::Offset
+			 *		gives its offset in the stream.
+			 */
+			virtual void Report (EncodingErrorType type, const void * where) = 0;
+	
+	
+	};
+	
+	
+	/**
+	 *	An EncodingErrorSink which records each error along
+	 *	with its offset from the beginning of the input.
+	 */
+	class EncodingErrorLog : public EncodingErrorSink {
+	
+	
+		public:
+		
+		
+			/**
+			 *	An error which was encountered.
+			 */
+			class Entry {
+			
+			
+				public:
+				
+				
+					/**
+					 *	The type of error.
+					 */
+					EncodingErrorType Type;
+					/**
+					 *	The offset at which the error occurred, in
+					 *	bytes from the beginning of the bytes (or the
+					 *	stream) being decoded, or in code points from
+					 *	the beginning of the code points being encoded.
+					 */
+					std::size_t Offset;
+			
+			
+			};
+		
+		
+		private:
+		
+		
+			const unsigned char * base;
+			std::size_t size;
+			const StreamDecoder * stream;
+		
+		
+		public:
+		
+		
+			/**
+			 *	The errors encountered, in the order in which they
+			 *	were encountered.
+			 */
+			std::vector<Entry> Entries;
+			
+			
+			/**
+			 *	Creates an EncodingErrorLog for decoding.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the bytes which
+			 *		will be decoded.
+			 */
+			explicit EncodingErrorLog (const void * begin) noexcept;
+			/**
+			 *	Creates an EncodingErrorLog for encoding.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the code points
+			 *		which will be encoded.
+			 */
+			explicit EncodingErrorLog (const CodePoint * begin) noexcept;
+			/**
+			 *	Creates an EncodingErrorLog for decoding a stream
+			 *	in chunks.
+			 *
+			 *	\param [in] decoder
+			 *		The StreamDecoder which will decode the stream.
+			 *		Must remain valid for the lifetime of the log.
+			 */
+			explicit EncodingErrorLog (const StreamDecoder & decoder) noexcept;
+			
+			
+			virtual void Report (EncodingErrorType type, const void * where) override;
+	
+	
+	};
+	
+	
+	/**
+	 *	The result of measuring a range of bytes without
+	 *	decoding it.
+	 */
+	class EncodingMeasurement {
+	
+	
+		public:
+		
+		
+			/**
+			 *	The number of code points which decoding the
+			 *	bytes would produce, up to the first error if
+			 *	there is one.
+			 */
+			std::size_t CodePoints;
+			/**
+			 *	The number of line terminators among those
+			 *	code points, if they were counted.  A CR
+			 *	immediately followed by a LF is a single line
+			 *	terminator, unless bytes skipped due to an
+			 *	ignored error separate them.
+			 */
+			std::size_t Lines;
+			/**
+			 *	The first error which is not ignored, and its
+			 *	offset in bytes from the beginning of the bytes.
+			 *	Disengaged if there is no such error.
+			 */
+			std::optional<EncodingErrorLog::Entry> Error;
 	
 	
 	};
@@ -362,9 +543,20 @@ namespace Unicode {
 		private:
 		
 		
+			friend class StreamDecoder;
+			
+			
 			const EncodingAction & get (EncodingErrorType) const noexcept;
 			std::optional<CodePoint> check (const CodePoint &) const;
+			std::optional<CodePoint> execute (const EncodingAction &, EncodingErrorType, const void *, CodePoint) const;
 			std::optional<CodePoint> handle (EncodingErrorType, const void *) const;
+			std::size_t encode (const CodePoint *, const CodePoint *, bool, unsigned char * (*) (void *, std::size_t), void *) const;
+			std::optional<CodePoint> next (const unsigned char * &, const unsigned char *, const unsigned char *, std::optional<Unicode::Endianness>) const;
+			void stream (CodePoint * &, CodePoint *, const unsigned char * &, const unsigned char *, const unsigned char *, std::optional<Unicode::Endianness>) const;
+			std::size_t decode (CodePoint *, std::size_t, const unsigned char *, const unsigned char *, const unsigned char *, std::optional<Unicode::Endianness>) const;
+			const unsigned char * detect (const void *, const void *, std::optional<Unicode::Endianness> &) const;
+			void transcode (const void *, const void *, const Encoding &, unsigned char * (*) (void *, std::size_t), void *) const;
+			bool terminates (CodePoint, const unsigned char *, const unsigned char *, std::optional<Unicode::Endianness>) const;
 	
 	
 		protected:
@@ -382,6 +574,175 @@ namespace Unicode {
 				std::optional<Unicode::Endianness> order
 			) const = 0;
 			
+			/**
+			 *	Determines how many code points at the beginning
+			 *	of a range of code points may be encoded by
+			 *	BulkEncoder, and how many bytes they require.
+			 *
+			 *	Implementations must stop at the first code point
+			 *	which is not valid Unicode, or which cannot be
+			 *	represented, so that errors are always handled
+			 *	the same way as they are when encoding one code
+			 *	point at a time.  The default implementation
+			 *	accepts nothing.
+			 *
+			 *	\param [out] bytes
+			 *		The number of bytes the accepted code points
+			 *		require.
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the code points.
+			 *	\param [in] end
+			 *		An iterator to the end of the code points.
+			 *
+			 *	\return
+			 *		An iterator to one past the last code point
+			 *		which was accepted.
+			 */
+			virtual const CodePoint * BulkCounter (
+				std::size_t & bytes,
+				const CodePoint * begin,
+				const CodePoint * end
+			) const;
+			
+			/**
+			 *	Encodes a range of code points without invoking
+			 *	the per code point encoder.
+			 *
+			 *	Only ever invoked on a range which BulkCounter
+			 *	accepted, with room for exactly as many bytes
+			 *	as BulkCounter reported.
+			 *
+			 *	\param [in] out
+			 *		A pointer to the memory to which the encoded
+			 *		code points shall be written.
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the code points.
+			 *	\param [in] end
+			 *		An iterator to the end of the code points.
+			 */
+			virtual void BulkEncoder (
+				unsigned char * out,
+				const CodePoint * begin,
+				const CodePoint * end
+			) const;
+			
+			/**
+			 *	Decodes as many code points as possible from a
+			 *	range of bytes without invoking the per code point
+			 *	decoder.
+			 *
+			 *	Implementations must stop at the beginning of
+			 *	the first sequence which is not both well formed
+			 *	and valid Unicode, so that errors are always
+			 *	handled by Decoder.  The default implementation
+			 *	decodes nothing.
+			 *
+			 *	There is room in the output for one code point
+			 *	per code unit before \em limit.
+			 *
+			 *	\param [in,out] out
+			 *		A pointer to the memory to which decoded code
+			 *		points shall be written.  Will be advanced past
+			 *		each code point written.
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the bytes.
+			 *	\param [in] limit
+			 *		An iterator within the bytes.  Only sequences
+			 *		which begin before this point shall be decoded,
+			 *		though they may end anywhere before \em end.
+			 *	\param [in] end
+			 *		An iterator to the end of the bytes.
+			 *	\param [in] order
+			 *		The byte order of the bytes, if known.
+			 *
+			 *	\return
+			 *		An iterator to one past the last byte which
+			 *		was consumed.
+			 */
+			virtual const unsigned char * BulkDecoder (
+				CodePoint * & out,
+				const unsigned char * begin,
+				const unsigned char * limit,
+				const unsigned char * end,
+				std::optional<Unicode::Endianness> order
+			) const;
+			
+			/**
+			 *	Counts as many code points as possible in a range
+			 *	of bytes without invoking the per code point
+			 *	decoder or writing them anywhere.
+			 *
+			 *	Implementations must stop at the beginning of
+			 *	the first sequence which is not both well formed
+			 *	and valid Unicode, exactly as BulkDecoder does.
+			 *	The default implementation decodes into a buffer
+			 *	on the stack using BulkDecoder.
+			 *
+			 *	\param [in,out] cps
+			 *		Incremented by the number of code points
+			 *		counted.
+			 *	\param [in,out] lines
+			 *		If not null, incremented by the number of line
+			 *		terminators (U+000A through U+000D, U+0085,
+			 *		U+2028, and U+2029) counted, a CR which is
+			 *		immediately followed by a LF not being counted.
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the bytes.
+			 *	\param [in] limit
+			 *		An iterator within the bytes.  Only sequences
+			 *		which begin before this point shall be counted,
+			 *		though they may end anywhere before \em end.
+			 *	\param [in] end
+			 *		An iterator to the end of the bytes.
+			 *	\param [in] order
+			 *		The byte order of the bytes, if known.
+			 *
+			 *	\return
+			 *		An iterator to one past the last byte which
+			 *		was counted.
+			 */
+			virtual const unsigned char * BulkMeasurer (
+				std::size_t & cps,
+				std::size_t * lines,
+				const unsigned char * begin,
+				const unsigned char * limit,
+				const unsigned char * end,
+				std::optional<Unicode::Endianness> order
+			) const;
+			
+			/**
+			 *	Finds the first location at or after a certain
+			 *	point at which a sequence begins no matter what
+			 *	precedes it, so that the bytes before and after
+			 *	that location may be decoded separately.
+			 *
+			 *	Decoding a sequence which begins before the
+			 *	location returned must never consume bytes at
+			 *	or after it, whether or not the sequence is
+			 *	well formed.  The default implementation assumes
+			 *	that every code unit begins a sequence.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the bytes.
+			 *		Code units are counted from here.
+			 *	\param [in] where
+			 *		An iterator within the bytes.
+			 *	\param [in] end
+			 *		An iterator to the end of the bytes.
+			 *	\param [in] order
+			 *		The byte order of the bytes, if known.
+			 *
+			 *	\return
+			 *		An iterator to the location, or \em end if
+			 *		there is no such location.
+			 */
+			virtual const unsigned char * Boundary (
+				const unsigned char * begin,
+				const unsigned char * where,
+				const unsigned char * end,
+				std::optional<Unicode::Endianness> order
+			) const;
+			
 			virtual void GetBOM (std::vector<unsigned char> & buffer) const;
 			
 			virtual std::optional<Unicode::Endianness> GetBOM (
@@ -431,6 +792,19 @@ namespace Unicode {
 			 *	\em false otherwise.
 			 */
 			bool DetectBOM;
+			/**
+			 *	If not null, errors which are not ignored are
+			 *	reported here, and are never thrown.  Instead
+			 *	replacements are made, or not, as the action for
+			 *	each error dictates, except that errors whose
+			 *	action is to throw are replaced with U+FFFD (or
+			 *	with '?' if U+FFFD cannot be represented when
+			 *	encoding).  Endianness errors are irrecoverable,
+			 *	and are reported and then thrown.
+			 *
+			 *	Defaults to null.
+			 */
+			EncodingErrorSink * Sink;
 			
 			
 			/**
@@ -488,6 +862,117 @@ namespace Unicode {
 			 *		as encoded by the underlying encoding.
 			 */
 			std::vector<unsigned char> Encode (const String & str) const;
+			/**
+			 *	Encodes a range of code points, appending the
+			 *	result to a buffer.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the range
+			 *		of code points.
+			 *	\param [in] end
+			 *		An iterator to the end of the range of
+			 *		code points.
+			 *	\param [in,out] buffer
+			 *		A buffer of bytes to which the range as
+			 *		encoded by the underlying encoding will be
+			 *		appended.
+			 */
+			void Encode (const CodePoint * begin, const CodePoint * end, std::vector<unsigned char> & buffer) const;
+			/**
+			 *	Encodes a range of code points, appending the
+			 *	result to a string.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the range
+			 *		of code points.
+			 *	\param [in] end
+			 *		An iterator to the end of the range of
+			 *		code points.
+			 *	\param [in,out] str
+			 *		A string to which the bytes of the range as
+			 *		encoded by the underlying encoding will be
+			 *		appended.
+			 */
+			void Encode (const CodePoint * begin, const CodePoint * end, std::string & str) const;
+			/**
+			 *	Encodes a range of code points into a buffer
+			 *	owned by the caller.
+			 *
+			 *	If the buffer is too small the encoding is
+			 *	still carried out in full, so that the required
+			 *	size is known, but the contents of the buffer
+			 *	are unspecified.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the range
+			 *		of code points.
+			 *	\param [in] end
+			 *		An iterator to the end of the range of
+			 *		code points.
+			 *	\param [in] out
+			 *		A pointer to the buffer.  May be null if
+			 *		\em size is zero.
+			 *	\param [in] size
+			 *		The size of the buffer in bytes.
+			 *
+			 *	\return
+			 *		The number of bytes the range requires when
+			 *		encoded by the underlying encoding.  If this
+			 *		is greater than \em size nothing useful was
+			 *		written.
+			 */
+			std::size_t Encode (const CodePoint * begin, const CodePoint * end, void * out, std::size_t size) const;
+			/**
+			 *	Determines exactly how many bytes encoding a
+			 *	range of code points would produce, including
+			 *	the BOM (if any) and the effects of the actions
+			 *	taken on errors.
+			 *
+			 *	Errors are handled exactly as they would be
+			 *	when encoding, so if encoding would throw, so
+			 *	does this.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the range
+			 *		of code points.
+			 *	\param [in] end
+			 *		An iterator to the end of the range of
+			 *		code points.
+			 *
+			 *	\return
+			 *		The number of bytes.
+			 */
+			std::size_t EncodedSize (const CodePoint * begin, const CodePoint * end) const;
+			/**
+			 *	Encodes a range of code points using several
+			 *	threads.
+			 *
+			 *	The code points are divided into chunks, the
+			 *	size of each chunk encoded is determined at the
+			 *	same time, and then each chunk is encoded at
+			 *	the same time directly into its place in the
+			 *	result.  The result, and the error raised if any,
+			 *	are exactly those of Encode.  Ranges too small to
+			 *	be worth dividing, and all ranges if errors are
+			 *	being reported to Sink, are encoded on the
+			 *	calling thread.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the range
+			 *		of code points.
+			 *	\param [in] end
+			 *		An iterator to the end of the range of
+			 *		code points.
+			 *	\param [in] threads
+			 *		The greatest number of threads to use.  Zero
+			 *		to use one per hardware thread.  Defaults to
+			 *		zero.
+			 *
+			 *	\return
+			 *		A buffer of bytes containing the encoded
+			 *		code points.
+			 */
+			std::vector<unsigned char> ParallelEncode (const CodePoint * begin, const CodePoint * end, std::size_t threads=0) const;
 			
 			
 			/**
@@ -504,6 +989,180 @@ namespace Unicode {
 			 *		the range of bytes.
 			 */
 			std::vector<CodePoint> Decode (const void * begin, const void * end) const;
+			/**
+			 *	Decodes a range of bytes, appending the result
+			 *	to a vector.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the range
+			 *		of bytes.
+			 *	\param [in] end
+			 *		An iterator to the end of the range of bytes.
+			 *	\param [in,out] cps
+			 *		A vector to which the code points represented
+			 *		by the range of bytes will be appended.
+			 */
+			void Decode (const void * begin, const void * end, std::vector<CodePoint> & cps) const;
+			/**
+			 *	Decodes a range of bytes into a buffer owned by
+			 *	the caller.
+			 *
+			 *	If the buffer is too small the decoding is
+			 *	still carried out in full, so that the required
+			 *	size is known, but the contents of the buffer
+			 *	are unspecified.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the range
+			 *		of bytes.
+			 *	\param [in] end
+			 *		An iterator to the end of the range of bytes.
+			 *	\param [in] out
+			 *		A pointer to the buffer.  May be null if
+			 *		\em size is zero.
+			 *	\param [in] size
+			 *		The size of the buffer in code points.
+			 *
+			 *	\return
+			 *		The number of code points represented by the
+			 *		range of bytes.  If this is greater than
+			 *		\em size nothing useful was written.
+			 */
+			std::size_t Decode (const void * begin, const void * end, CodePoint * out, std::size_t size) const;
+			/**
+			 *	Determines exactly how many code points decoding
+			 *	a range of bytes would produce, including the
+			 *	effects of the actions taken on errors.
+			 *
+			 *	Errors are handled exactly as they would be
+			 *	when decoding, so if decoding would throw, so
+			 *	does this.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the range
+			 *		of bytes.
+			 *	\param [in] end
+			 *		An iterator to the end of the range of bytes.
+			 *
+			 *	\return
+			 *		The number of code points.
+			 */
+			std::size_t DecodedSize (const void * begin, const void * end) const;
+			/**
+			 *	Validates and measures a range of bytes without
+			 *	decoding it and without allocating.
+			 *
+			 *	Errors are never handled, measuring stops at
+			 *	the first error whose action is not to ignore it,
+			 *	and errors which are ignored are skipped exactly
+			 *	as they would be when decoding.  Never throws
+			 *	EncodingError.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the range
+			 *		of bytes.
+			 *	\param [in] end
+			 *		An iterator to the end of the range of bytes.
+			 *	\param [in] lines
+			 *		\em true if line terminators should be
+			 *		counted, \em false otherwise.  Defaults to
+			 *		\em false.
+			 *
+			 *	\return
+			 *		The measurement.
+			 */
+			EncodingMeasurement Measure (const void * begin, const void * end, bool lines=false) const;
+			/**
+			 *	Decodes a range of bytes using several threads.
+			 *
+			 *	The bytes are divided into chunks at locations
+			 *	where sequences begin, the number of code points
+			 *	in each chunk is determined at the same time, and
+			 *	then each chunk is decoded at the same time
+			 *	directly into its place in the result.  The
+			 *	result, and the error raised if any, are exactly
+			 *	those of Decode.
+			 *	Ranges too small to be worth dividing, and all
+			 *	ranges if errors are being reported to Sink, are
+			 *	decoded on the calling thread.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the range
+			 *		of bytes.
+			 *	\param [in] end
+			 *		An iterator to the end of the range of bytes.
+			 *	\param [in] threads
+			 *		The greatest number of threads to use.  Zero
+			 *		to use one per hardware thread.  Defaults to
+			 *		zero.
+			 *
+			 *	\return
+			 *		A vector of the code points represented by
+			 *		the range of bytes.
+			 */
+			std::vector<CodePoint> ParallelDecode (const void * begin, const void * end, std::size_t threads=0) const;
+			
+			
+			/**
+			 *	Transcodes a range of bytes from this encoding
+			 *	to another without decoding the entire range to
+			 *	code points first.
+			 *
+			 *	Errors in the input are handled by the actions
+			 *	of this encoding, and code points which are
+			 *	invalid or cannot be represented by the output
+			 *	by the actions of the other, exactly as if the
+			 *	range were decoded by this encoding and then
+			 *	encoded by the other.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the range
+			 *		of bytes.
+			 *	\param [in] end
+			 *		An iterator to the end of the range of bytes.
+			 *	\param [in] encoding
+			 *		The encoding to which the bytes shall be
+			 *		transcoded.
+			 *
+			 *	\return
+			 *		A buffer of bytes containing the range as
+			 *		encoded by \em encoding.
+			 */
+			std::vector<unsigned char> Transcode (const void * begin, const void * end, const Encoding & encoding) const;
+			/**
+			 *	Transcodes a range of bytes from this encoding
+			 *	to another, appending the result to a buffer.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the range
+			 *		of bytes.
+			 *	\param [in] end
+			 *		An iterator to the end of the range of bytes.
+			 *	\param [in] encoding
+			 *		The encoding to which the bytes shall be
+			 *		transcoded.
+			 *	\param [in,out] buffer
+			 *		A buffer of bytes to which the range as
+			 *		encoded by \em encoding will be appended.
+			 */
+			void Transcode (const void * begin, const void * end, const Encoding & encoding, std::vector<unsigned char> & buffer) const;
+			/**
+			 *	Transcodes a range of bytes from this encoding
+			 *	to another, appending the result to a string.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the range
+			 *		of bytes.
+			 *	\param [in] end
+			 *		An iterator to the end of the range of bytes.
+			 *	\param [in] encoding
+			 *		The encoding to which the bytes shall be
+			 *		transcoded.
+			 *	\param [in,out] str
+			 *		A string to which the bytes of the range as
+			 *		encoded by \em encoding will be appended.
+			 */
+			void Transcode (const void * begin, const void * end, const Encoding & encoding, std::string & str) const;
 			
 			
 			/**
@@ -589,6 +1248,115 @@ namespace Unicode {
 	
 	
 	};
+	
+	
+	/**
+	 *	Decodes a stream of bytes which arrives in chunks
+	 *	of arbitrary size (e.g.\ from a socket).
+	 *
+	 *	Sequences split between chunks are carried from
+	 *	one chunk to the next, so each byte is decoded
+	 *	once, and the byte order detected from a BOM at
+	 *	the beginning of the stream applies to all of it.
+	 *	Decoding a stream in chunks and then finishing it
+	 *	gives the same results as decoding the whole stream
+	 *	at once.
+	 *
+	 *	Errors are handled by the actions of the underlying
+	 *	encoding.  If an exception is thrown, code points
+	 *	decoded before the error are kept, and the decoder
+	 *	must be reset before it is used again.  Errors
+	 *	reported to the encoding's Sink may be located in
+	 *	the stream with Offset.
+	 */
+	class StreamDecoder {
+	
+	
+		private:
+		
+		
+			const Encoding & encoding;
+			std::vector<unsigned char> carry;
+			std::optional<Unicode::Endianness> order;
+			bool detected;
+			//	The offset in the stream of the first byte
+			//	carried (or of the next chunk if nothing is)
+			std::size_t position;
+			//	The bytes being decoded and the offset in the
+			//	stream at which they begin
+			const unsigned char * base;
+			std::size_t base_position;
+		
+		
+		public:
+		
+		
+			/**
+			 *	Creates a new StreamDecoder.
+			 *
+			 *	\param [in] encoding
+			 *		The encoding of the stream.  Must remain
+			 *		valid for the lifetime of the decoder.
+			 */
+			explicit StreamDecoder (const Encoding & encoding) noexcept;
+			
+			
+			/**
+			 *	Decodes the next chunk of the stream.
+			 *
+			 *	\param [in] begin
+			 *		An iterator to the beginning of the chunk.
+			 *	\param [in] end
+			 *		An iterator to the end of the chunk.
+			 *	\param [in,out] cps
+			 *		A vector to which all code points which
+			 *		are complete will be appended.
+			 */
+			void Decode (const void * begin, const void * end, std::vector<CodePoint> & cps);
+			/**
+			 *	Ends the stream, handling whatever is left
+			 *	of it as an unexpected end, and resets the
+			 *	decoder so that it may decode another stream.
+			 *
+			 *	\param [in,out] cps
+			 *		A vector to which code points will be
+			 *		appended.
+			 */
+			void Finish (std::vector<CodePoint> & cps);
+			/**
+			 *	Discards whatever is left of the current
+			 *	stream, so that the decoder may decode another
+			 *	stream.
+			 */
+			void Reset () noexcept;
+			/**
+			 *	Determines how many bytes of an incomplete
+			 *	sequence (or of a possible BOM) are being
+			 *	carried until the next chunk.
+			 *
+			 *	\return
+			 *		The number of bytes.
+			 */
+			std::size_t Pending () const noexcept;
+			/**
+			 *	Determines the offset in the stream of a
+			 *	location reported to an EncodingErrorSink while
+			 *	decoding it.
+			 *
+			 *	Only meaningful during the call to Decode or
+			 *	Finish in which the location was reported.
+			 *
+			 *	\param [in] where
+			 *		The location.
+			 *
+			 *	\return
+			 *		The offset in bytes from the beginning of the
+			 *		stream.
+			 */
+			std::size_t Offset (const void * where) const noexcept;
+	
+	
+	};
 
 
 }
@@ -9,6 +9,7 @@
 #include <unicode/encoding.hpp>
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <iterator>
 #include <optional>
 
@@ -156,6 +157,47 @@ namespace Unicode {
 			}
 			
 			
+			//	Reads a code unit, reversing its bytes if
+			//	necessary
+			template <typename T>
+			static T Read (const unsigned char * ptr, bool reverse) noexcept {
+			
+				T retr;
+				std::memcpy(&retr,ptr,sizeof(T));
+				
+				return reverse ? Correct(retr) : retr;
+			
+			}
+			
+			
+			//	Writes a code unit, reversing its bytes if
+			//	necessary
+			template <typename T>
+			static void Write (unsigned char * ptr, T cu, bool reverse) noexcept {
+			
+				if (reverse) cu=Correct(cu);
+				
+				std::memcpy(ptr,&cu,sizeof(T));
+			
+			}
+			
+			
+			//	Determines whether code units in a certain
+			//	byte order must be reversed
+			static constexpr bool Reverse (Unicode::Endianness order) noexcept {
+			
+				return order!=Detect();
+			
+			}
+			
+			
+			//	Decodes 16 bit code units, each of which must be
+			//	a valid code point by itself, until limit or the
+			//	first code unit which is not (i.e. a surrogate or
+			//	a noncharacter)
+			static const unsigned char * DecodeSingle (CodePoint * & out, const unsigned char * begin, const unsigned char * limit, bool reverse) noexcept;
+			
+			
 			virtual void GetBOM (std::vector<unsigned char> & buffer) const override;
 			
 			
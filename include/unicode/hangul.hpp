@@ -0,0 +1,149 @@
+/**
+ *	\file
+ */
+
+
+#pragma once
+
+
+#include <unicode/codepoint.hpp>
+#include <optional>
+
+
+namespace Unicode {
+
+
+	/**
+	 *	Contains constants and functions which allow
+	 *	Hangul syllables to be decomposed, composed, and
+	 *	named algorithmically, as described in section 3.12
+	 *	of The Unicode Standard.
+	 */
+	namespace Hangul {
+
+
+		/**
+		 *	The first precomposed Hangul syllable.
+		 */
+		constexpr CodePoint::Type SBase=0xAC00U;
+		/**
+		 *	The first leading consonant jamo.
+		 */
+		constexpr CodePoint::Type LBase=0x1100U;
+		/**
+		 *	The first vowel jamo.
+		 */
+		constexpr CodePoint::Type VBase=0x1161U;
+		/**
+		 *	One less than the first trailing consonant
+		 *	jamo.
+		 */
+		constexpr CodePoint::Type TBase=0x11A7U;
+		/**
+		 *	The number of leading consonant jamo.
+		 */
+		constexpr CodePoint::Type LCount=19;
+		/**
+		 *	The number of vowel jamo.
+		 */
+		constexpr CodePoint::Type VCount=21;
+		/**
+		 *	One more than the number of trailing consonant
+		 *	jamo.
+		 */
+		constexpr CodePoint::Type TCount=28;
+		/**
+		 *	The number of precomposed Hangul syllables
+		 *	which begin with each leading consonant.
+		 */
+		constexpr CodePoint::Type NCount=VCount*TCount;
+		/**
+		 *	The number of precomposed Hangul syllables.
+		 */
+		constexpr CodePoint::Type SCount=LCount*NCount;
+
+
+		/**
+		 *	Determines whether a code point is a precomposed
+		 *	Hangul syllable.
+		 *
+		 *	\param [in] cp
+		 *		The code point.
+		 *
+		 *	\return
+		 *		\em true if \em cp is a precomposed Hangul
+		 *		syllable, \em false otherwise.
+		 */
+		constexpr bool IsSyllable (CodePoint::Type cp) noexcept {
+
+			return (cp-SBase)<SCount;
+
+		}
+
+
+		/**
+		 *	Decomposes a precomposed Hangul syllable into
+		 *	its jamo.
+		 *
+		 *	\tparam T
+		 *		A type which may be called with a code point.
+		 *
+		 *	\param [in] cp
+		 *		A precomposed Hangul syllable.
+		 *	\param [in] callback
+		 *		A callable which shall be invoked once for
+		 *		each jamo, in order.
+		 */
+		template <typename T>
+		void Decompose (CodePoint::Type cp, T && callback) {
+
+			auto s_index=cp-SBase;
+			callback(LBase+(s_index/NCount));
+			callback(VBase+((s_index%NCount)/TCount));
+			auto t_index=s_index%TCount;
+			if (t_index!=0) callback(TBase+t_index);
+
+		}
+
+
+		/**
+		 *	Attempts to compose two code points which are
+		 *	Hangul jamo or precomposed Hangul syllables.
+		 *
+		 *	\param [in] a
+		 *		The first code point.
+		 *	\param [in] b
+		 *		The code point which immediately follows
+		 *		\em a.
+		 *
+		 *	\return
+		 *		The code point to which \em a and \em b
+		 *		compose, if any.
+		 */
+		inline std::optional<CodePoint> Compose (CodePoint::Type a, CodePoint::Type b) noexcept {
+
+			//	Leading consonant followed by vowel
+			auto l_index=a-LBase;
+			auto v_index=b-VBase;
+			if ((l_index<LCount) && (v_index<VCount)) return CodePoint(SBase+(((l_index*VCount)+v_index)*TCount));
+
+			//	Syllable without trailing consonant followed
+			//	by trailing consonant
+			auto s_index=a-SBase;
+			auto t_index=b-TBase;
+			if (
+				(s_index<SCount) &&
+				((s_index%TCount)==0) &&
+				(t_index!=0) &&
+				(t_index<TCount)
+			) return CodePoint(a+t_index);
+
+			return std::optional<CodePoint>{};
+
+		}
+
+
+	}
+
+
+}
@@ -13,10 +13,13 @@
 #include <unicode/utf16.hpp>
 #include <unicode/utf32.hpp>
 #include <unicode/vector.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <memory>
 #include <optional>
 #include <stdexcept>
+#include <vector>
 
 
 namespace Unicode {
@@ -70,7 +73,9 @@ namespace Unicode {
 	 
 	 
 	//	Wraps an input stream and extracts strings
-	//	line-by-line, or single code points
+	//	line-by-line, or single code points.  One wrapper
+	//	is kept with each stream, so that code units read
+	//	from the stream but not yet extracted aren't lost
 	template <typename CharT, typename Traits>
 	class InputStreamWrapper {
 	
@@ -78,10 +83,20 @@ namespace Unicode {
 		private:
 		
 		
-			//	Unparsed/-decoded characters
-			std::vector<CharT> buffer;
+			//	The number of code units read from the
+			//	stream at once
+			static constexpr std::size_t block_size=4096;
+			
+			
 			//	Encoder/decoder
 			std::unique_ptr<Encoding> encoder;
+			StreamDecoder decoder;
+			//	Decoded code points, those before pos have
+			//	been extracted
+			std::vector<CodePoint> cps;
+			std::size_t pos;
+			//	Code units read from the stream
+			std::vector<CharT> block;
 			
 			
 			[[noreturn]]
@@ -92,151 +107,165 @@ namespace Unicode {
 			}
 			
 			
-			bool fetch (std::basic_istream<CharT,Traits> & is) {
+			static std::unique_ptr<Encoding> get_encoder () {
 			
-				CharT c;
-				is.get(c);
-				
-				if (!is) {
-				
-					if (is.bad()) raise(is);
-					
-					is.clear();
-					is.setstate(std::ios_base::eofbit);
+				//	Select an appropriate encoding, code units
+				//	are in the byte order of this machine
+				std::unique_ptr<Encoding> retr;
+				auto order=EndianEncoding::Detect();
+				switch (sizeof(CharT)) {
 				
-					return false;
+					case sizeof(UTF8::CodeUnit):
+						retr=std::unique_ptr<Encoding>(new UTF8());
+						break;
+					case sizeof(UTF16::CodeUnit):
+						retr=std::unique_ptr<Encoding>(new UTF16(order,order));
+						break;
+					case sizeof(UTF32::CodeUnit):
+						retr=std::unique_ptr<Encoding>(new UTF32(order,order));
+						break;
+					default:
+						throw std::logic_error("No encoding for code units of that size");
 				
 				}
+				retr->DetectBOM=false;
 				
-				buffer.push_back(c);
-				
-				return true;
+				return retr;
 			
 			}
 			
 			
-			static bool is_next_lf (std::basic_istream<CharT,Traits> & is) {
+			static void callback (std::ios_base::event event, std::ios_base & ios, int index) {
 			
-				auto c=is.peek();
-				
-				if (is.eof()) return false;
-				
-				if (!is) raise(is);
+				auto & ptr=ios.pword(index);
 				
-				return c=='\n';
+				//	When formatting is copied from another stream
+				//	the pointer is copied too, but the wrapper
+				//	belongs to the other stream
+				if (event==std::ios_base::erase_event) delete static_cast<InputStreamWrapper *>(ptr);
+				if (event!=std::ios_base::imbue_event) ptr=nullptr;
 			
 			}
 			
 			
-			std::optional<CodePoint> get_code_point (std::basic_istream<CharT,Traits> & is) {
+			//	Reads a block of code units from the stream and
+			//	decodes it, discarding code points which have
+			//	been extracted
+			bool fetch (std::basic_istream<CharT,Traits> & is) {
 			
-				buffer.clear();
+				cps.erase(cps.begin(),cps.begin()+pos);
+				pos=0;
+				
+				auto buf=is.rdbuf();
+				if (buf==nullptr) raise(is);
 				
-				//	Loop until end of stream or a code point
-				//	is extracted
-				while (fetch(is)) {
+				while (cps.empty()) {
 				
-					const void * begin=Begin(buffer);
-					auto cp=encoder->Stream(
-						begin,
-						End(buffer),
-						EndianEncoding::Detect()
+					//	Waits until there's something to read, but
+					//	then reads only what's available, so reading
+					//	from an interactive stream doesn't block
+					if (Traits::eq_int_type(buf->sgetc(),Traits::eof())) {
+					
+						//	If the underlying stream was well-formed
+						//	this does nothing
+						decoder.Finish(cps);
+						if (!cps.empty()) break;
+						
+						is.setstate(std::ios_base::eofbit);
+						
+						return false;
+					
+					}
+					
+					auto avail=buf->in_avail();
+					auto n=buf->sgetn(
+						block.data(),
+						(avail>1) ? std::min<std::streamsize>(avail,block.size()) : 1
 					);
+					if (n<=0) raise(is);
 					
-					if (cp) return cp;
+					decoder.Decode(block.data(),block.data()+n,cps);
 				
 				}
 				
-				//	If we get down here, end of stream was
-				//	encountered, which means if the underlying
-				//	stream was well-formed, there should be
-				//	nothing in our buffer
-				if (buffer.size()!=0) encoder->UnexpectedEnd.Throw(nullptr);
-				
-				return std::nullopt;
-				
+				return true;
+			
 			}
 			
 			
 		public:
 		
 		
-			InputStreamWrapper () {
+			InputStreamWrapper () : encoder(get_encoder()), decoder(*encoder), pos(0), block(block_size) {	}
 			
-				//	Select an appropriate encoding
-				switch (sizeof(CharT)) {
+			
+			//	Retrieves the wrapper kept with a stream,
+			//	creating it if necessary
+			static InputStreamWrapper & Get (std::basic_istream<CharT,Traits> & is) {
+			
+				static const int index=std::ios_base::xalloc();
 				
-					case sizeof(UTF8::CodeUnit):
-						encoder=std::unique_ptr<Encoding>(new UTF8());
-						break;
-					case sizeof(UTF16::CodeUnit):
-						encoder=std::unique_ptr<Encoding>(new UTF16());
-						break;
-					case sizeof(UTF32::CodeUnit):
-						encoder=std::unique_ptr<Encoding>(new UTF32());
-						break;
-					default:
-						throw std::logic_error("No encoding for code units of that size");
+				auto ptr=is.pword(index);
+				if (ptr!=nullptr) return *static_cast<InputStreamWrapper *>(ptr);
 				
-				}
+				std::unique_ptr<InputStreamWrapper> retr(new InputStreamWrapper());
+				is.register_callback(callback,index);
+				is.pword(index)=retr.get();
+				
+				return *retr.release();
 			
 			}
 			
 			
 			std::optional<CodePoint> GetCodePoint (std::basic_istream<CharT,Traits> & is) {
 			
-				if (is.eof()) {
+				typename std::basic_istream<CharT,Traits>::sentry s(is,true);
+				if (!s) return std::nullopt;
 				
-					is.setstate(std::ios_base::failbit);
-					
-					return std::nullopt;
+				if ((pos==cps.size()) && !fetch(is)) return std::nullopt;
 				
-				}
-			
-				return get_code_point(is);
+				return cps[pos++];
 			
 			}
 		
 		
 			String GetLine (std::basic_istream<CharT,Traits> & is) {
 			
-				if (is.eof()) {
-				
-					is.setstate(std::ios_base::failbit);
-					
-					return String{};
-				
-				}
+				typename std::basic_istream<CharT,Traits>::sentry s(is,true);
+				if (!s) return String{};
 				
 				//	The string that we'll be returning
-				std::vector<CodePoint> cps;
+				std::vector<CodePoint> line;
 				
 				for (;;) {
 				
-					auto cp=get_code_point(is);
+					const CodePoint * begin=Begin(cps)+pos;
+					const CodePoint * end=End(cps);
+					auto terminator=FindLineTerminator(begin,end);
+					line.insert(line.end(),begin,terminator);
+					pos=static_cast<std::size_t>(terminator-Begin(cps));
 					
 					//	If the end of stream is reached, that's
 					//	the end of this line
-					if (!cp) return cps;
-					
-					//	Special handling for CR
-					if (*cp=='\r') {
+					if (terminator==end) {
 					
-						if (is_next_lf(is)) continue;
+						if (!fetch(is)) return line;
 						
-						return cps;
+						continue;
 					
 					}
 					
-					cps.push_back(*cp);
+					++pos;
 					
-					if (IsLineBreak(End(cps),Begin(cps),End(cps))) {
-					
-						cps.erase(cps.end()-1);
-						
-						return cps;
+					//	Special handling for CR, which is followed
+					//	by LF to make a single line terminator
+					if (
+						(*terminator=='\r') &&
+						((pos!=cps.size()) || fetch(is)) &&
+						(cps[pos]=='\n')
+					) ++pos;
 					
-					}
+					return line;
 				
 				}
 			
@@ -257,6 +286,12 @@ namespace Unicode {
 	 *	If the end of the stream has been reached, the
 	 *	empty string will be returned.
 	 *
+	 *	Code units are read from the stream a block at
+	 *	a time.  Those which have been read but not yet
+	 *	extracted are kept with the stream for subsequent
+	 *	extractions of strings and code points, but other
+	 *	input operations on the stream will not see them.
+	 *
 	 *	\param [in] is
 	 *		The input stream.
 	 *	\param [out] str
@@ -268,7 +303,7 @@ namespace Unicode {
 	template <typename CharT, typename Traits>
 	std::basic_istream<CharT,Traits> & operator >> (std::basic_istream<CharT,Traits> & is, String & str) {
 	
-		str=InputStreamWrapper<CharT,Traits>{}.GetLine(is);
+		str=InputStreamWrapper<CharT,Traits>::Get(is).GetLine(is);
 		
 		return is;
 	
@@ -278,6 +313,9 @@ namespace Unicode {
 	/**
 	 *	Extracts a code point from an input stream.
 	 *
+	 *	Code units are buffered as they are when
+	 *	extracting a line.
+	 *
 	 *	\param [in] is
 	 *		The input stream.
 	 *	\param [out] cp
@@ -291,7 +329,7 @@ namespace Unicode {
 	template <typename CharT, typename Traits>
 	std::basic_istream<CharT,Traits> & operator >> (std::basic_istream<CharT,Traits> & is, CodePoint & cp) {
 	
-		auto c=InputStreamWrapper<CharT,Traits>{}.GetCodePoint(is);
+		auto c=InputStreamWrapper<CharT,Traits>::Get(is).GetCodePoint(is);
 		
 		if (c) cp=*c;
 		
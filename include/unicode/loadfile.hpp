@@ -0,0 +1,57 @@
+/**
+ *	\file
+ */
+
+
+#pragma once
+
+
+#include <unicode/encoding.hpp>
+#include <unicode/string.hpp>
+
+
+namespace Unicode {
+
+
+	/**
+	 *	Loads the contents of a text file into a string.
+	 *
+	 *	The encoding of the file is determined by its byte
+	 *	order mark, which may be that of UTF-8, UTF-16, or
+	 *	UTF-32.  Files without a byte order mark are
+	 *	decoded as UTF-8.  Errors are handled by the default
+	 *	actions of that encoding.
+	 *
+	 *	The file is mapped into memory rather than read
+	 *	if it can be (pipes and devices are read until they
+	 *	end), and large files are decoded using several
+	 *	threads.
+	 *
+	 *	\param [in] filename
+	 *		The name of the file.
+	 *
+	 *	\return
+	 *		The contents of the file.
+	 */
+	String LoadFile (const char * filename);
+	/**
+	 *	Loads the contents of a text file in a certain
+	 *	encoding into a string.
+	 *
+	 *	The file is mapped into memory rather than read
+	 *	if it can be (pipes and devices are read until they
+	 *	end), and large files are decoded using several
+	 *	threads.
+	 *
+	 *	\param [in] filename
+	 *		The name of the file.
+	 *	\param [in] encoding
+	 *		The encoding of the file.
+	 *
+	 *	\return
+	 *		The contents of the file.
+	 */
+	String LoadFile (const char * filename, const Encoding & encoding);
+
+
+}
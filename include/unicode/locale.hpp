@@ -8,6 +8,8 @@
 
 #include <unicode/codepoint.hpp>
 #include <cstddef>
+#include <cstdint>
+#include <string>
 #include <utility>
 
 
@@ -52,13 +54,77 @@ namespace Unicode {
 			const char * Language;
 			/**
 			 *	An array of CodePointInfo structures that
-			 *	given information about code points for
+			 *	give information about code points for
 			 *	this locale.
 			 *
-			 *	This array must be in ascending sorted order
-			 *	on code point numeric value.
+			 *	Each element may be shared by any number of
+			 *	code points, and the elements may be in any
+			 *	order.
 			 */
 			Array<CodePointInfo> Info;
+			/**
+			 *	An array of CodePointRecord structures that
+			 *	associate code points with their names and
+			 *	their entries in Info.
+			 *
+			 *	This array must be in ascending sorted order
+			 *	on code point numeric value, and the ranges
+			 *	described by its elements must not overlap.
+			 */
+			Array<CodePointRecord> Records;
+			/**
+			 *	The null terminated names of code points, into
+			 *	which the elements of Records give offsets.
+			 */
+			Array<char> Names;
+			/**
+			 *	The names of blocks, indexed by the Block
+			 *	member of CodePointInfo structures.
+			 *
+			 *	The first element is \em nullptr, and is the
+			 *	name of the block of code points which are
+			 *	not in any block.
+			 */
+			Array<const char *> BlockNames;
+			/**
+			 *	The names of scripts, indexed by the Script
+			 *	member of CodePointInfo structures.
+			 *
+			 *	The first element is \em nullptr, and is the
+			 *	name of the script of code points which have
+			 *	no script.
+			 */
+			Array<const char *> ScriptNames;
+			/**
+			 *	An index which maps code points to their
+			 *	entries in Info.
+			 *
+			 *	If this index is empty Records is searched
+			 *	instead.
+			 */
+			CodePointIndex InfoIndex;
+			/**
+			 *	Pointers into Info for each code point in the
+			 *	Latin-1 range (i.e. U+0000 through U+00FF),
+			 *	indexed by code point, so that the most common
+			 *	code points may be looked up directly.
+			 *
+			 *	A pointer is \em nullptr if there is no
+			 *	information about the corresponding code
+			 *	point.  If this array is empty InfoIndex is
+			 *	used instead.
+			 */
+			Array<const CodePointInfo *> Latin1Info;
+			/**
+			 *	Packed tables of frequently accessed properties,
+			 *	which are parallel to the second stage of
+			 *	InfoIndex.
+			 *
+			 *	Any table which is empty is ignored, and the
+			 *	corresponding property is read from Info
+			 *	instead.
+			 */
+			PropertyTables Properties;
 			/**
 			 *	An array of Composition structures that
 			 *	give information about how code points
@@ -119,6 +185,308 @@ namespace Unicode {
 			 *		exists, \em nullptr otherwise.
 			 */
 			const CodePointInfo * GetInfo (CodePoint cp) const noexcept;
+			/**
+			 *	Retrieves information about each code point in
+			 *	a range.
+			 *
+			 *	Code points which are adjacent both in the range
+			 *	and in value share lookups, so this is faster
+			 *	than invoking GetInfo for each of them.  The
+			 *	range overloads which follow do likewise.
+			 *
+			 *	\param [in] begin
+			 *		A pointer to the first code point.
+			 *	\param [in] end
+			 *		A pointer to one past the last code point.
+			 *	\param [out] out
+			 *		A pointer to \em end-\em begin pointers, each
+			 *		of which is set as GetInfo would return it
+			 *		for the corresponding code point.
+			 */
+			void GetInfo (const CodePoint * begin, const CodePoint * end, const CodePointInfo ** out) const noexcept;
+			/**
+			 *	Retrieves the record which describes a certain
+			 *	code point.
+			 *
+			 *	\param [in] cp
+			 *		The code point whose record shall be
+			 *		retrieved.
+			 *
+			 *	\return
+			 *		A pointer to the CodePointRecord structure
+			 *		which describes \em cp if one exists,
+			 *		\em nullptr otherwise.
+			 */
+			const CodePointRecord * GetRecord (CodePoint cp) const noexcept;
+			/**
+			 *	Retrieves the name of a certain code point.
+			 *
+			 *	Names which are derived algorithmically (i.e.
+			 *	the names of Hangul syllables, and of code
+			 *	points described by structures whose names
+			 *	are prefixes) are generated.
+			 *
+			 *	\param [in] cp
+			 *		The code point whose name shall be retrieved.
+			 *
+			 *	\return
+			 *		The name of \em cp, or the empty string if
+			 *		\em cp has no name.
+			 */
+			std::string GetName (CodePoint cp) const;
+			/**
+			 *	Finds the block with a certain name.
+			 *
+			 *	\param [in] name
+			 *		A C string containing the name of the
+			 *		block.
+			 *
+			 *	\return
+			 *		The index of the block named \em name within
+			 *		BlockNames, or zero if there is no such
+			 *		block.
+			 */
+			std::uint16_t FindBlock (const char * name) const noexcept;
+			/**
+			 *	Finds the script with a certain name.
+			 *
+			 *	\param [in] name
+			 *		A C string containing the name of the
+			 *		script.
+			 *
+			 *	\return
+			 *		The index of the script named \em name
+			 *		within ScriptNames, or zero if there is no
+			 *		such script.
+			 */
+			std::uint16_t FindScript (const char * name) const noexcept;
+			
+			
+			/**
+			 *	Retrieves the canonical combining class of a
+			 *	certain code point.
+			 *
+			 *	\param [in] cp
+			 *		The code point.
+			 *
+			 *	\return
+			 *		The canonical combining class of \em cp,
+			 *		or zero if there is no information about
+			 *		\em cp.
+			 */
+			std::size_t GetCanonicalCombiningClass (CodePoint cp) const noexcept;
+			/**
+			 *	Retrieves the canonical combining class of each
+			 *	code point in a range.
+			 *
+			 *	\param [in] begin
+			 *		A pointer to the first code point.
+			 *	\param [in] end
+			 *		A pointer to one past the last code point.
+			 *	\param [out] out
+			 *		A pointer to \em end-\em begin canonical
+			 *		combining classes, each of which is set as
+			 *		GetCanonicalCombiningClass would return it for
+			 *		the corresponding code point.
+			 */
+			void GetCanonicalCombiningClass (const CodePoint * begin, const CodePoint * end, std::size_t * out) const noexcept;
+			/**
+			 *	Retrieves the general category of a certain
+			 *	code point.
+			 *
+			 *	\param [in] cp
+			 *		The code point.
+			 *
+			 *	\return
+			 *		The general category of \em cp, or
+			 *		GeneralCategory::Cn if there is no information
+			 *		about \em cp.
+			 */
+			Unicode::GeneralCategory GetGeneralCategory (CodePoint cp) const noexcept;
+			/**
+			 *	Retrieves the general category of each code point
+			 *	in a range.
+			 *
+			 *	\param [in] begin
+			 *		A pointer to the first code point.
+			 *	\param [in] end
+			 *		A pointer to one past the last code point.
+			 *	\param [out] out
+			 *		A pointer to \em end-\em begin general
+			 *		categories, each of which is set as
+			 *		GetGeneralCategory would return it for the
+			 *		corresponding code point.
+			 */
+			void GetGeneralCategory (const CodePoint * begin, const CodePoint * end, Unicode::GeneralCategory * out) const noexcept;
+			/**
+			 *	Retrieves the grapheme cluster break property
+			 *	of a certain code point.
+			 *
+			 *	\param [in] cp
+			 *		The code point.
+			 *
+			 *	\return
+			 *		The grapheme cluster break property of
+			 *		\em cp, or GraphemeClusterBreak::XX if there
+			 *		is no information about \em cp.
+			 */
+			Unicode::GraphemeClusterBreak GetGraphemeClusterBreak (CodePoint cp) const noexcept;
+			/**
+			 *	Retrieves the grapheme cluster break property of
+			 *	each code point in a range.
+			 *
+			 *	\param [in] begin
+			 *		A pointer to the first code point.
+			 *	\param [in] end
+			 *		A pointer to one past the last code point.
+			 *	\param [out] out
+			 *		A pointer to \em end-\em begin grapheme cluster
+			 *		break properties, each of which is set as
+			 *		GetGraphemeClusterBreak would return it for the
+			 *		corresponding code point.
+			 */
+			void GetGraphemeClusterBreak (const CodePoint * begin, const CodePoint * end, Unicode::GraphemeClusterBreak * out) const noexcept;
+			/**
+			 *	Retrieves the word break property of a certain
+			 *	code point.
+			 *
+			 *	\param [in] cp
+			 *		The code point.
+			 *
+			 *	\return
+			 *		The word break property of \em cp, or
+			 *		WordBreak::XX if there is no information
+			 *		about \em cp.
+			 */
+			Unicode::WordBreak GetWordBreak (CodePoint cp) const noexcept;
+			/**
+			 *	Retrieves the word break property of each code
+			 *	point in a range.
+			 *
+			 *	\param [in] begin
+			 *		A pointer to the first code point.
+			 *	\param [in] end
+			 *		A pointer to one past the last code point.
+			 *	\param [out] out
+			 *		A pointer to \em end-\em begin word break
+			 *		properties, each of which is set as GetWordBreak
+			 *		would return it for the corresponding code
+			 *		point.
+			 */
+			void GetWordBreak (const CodePoint * begin, const CodePoint * end, Unicode::WordBreak * out) const noexcept;
+			/**
+			 *	Retrieves the line break property of a certain
+			 *	code point.
+			 *
+			 *	\param [in] cp
+			 *		The code point.
+			 *
+			 *	\return
+			 *		The line break property of \em cp, or
+			 *		LineBreak::XX if there is no information
+			 *		about \em cp.
+			 */
+			Unicode::LineBreak GetLineBreak (CodePoint cp) const noexcept;
+			/**
+			 *	Retrieves the line break property of each code
+			 *	point in a range.
+			 *
+			 *	\param [in] begin
+			 *		A pointer to the first code point.
+			 *	\param [in] end
+			 *		A pointer to one past the last code point.
+			 *	\param [out] out
+			 *		A pointer to \em end-\em begin line break
+			 *		properties, each of which is set as GetLineBreak
+			 *		would return it for the corresponding code
+			 *		point.
+			 */
+			void GetLineBreak (const CodePoint * begin, const CodePoint * end, Unicode::LineBreak * out) const noexcept;
+			/**
+			 *	Retrieves the NFC_Quick_Check property of a
+			 *	certain code point.
+			 *
+			 *	\param [in] cp
+			 *		The code point.
+			 *
+			 *	\return
+			 *		The NFC_Quick_Check property of \em cp,
+			 *		or QuickCheck::Yes if there is no information
+			 *		about \em cp.
+			 */
+			QuickCheck GetNFCQuickCheck (CodePoint cp) const noexcept;
+			/**
+			 *	Retrieves the NFC_Quick_Check property of each
+			 *	code point in a range.
+			 *
+			 *	\param [in] begin
+			 *		A pointer to the first code point.
+			 *	\param [in] end
+			 *		A pointer to one past the last code point.
+			 *	\param [out] out
+			 *		A pointer to \em end-\em begin NFC_Quick_Check
+			 *		properties, each of which is set as
+			 *		GetNFCQuickCheck would return it for the
+			 *		corresponding code point.
+			 */
+			void GetNFCQuickCheck (const CodePoint * begin, const CodePoint * end, QuickCheck * out) const noexcept;
+			/**
+			 *	Retrieves the NFD_Quick_Check property of a
+			 *	certain code point.
+			 *
+			 *	\param [in] cp
+			 *		The code point.
+			 *
+			 *	\return
+			 *		The NFD_Quick_Check property of \em cp,
+			 *		or QuickCheck::Yes if there is no information
+			 *		about \em cp.
+			 */
+			QuickCheck GetNFDQuickCheck (CodePoint cp) const noexcept;
+			/**
+			 *	Retrieves the NFD_Quick_Check property of each
+			 *	code point in a range.
+			 *
+			 *	\param [in] begin
+			 *		A pointer to the first code point.
+			 *	\param [in] end
+			 *		A pointer to one past the last code point.
+			 *	\param [out] out
+			 *		A pointer to \em end-\em begin NFD_Quick_Check
+			 *		properties, each of which is set as
+			 *		GetNFDQuickCheck would return it for the
+			 *		corresponding code point.
+			 */
+			void GetNFDQuickCheck (const CodePoint * begin, const CodePoint * end, QuickCheck * out) const noexcept;
+			/**
+			 *	Retrieves the binary properties of a certain
+			 *	code point.
+			 *
+			 *	\param [in] cp
+			 *		The code point.
+			 *
+			 *	\return
+			 *		The binary properties of \em cp as a
+			 *		combination of BinaryProperty constants,
+			 *		or zero if there is no information about
+			 *		\em cp.
+			 */
+			std::uint64_t GetBinaryProperties (CodePoint cp) const noexcept;
+			/**
+			 *	Retrieves the binary properties of each code point
+			 *	in a range.
+			 *
+			 *	\param [in] begin
+			 *		A pointer to the first code point.
+			 *	\param [in] end
+			 *		A pointer to one past the last code point.
+			 *	\param [out] out
+			 *		A pointer to \em end-\em begin sets of binary
+			 *		properties, each of which is set as
+			 *		GetBinaryProperties would return it for the
+			 *		corresponding code point.
+			 */
+			void GetBinaryProperties (const CodePoint * begin, const CodePoint * end, std::uint64_t * out) const noexcept;
 	
 	
 	};
@@ -27,7 +27,7 @@ namespace Unicode {
 			const Locale & locale;
 			
 			
-			QuickCheck is_impl (const CodePoint *, const CodePoint *, QuickCheck (CodePointInfo::*)) const noexcept;
+			QuickCheck is_impl (const CodePoint *, const CodePoint *, void (Locale::*) (const CodePoint *, const CodePoint *, QuickCheck *) const) const noexcept;
 			
 			
 			void decompose (std::vector<CodePoint> &, CodePoint) const;
@@ -0,0 +1,168 @@
+/**
+ *	\file
+ */
+
+
+#pragma once
+
+
+#include <unicode/encoding.hpp>
+#include <cstddef>
+#include <optional>
+
+
+namespace Unicode {
+
+
+	/**
+	 *	The tables which describe an encoding in which
+	 *	each byte represents a single code point.
+	 */
+	class SingleByteTable {
+	
+	
+		public:
+		
+		
+			/**
+			 *	The value in Decode for bytes which do not
+			 *	represent any code point.
+			 */
+			static constexpr CodePoint::Type Unmapped=0xFFFFFFFFU;
+			
+			
+			/**
+			 *	The code point each of the 256 bytes represents,
+			 *	or Unmapped.
+			 */
+			const CodePoint::Type * Decode;
+			/**
+			 *	For each of the 256 possible values of the
+			 *	upper eight bits of a code point in the Basic
+			 *	Multilingual Plane, the block of Encode in
+			 *	which its lower eight bits are looked up.
+			 */
+			const unsigned char * Blocks;
+			/**
+			 *	Blocks of 256 bytes, each of which gives the
+			 *	byte which represents each code point in the
+			 *	block.  A byte whose entry in Decode is not
+			 *	the code point looked up means the code point
+			 *	cannot be represented.
+			 */
+			const unsigned char * Encode;
+	
+	
+	};
+	
+	
+	/**
+	 *	An encoder/decoder which transforms Unicode text
+	 *	as best as possible between Unicode and an encoding
+	 *	in which each byte represents a single code point.
+	 *
+	 *	The tables for Windows code pages 1250 through
+	 *	1258 and for ISO-8859-2 through ISO-8859-16 are
+	 *	generated from the mapping files published by the
+	 *	Unicode Consortium.
+	 */
+	class SingleByte : public Encoding {
+	
+	
+		private:
+		
+		
+			SingleByteTable table;
+			bool ascii;
+			
+			
+			std::optional<unsigned char> get (CodePoint) const noexcept;
+		
+		
+		protected:
+		
+		
+			virtual void Encoder (
+				std::vector<unsigned char> & buffer,
+				CodePoint cp
+			) const override;
+			
+			virtual const CodePoint * BulkCounter (
+				std::size_t & bytes,
+				const CodePoint * begin,
+				const CodePoint * end
+			) const override;
+			
+			virtual void BulkEncoder (
+				unsigned char * out,
+				const CodePoint * begin,
+				const CodePoint * end
+			) const override;
+			
+			virtual std::optional<EncodingErrorType> Decoder (
+				CodePoint & cp,
+				const unsigned char * & begin,
+				const unsigned char * end,
+				std::optional<Unicode::Endianness> order
+			) const override;
+			
+			virtual const unsigned char * BulkDecoder (
+				CodePoint * & out,
+				const unsigned char * begin,
+				const unsigned char * limit,
+				const unsigned char * end,
+				std::optional<Unicode::Endianness> order
+			) const override;
+		
+		
+		public:
+		
+		
+			typedef unsigned char CodeUnit;
+			
+			
+			static const SingleByteTable Windows1250;
+			static const SingleByteTable Windows1251;
+			static const SingleByteTable Windows1252;
+			static const SingleByteTable Windows1253;
+			static const SingleByteTable Windows1254;
+			static const SingleByteTable Windows1255;
+			static const SingleByteTable Windows1256;
+			static const SingleByteTable Windows1257;
+			static const SingleByteTable Windows1258;
+			static const SingleByteTable ISO8859_2;
+			static const SingleByteTable ISO8859_3;
+			static const SingleByteTable ISO8859_4;
+			static const SingleByteTable ISO8859_5;
+			static const SingleByteTable ISO8859_6;
+			static const SingleByteTable ISO8859_7;
+			static const SingleByteTable ISO8859_8;
+			static const SingleByteTable ISO8859_9;
+			static const SingleByteTable ISO8859_10;
+			static const SingleByteTable ISO8859_11;
+			static const SingleByteTable ISO8859_13;
+			static const SingleByteTable ISO8859_14;
+			static const SingleByteTable ISO8859_15;
+			static const SingleByteTable ISO8859_16;
+			
+			
+			/**
+			 *	Creates a new SingleByte encoder/decoder.
+			 *
+			 *	\param [in] table
+			 *		The tables which describe the encoding.  The
+			 *		arrays they point to must outlive the encoder/
+			 *		decoder.
+			 */
+			explicit SingleByte (const SingleByteTable & table) noexcept;
+			
+			
+			bool CanRepresent (CodePoint) const noexcept override;
+			std::size_t Count (CodePoint) const noexcept override;
+			std::size_t Size () const noexcept override;
+	
+	
+	};
+
+
+}
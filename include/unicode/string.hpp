@@ -149,6 +149,7 @@ namespace Unicode {
 			
 			
 			std::vector<unsigned char> to_c_string (std::size_t) const;
+			std::size_t to_c_string (void *, std::size_t, std::size_t) const;
 			void from_c_string (const void *, std::size_t);
 			
 			
@@ -679,13 +680,18 @@ namespace Unicode {
 			std::basic_string<decay<T>> ToString () const {
 			
 				typedef decay<T> type;
-			
-				auto vec=to_c_string(sizeof(type));
 				
-				return std::basic_string<type>(
-					reinterpret_cast<const type *>(Begin(vec)),
-					reinterpret_cast<const type *>(End(vec))
-				);
+				//	Guess one code unit per code point, which is
+				//	exact for most text, and only encode a second
+				//	time if the guess proves too small
+				std::basic_string<type> retr(cps.size(),type());
+				auto size=to_c_string(&retr[0],retr.size()*sizeof(type),sizeof(type));
+				auto len=size/sizeof(type);
+				auto fits=len<=retr.size();
+				retr.resize(len);
+				if (!fits) to_c_string(&retr[0],size,sizeof(type));
+				
+				return retr;
 			
 			}
 			
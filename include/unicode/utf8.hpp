@@ -26,12 +26,48 @@ namespace Unicode {
 				CodePoint cp
 			) const override;
 			
+			virtual const CodePoint * BulkCounter (
+				std::size_t & bytes,
+				const CodePoint * begin,
+				const CodePoint * end
+			) const override;
+			
+			virtual void BulkEncoder (
+				unsigned char * out,
+				const CodePoint * begin,
+				const CodePoint * end
+			) const override;
+			
 			virtual std::optional<EncodingErrorType> Decoder (
 				CodePoint & cp,
 				const unsigned char * & begin,
 				const unsigned char * end,
 				std::optional<Unicode::Endianness> order
 			) const override;
+			
+			virtual const unsigned char * BulkDecoder (
+				CodePoint * & out,
+				const unsigned char * begin,
+				const unsigned char * limit,
+				const unsigned char * end,
+				std::optional<Unicode::Endianness> order
+			) const override;
+			
+			virtual const unsigned char * BulkMeasurer (
+				std::size_t & cps,
+				std::size_t * lines,
+				const unsigned char * begin,
+				const unsigned char * limit,
+				const unsigned char * end,
+				std::optional<Unicode::Endianness> order
+			) const override;
+			
+			virtual const unsigned char * Boundary (
+				const unsigned char * begin,
+				const unsigned char * where,
+				const unsigned char * end,
+				std::optional<Unicode::Endianness> order
+			) const override;
 	
 	
 		public:
@@ -6,6 +6,8 @@
 #pragma once
 
 
+#include <algorithm>
+#include <cstddef>
 #include <optional>
 #include <vector>
 
@@ -82,6 +84,19 @@ namespace Unicode {
 	}
 	
 	
+	//	Ensures there's room for a certain number of
+	//	elements to be added to a vector, growing it
+	//	geometrically so that repeated calls don't
+	//	reallocate each time
+	template <typename T>
+	void Reserve (std::vector<T> & vec, std::size_t n) {
+	
+		auto capacity=vec.size()+n;
+		if (vec.capacity()<capacity) vec.reserve(std::max(capacity,vec.capacity()*2));
+	
+	}
+	
+	
 	/**
 	 *	\endcond
 	 */
@@ -1,4 +1,5 @@
 #include <unicode/ascii.hpp>
+#include "simd.hpp"
 
 
 namespace Unicode {
@@ -11,6 +12,23 @@ namespace Unicode {
 	}
 	
 	
+	const CodePoint * ASCII::BulkCounter (std::size_t & bytes, const CodePoint * begin, const CodePoint * end) const {
+	
+		auto last=skip_below(begin,end,0x80U);
+		bytes=static_cast<std::size_t>(last-begin);
+		
+		return last;
+	
+	}
+	
+	
+	void ASCII::BulkEncoder (unsigned char * out, const CodePoint * begin, const CodePoint * end) const {
+	
+		narrow(out,begin,end);
+	
+	}
+	
+	
 	std::optional<EncodingErrorType> ASCII::Decoder (CodePoint & cp, const unsigned char * & begin, const unsigned char * end, std::optional<Unicode::Endianness>) const {
 	
 		if ((*begin>128) && !Strict.Ignored()) return EncodingErrorType::Strict;
@@ -22,6 +40,15 @@ namespace Unicode {
 	}
 	
 	
+	const unsigned char * ASCII::BulkDecoder (CodePoint * & out, const unsigned char * begin, const unsigned char * limit, const unsigned char *, std::optional<Unicode::Endianness>) const {
+	
+		for (;(begin!=limit) && (*begin<0x80U);++begin) *(out++)=*begin;
+		
+		return begin;
+	
+	}
+	
+	
 	ASCII::ASCII () noexcept : Encoding(false,false) {	}
 	
 	
@@ -0,0 +1,687 @@
+#include <unicode/boundaries.hpp>
+#include <unicode/caseconverter.hpp>
+#include <unicode/codepoint.hpp>
+#include <unicode/collator.hpp>
+#include <unicode/comparer.hpp>
+#include <unicode/detectencoding.hpp>
+#include <unicode/iostream.hpp>
+#include <unicode/latin1.hpp>
+#include <unicode/loadfile.hpp>
+#include <unicode/locale.hpp>
+#include <unicode/normalizer.hpp>
+#include <unicode/singlebyte.hpp>
+#include <unicode/string.hpp>
+#include <unicode/ucs2.hpp>
+#include <unicode/utf8.hpp>
+#include <unicode/utf16.hpp>
+#include <unicode/utf32.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+using namespace Unicode;
+
+
+//	Minimum amount of time for which each benchmark
+//	will be run
+static const std::chrono::milliseconds duration(500);
+
+
+//	Prevents the optimizer from eliding lookups
+static volatile std::size_t sink;
+
+
+//	Repeatedly invokes a callable which performs a
+//	certain number of operations, and reports how
+//	many operations per second were achieved
+template <typename T>
+static void run (const std::string & name, std::size_t ops, T && callback) {
+
+	typedef std::chrono::steady_clock clock;
+	
+	std::size_t total=0;
+	auto begin=clock::now();
+	auto end=begin;
+	do {
+	
+		callback();
+		total+=ops;
+		
+		end=clock::now();
+	
+	} while ((end-begin)<duration);
+	
+	double seconds=std::chrono::duration<double>(end-begin).count();
+	
+	std::cout	<<	std::left
+				<<	std::setw(40)
+				<<	name
+				<<	std::right
+				<<	std::setw(16)
+				<<	std::fixed
+				<<	std::setprecision(0)
+				<<	(static_cast<double>(total)/seconds)
+				<<	" ops/s"
+				<<	std::endl;
+
+}
+
+
+//	Looks up every code point in a range
+static void lookup (const std::string & name, const Locale & locale, CodePoint::Type low, CodePoint::Type high) {
+
+	run(name,high-low+1,[&] () noexcept {
+	
+		std::size_t found=0;
+		for (auto cp=low;cp<=high;++cp) if (locale.GetInfo(cp)!=nullptr) ++found;
+		
+		sink=found;
+	
+	});
+
+}
+
+
+//	Looks up every code point in a range at once
+static void lookup_range (const std::string & name, const Locale & locale, CodePoint::Type low, CodePoint::Type high) {
+
+	std::vector<CodePoint> cps;
+	for (auto cp=low;cp<=high;++cp) cps.push_back(cp);
+	std::vector<const CodePointInfo *> info(cps.size());
+	
+	run(name,cps.size(),[&] () noexcept {
+	
+		locale.GetInfo(cps.data(),cps.data()+cps.size(),info.data());
+		
+		sink=std::count(info.begin(),info.end(),nullptr);
+	
+	});
+
+}
+
+
+//	Generates a long multilingual document
+static std::vector<CodePoint> document () {
+
+	const char32_t sample []=U"Ça fait déjà l'été, n'est-ce pas? "
+		U"Ελληνικά κείμενα με τόνους. "
+		U"Русский текст для проверки. "
+		U"日本語のテキストです。"
+		U"한국어 텍스트입니다. "
+		U"a\u0301e\u0300o\u0302u\u0308\u0323 ";
+	
+	std::vector<CodePoint> retr;
+	while (retr.size()<(1U<<20)) for (auto c : sample) if (c!=0) retr.push_back(c);
+	
+	return retr;
+
+}
+
+
+//	Generates a long document consisting almost
+//	entirely of ASCII
+static std::vector<CodePoint> ascii_document () {
+
+	const char sample []="The quick brown fox jumps over the lazy dog.\n"
+		"\tLorem ipsum dolor sit amet, consectetur adipiscing elit, "
+		"sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. "
+		"Caf\xE9 na\xEFve r\xE9sum\xE9 \xA9 2015.\r\n";
+	
+	std::vector<CodePoint> retr;
+	while (retr.size()<(1U<<20)) for (auto c : sample) if (c!=0) retr.push_back(static_cast<unsigned char>(c));
+	
+	return retr;
+
+}
+
+
+//	Generates a long document consisting of composed
+//	Korean text
+static std::vector<CodePoint> korean_document () {
+
+	const char32_t sample []=U"다람쥐 헌 쳇바퀴에 타고파. "
+		U"한국어 텍스트를 정규화합니다. ";
+	
+	std::vector<CodePoint> retr;
+	while (retr.size()<(1U<<20)) for (auto c : sample) if (c!=0) retr.push_back(c);
+	
+	return retr;
+
+}
+
+
+//
+//	BOUNDARIES
+//
+
+
+static void boundaries () {
+
+	auto doc=document();
+	auto begin=doc.data();
+	auto end=begin+doc.size();
+	
+	//	A copy of the default locale without packed
+	//	tables, which forces properties to be read from
+	//	CodePointInfo structures
+	Locale records(DefaultLocale);
+	records.Properties=PropertyTables{};
+	
+	auto grapheme=[&] (const Locale & locale) {
+	
+		return [&,begin,end] () noexcept {
+		
+			std::size_t found=0;
+			for (auto loc=begin;loc!=end;++loc) if (IsGraphemeClusterBoundary(loc,begin,end,locale)) ++found;
+			
+			sink=found;
+		
+		};
+	
+	};
+	auto word=[&] (const Locale & locale) {
+	
+		return [&,begin,end] () noexcept {
+		
+			std::size_t found=0;
+			for (auto loc=begin;loc!=end;++loc) if (IsWordBoundary(loc,begin,end,locale)) ++found;
+			
+			sink=found;
+		
+		};
+	
+	};
+	
+	auto find=[&] (void (* func) (const CodePoint *, const CodePoint *, bool *, const Locale &)) {
+	
+		return [&,func,begin,end] () {
+		
+			std::vector<char> found(doc.size()+1);
+			func(begin,end,reinterpret_cast<bool *>(found.data()),DefaultLocale);
+			
+			sink=std::count(found.begin(),found.end(),1);
+		
+		};
+	
+	};
+	
+	run("IsGraphemeClusterBoundary (records)",doc.size(),grapheme(records));
+	run("IsGraphemeClusterBoundary (packed)",doc.size(),grapheme(DefaultLocale));
+	run("FindGraphemeClusterBoundaries",doc.size(),find(FindGraphemeClusterBoundaries));
+	run("IsWordBoundary (records)",doc.size(),word(records));
+	run("IsWordBoundary (packed)",doc.size(),word(DefaultLocale));
+	run("FindWordBoundaries",doc.size(),find(FindWordBoundaries));
+
+}
+
+
+//
+//	COLLATOR
+//
+
+
+static void collator () {
+
+	//	Unified ideographs, which have no entries in
+	//	the collation table and are therefore weighted
+	//	implicitly
+	std::vector<CodePoint> doc;
+	for (CodePoint::Type cp=0x4E00U;doc.size()<(1U<<16);cp=(cp==0x9FFFU) ? 0x4E00U : (cp+7)) doc.push_back(cp);
+	auto begin=doc.data();
+	auto end=begin+doc.size();
+	
+	run("Collator::GetSortKey (CJK)",doc.size(),[&] () {	sink=Collator().GetSortKey(begin,end).size();	});
+
+}
+
+
+//
+//	DETECT ENCODING
+//
+
+
+static void detectencoding () {
+
+	UTF8 utf8;
+	UTF16 utf16;
+	utf16.OutputBOM=false;
+	Latin1 latin1;
+	auto doc=document();
+	auto ascii_doc=ascii_document();
+	auto utf8_doc=utf8.Encode(doc);
+	auto utf16_doc=utf16.Encode(ascii_doc);
+	auto latin1_doc=latin1.Encode(ascii_doc);
+	
+	//	Bytes examined per second
+	auto detect=[&] (const std::vector<unsigned char> & buffer) {
+	
+		return [&] () {	sink=static_cast<std::size_t>(DetectEncoding(buffer.data(),buffer.data()+buffer.size()).Confidence*100);	};
+	
+	};
+	run("DetectEncoding (UTF-8, multilingual)",65536,detect(utf8_doc));
+	run("DetectEncoding (UTF-16, no BOM)",65536,detect(utf16_doc));
+	run("DetectEncoding (Latin-1)",65536,detect(latin1_doc));
+
+}
+
+
+//
+//	ENCODING
+//
+
+
+static void encoding () {
+
+	//	Decodes a buffer one code point at a time
+	auto stream=[&] (const Encoding & encoding, const std::vector<unsigned char> & buffer) {
+	
+		return [&] () {
+		
+			std::vector<CodePoint> cps;
+			const void * begin=buffer.data();
+			const void * end=buffer.data()+buffer.size();
+			while (auto cp=encoding.Stream(begin,end)) cps.push_back(*cp);
+			
+			sink=cps.size();
+		
+		};
+	
+	};
+	auto decode=[&] (const Encoding & encoding, const std::vector<unsigned char> & buffer) {
+	
+		return [&] () {	sink=encoding.Decode(buffer.data(),buffer.data()+buffer.size()).size();	};
+	
+	};
+	auto encode=[&] (const Encoding & encoding, const std::vector<CodePoint> & cps) {
+	
+		return [&] () {	sink=encoding.Encode(cps).size();	};
+	
+	};
+	
+	auto native=EndianEncoding::Detect();
+	auto foreign=(native==Endianness::Big) ? Endianness::Little : Endianness::Big;
+	UTF8 utf8;
+	UTF16 utf16(native,native);
+	utf16.OutputBOM=false;
+	UTF16 utf16_swapped(foreign,foreign);
+	utf16_swapped.OutputBOM=false;
+	UCS2 ucs2(native,native);
+	ucs2.OutputBOM=false;
+	UCS2 ucs2_swapped(foreign,foreign);
+	ucs2_swapped.OutputBOM=false;
+	UTF32 utf32(native,native);
+	utf32.OutputBOM=false;
+	UTF32 utf32_swapped(foreign,foreign);
+	utf32_swapped.OutputBOM=false;
+	Latin1 latin1;
+	SingleByte windows1252(SingleByte::Windows1252);
+	
+	auto ascii_doc=ascii_document();
+	auto doc=document();
+	auto ascii=utf8.Encode(ascii_doc);
+	auto utf8_doc=utf8.Encode(doc);
+	auto utf16_doc=utf16.Encode(doc);
+	auto utf16_swapped_doc=utf16_swapped.Encode(doc);
+	auto ucs2_doc=ucs2.Encode(doc);
+	auto ucs2_swapped_doc=ucs2_swapped.Encode(doc);
+	auto utf32_doc=utf32.Encode(doc);
+	auto utf32_swapped_doc=utf32_swapped.Encode(doc);
+	auto latin1_doc=latin1.Encode(ascii_doc);
+	//	Mostly ASCII with one code point in twenty
+	//	taken from the upper half of Windows-1252
+	auto windows1252_cps=ascii_doc;
+	for (std::size_t i=0;i<windows1252_cps.size();i+=20) windows1252_cps[i]=((i/20)%2==0) ? 0x20ACU : 0xE9U;
+	auto windows1252_doc=windows1252.Encode(windows1252_cps);
+	
+	//	Bytes decoded per second
+	run("UTF8::Stream (ASCII, one at a time)",ascii.size(),stream(utf8,ascii));
+	run("UTF8::Decode (ASCII)",ascii.size(),decode(utf8,ascii));
+	run("UTF8::Stream (multilingual, one at a time)",utf8_doc.size(),stream(utf8,utf8_doc));
+	run("UTF8::Decode (multilingual)",utf8_doc.size(),decode(utf8,utf8_doc));
+	run("UTF8::ParallelDecode (multilingual)",utf8_doc.size(),[&] () {	sink=utf8.ParallelDecode(utf8_doc.data(),utf8_doc.data()+utf8_doc.size()).size();	});
+	//	One byte in a hundred is invalid, and errors are
+	//	reported rather than thrown
+	auto invalid_doc=utf8_doc;
+	for (std::size_t i=0;i<invalid_doc.size();i+=100) invalid_doc[i]=0xFF;
+	UTF8 utf8_reporting;
+	run("UTF8::Decode (multilingual, 1% invalid, errors reported)",invalid_doc.size(),[&] () {
+	
+		EncodingErrorLog log(invalid_doc.data());
+		utf8_reporting.Sink=&log;
+		sink=utf8_reporting.Decode(invalid_doc.data(),invalid_doc.data()+invalid_doc.size()).size()+log.Entries.size();
+	
+	});
+	run("UTF16::Stream (one at a time)",utf16_doc.size(),stream(utf16,utf16_doc));
+	run("UTF16::Decode",utf16_doc.size(),decode(utf16,utf16_doc));
+	run("UTF16::Decode (swapped)",utf16_swapped_doc.size(),decode(utf16_swapped,utf16_swapped_doc));
+	run("UCS2::Decode",ucs2_doc.size(),decode(ucs2,ucs2_doc));
+	run("UCS2::Decode (swapped)",ucs2_swapped_doc.size(),decode(ucs2_swapped,ucs2_swapped_doc));
+	run("UTF32::Decode",utf32_doc.size(),decode(utf32,utf32_doc));
+	run("UTF32::Decode (swapped)",utf32_swapped_doc.size(),decode(utf32_swapped,utf32_swapped_doc));
+	run("Latin1::Decode",latin1_doc.size(),decode(latin1,latin1_doc));
+	run("SingleByte::Decode (Windows-1252, ASCII)",latin1_doc.size(),decode(windows1252,latin1_doc));
+	run("SingleByte::Decode (Windows-1252)",windows1252_doc.size(),decode(windows1252,windows1252_doc));
+	run("UTF8::DecodedSize (multilingual)",utf8_doc.size(),[&] () {	sink=utf8.DecodedSize(utf8_doc.data(),utf8_doc.data()+utf8_doc.size());	});
+	run("UTF8::Measure (ASCII, with lines)",ascii.size(),[&] () {	sink=utf8.Measure(ascii.data(),ascii.data()+ascii.size(),true).Lines;	});
+	run("UTF8::Measure (multilingual)",utf8_doc.size(),[&] () {	sink=utf8.Measure(utf8_doc.data(),utf8_doc.data()+utf8_doc.size()).CodePoints;	});
+	run("UTF8::Measure (multilingual, with lines)",utf8_doc.size(),[&] () {	sink=utf8.Measure(utf8_doc.data(),utf8_doc.data()+utf8_doc.size(),true).Lines;	});
+	run("UTF16::Measure (with lines)",utf16_doc.size(),[&] () {	sink=utf16.Measure(utf16_doc.data(),utf16_doc.data()+utf16_doc.size(),true).Lines;	});
+	run("UTF32::Measure",utf32_doc.size(),[&] () {	sink=utf32.Measure(utf32_doc.data(),utf32_doc.data()+utf32_doc.size()).CodePoints;	});
+	run("StreamDecoder::Decode (UTF8, 1500 byte chunks)",utf8_doc.size(),[&] () {
+	
+		std::vector<CodePoint> cps;
+		StreamDecoder decoder(utf8);
+		for (std::size_t i=0;i<utf8_doc.size();i+=1500) {
+		
+			auto begin=utf8_doc.data()+i;
+			decoder.Decode(begin,begin+std::min<std::size_t>(1500,utf8_doc.size()-i),cps);
+		
+		}
+		decoder.Finish(cps);
+		
+		sink=cps.size();
+	
+	});
+	
+	//	Code points encoded per second
+	run("UTF8::Encode (ASCII)",ascii_doc.size(),encode(utf8,ascii_doc));
+	run("UTF8::Encode (multilingual)",doc.size(),encode(utf8,doc));
+	run("UTF8::ParallelEncode (multilingual)",doc.size(),[&] () {	sink=utf8.ParallelEncode(doc.data(),doc.data()+doc.size()).size();	});
+	run("UTF16::Encode",doc.size(),encode(utf16,doc));
+	run("UTF16::Encode (swapped)",doc.size(),encode(utf16_swapped,doc));
+	run("UTF32::Encode",doc.size(),encode(utf32,doc));
+	run("UTF32::Encode (swapped)",doc.size(),encode(utf32_swapped,doc));
+	run("Latin1::Encode",ascii_doc.size(),encode(latin1,ascii_doc));
+	run("SingleByte::Encode (Windows-1252, ASCII)",ascii_doc.size(),encode(windows1252,ascii_doc));
+	run("SingleByte::Encode (Windows-1252)",windows1252_cps.size(),encode(windows1252,windows1252_cps));
+	
+	//	Bytes transcoded per second
+	auto transcode=[&] (const Encoding & from, const Encoding & to, const std::vector<unsigned char> & buffer) {
+	
+		return [&] () {	sink=from.Transcode(buffer.data(),buffer.data()+buffer.size(),to).size();	};
+	
+	};
+	run("UTF8::Decode, UTF16::Encode",utf8_doc.size(),[&] () {	sink=utf16.Encode(utf8.Decode(utf8_doc.data(),utf8_doc.data()+utf8_doc.size())).size();	});
+	run("UTF8::Transcode (UTF16)",utf8_doc.size(),transcode(utf8,utf16,utf8_doc));
+	run("UTF8::Transcode (ASCII to UTF16)",ascii.size(),transcode(utf8,utf16,ascii));
+	run("UTF16::Decode, UTF8::Encode",utf16_doc.size(),[&] () {	sink=utf8.Encode(utf16.Decode(utf16_doc.data(),utf16_doc.data()+utf16_doc.size())).size();	});
+	run("UTF16::Transcode (UTF8)",utf16_doc.size(),transcode(utf16,utf8,utf16_doc));
+	run("UTF16::Transcode (UTF8, swapped)",utf16_swapped_doc.size(),transcode(utf16_swapped,utf8,utf16_swapped_doc));
+	
+	//	Encoding into memory the caller owns
+	auto begin=doc.data();
+	auto end=begin+doc.size();
+	std::vector<unsigned char> buffer(utf8.EncodedSize(begin,end));
+	run("UTF8::EncodedSize (multilingual)",doc.size(),[&] () {	sink=utf8.EncodedSize(begin,end);	});
+	run("UTF8::Encode (multilingual, caller's buffer)",doc.size(),[&] () {	sink=utf8.Encode(begin,end,buffer.data(),buffer.size());	});
+	
+	ascii.push_back(0);
+	auto str=reinterpret_cast<const char *>(ascii.data());
+	run("String (const char *)",ascii.size(),[&] () {	sink=String(str).Size();	});
+	String ascii_str(ascii_doc);
+	String str_doc(doc);
+	run("String::ToString (ASCII)",ascii_doc.size(),[&] () {	sink=ascii_str.ToString().size();	});
+	run("String::ToString (multilingual)",doc.size(),[&] () {	sink=str_doc.ToString().size();	});
+	run("String::ToString<char16_t> (multilingual)",doc.size(),[&] () {	sink=str_doc.ToString<char16_t>().size();	});
+
+}
+
+
+//
+//	IOSTREAM
+//
+
+
+static void iostream () {
+
+	//	The document broken into lines of about eighty
+	//	code points
+	auto doc=document();
+	for (std::size_t i=80;i<doc.size();i+=81) doc.insert(doc.begin()+i,'\n');
+	auto text=String(std::move(doc)).ToString();
+	
+	run("operator >> (String, multilingual lines)",text.size(),[&] () {
+	
+		std::istringstream ss(text);
+		std::size_t lines=0;
+		for (String line;ss >> line;) ++lines;
+		
+		sink=lines;
+	
+	});
+	
+	const char * const samples []={
+		"The quick brown fox jumps over the lazy dog.",
+		"",
+		"Lorem ipsum dolor sit amet, consectetur adipiscing elit."
+	};
+	std::string ascii;
+	for (std::size_t i=0;ascii.size()<(1U<<20);++i) {
+	
+		ascii+=samples[i%3];
+		ascii+='\n';
+	
+	}
+	run("operator >> (String, ASCII lines)",ascii.size(),[&] () {
+	
+		std::istringstream ss(ascii);
+		std::size_t lines=0;
+		for (String line;ss >> line;) ++lines;
+		
+		sink=lines;
+	
+	});
+
+}
+
+
+//
+//	LATIN-1
+//
+
+
+static void latin1 () {
+
+	auto doc=ascii_document();
+	auto begin=doc.data();
+	auto end=begin+doc.size();
+	
+	//	A copy of the default locale without the
+	//	direct lookup table for the Latin-1 range
+	Locale index(DefaultLocale);
+	index.Latin1Info=decltype(index.Latin1Info){};
+	
+	auto white_space=[&] (const Locale & locale) {
+	
+		return [&,begin,end] () noexcept {
+		
+			std::size_t found=0;
+			for (auto loc=begin;loc!=end;++loc) if (loc->IsWhiteSpace(locale)) ++found;
+			
+			sink=found;
+		
+		};
+	
+	};
+	auto is_nfc=[&] (const Locale & locale) {
+	
+		return [&,begin,end] () noexcept {	sink=Normalizer(locale).IsNFC(begin,end);	};
+	
+	};
+	auto to_lower=[&] (const Locale & locale) {
+	
+		return [&,begin,end] () {	sink=CaseConverter(locale).ToLower(begin,end).size();	};
+	
+	};
+	auto compare=[&] (const Locale & locale) {
+	
+		return [&,begin,end] () {	sink=Comparer(locale,false).Compare(begin,end,begin,end);	};
+	
+	};
+	
+	run("CodePoint::IsWhiteSpace (ASCII, index)",doc.size(),white_space(index));
+	run("CodePoint::IsWhiteSpace (ASCII, direct)",doc.size(),white_space(DefaultLocale));
+	run("Normalizer::IsNFC (ASCII, index)",doc.size(),is_nfc(index));
+	run("Normalizer::IsNFC (ASCII, direct)",doc.size(),is_nfc(DefaultLocale));
+	run("CaseConverter::ToLower (ASCII, index)",doc.size(),to_lower(index));
+	run("CaseConverter::ToLower (ASCII, direct)",doc.size(),to_lower(DefaultLocale));
+	run("Comparer::Compare (ASCII, index)",doc.size(),compare(index));
+	run("Comparer::Compare (ASCII, direct)",doc.size(),compare(DefaultLocale));
+
+}
+
+
+//
+//	LOAD FILE
+//
+
+
+static void loadfile () {
+
+	//	A file of a few dozen megabytes, large enough to
+	//	be divided between every thread
+	UTF8 utf8;
+	UTF16 utf16;
+	auto doc=document();
+	auto utf8_doc=utf8.Encode(doc);
+	auto utf16_doc=utf16.Encode(doc);
+	const char * filename="bench.txt";
+	auto write=[&] (const std::vector<unsigned char> & buffer) {
+	
+		std::ofstream stream(filename,std::ios::binary|std::ios::trunc);
+		std::size_t size=0;
+		for (;size<(64U<<20);size+=buffer.size()) stream.write(
+			reinterpret_cast<const char *>(buffer.data()),
+			static_cast<std::streamsize>(buffer.size())
+		);
+		
+		return size;
+	
+	};
+	
+	auto size=write(utf8_doc);
+	run("ifstream and UTF8::Decode (multilingual)",size,[&] () {
+	
+		std::ifstream stream(filename,std::ios::binary);
+		std::vector<unsigned char> buffer(size);
+		stream.read(reinterpret_cast<char *>(buffer.data()),static_cast<std::streamsize>(size));
+		
+		sink=utf8.Decode(buffer.data(),buffer.data()+buffer.size()).size();
+	
+	});
+	run("LoadFile (UTF-8, multilingual)",size,[&] () {	sink=LoadFile(filename).Size();	});
+	
+	size=write(utf16_doc);
+	run("LoadFile (UTF-16, multilingual)",size,[&] () {	sink=LoadFile(filename).Size();	});
+	
+	std::remove(filename);
+
+}
+
+
+//
+//	LOCALE
+//
+
+
+static void locale () {
+
+	//	A copy of the default locale without an index,
+	//	which forces lookups to search
+	Locale search(DefaultLocale);
+	search.InfoIndex=CodePointIndex{};
+	
+	lookup("Locale::GetInfo (BMP, search)",search,0,0xFFFFU);
+	lookup("Locale::GetInfo (BMP, index)",DefaultLocale,0,0xFFFFU);
+	lookup_range("Locale::GetInfo (BMP, index, range)",DefaultLocale,0,0xFFFFU);
+	lookup("Locale::GetInfo (astral, search)",search,0x10000U,CodePoint::Max);
+	lookup("Locale::GetInfo (astral, index)",DefaultLocale,0x10000U,CodePoint::Max);
+	lookup_range("Locale::GetInfo (astral, index, range)",DefaultLocale,0x10000U,CodePoint::Max);
+
+}
+
+
+//
+//	NORMALIZER
+//
+
+
+static void normalizer () {
+
+	auto doc=document();
+	auto begin=doc.data();
+	auto end=begin+doc.size();
+	//	Quick checks only scan the whole string if it's
+	//	normalized
+	auto nfd=Normalizer().ToNFD(begin,end);
+	auto nfd_begin=nfd.data();
+	auto nfd_end=nfd_begin+nfd.size();
+	
+	Locale records(DefaultLocale);
+	records.Properties=PropertyTables{};
+	
+	auto is_nfd=[&] (const Locale & locale) {
+	
+		return [&,nfd_begin,nfd_end] () noexcept {	sink=Normalizer(locale).IsNFD(nfd_begin,nfd_end);	};
+	
+	};
+	auto to_nfc=[&] (const Locale & locale) {
+	
+		return [&,begin,end] () {	sink=Normalizer(locale).ToNFC(begin,end).size();	};
+	
+	};
+	
+	run("Normalizer::IsNFD (records)",nfd.size(),is_nfd(records));
+	run("Normalizer::IsNFD (packed)",nfd.size(),is_nfd(DefaultLocale));
+	run("Normalizer::ToNFC (records)",doc.size(),to_nfc(records));
+	run("Normalizer::ToNFC (packed)",doc.size(),to_nfc(DefaultLocale));
+	
+	auto korean=korean_document();
+	auto korean_begin=korean.data();
+	auto korean_end=korean_begin+korean.size();
+	auto korean_nfd=Normalizer().ToNFD(korean_begin,korean_end);
+	auto korean_nfd_begin=korean_nfd.data();
+	auto korean_nfd_end=korean_nfd_begin+korean_nfd.size();
+	
+	run("Normalizer::ToNFC (Korean, composed)",korean.size(),[&] () {
+	
+		sink=Normalizer().ToNFC(korean_begin,korean_end).size();
+	
+	});
+	run("Normalizer::ToNFC (Korean, decomposed)",korean_nfd.size(),[&] () {
+	
+		sink=Normalizer().ToNFC(korean_nfd_begin,korean_nfd_end).size();
+	
+	});
+	run("Normalizer::ToNFD (Korean, composed)",korean.size(),[&] () {
+	
+		sink=Normalizer().ToNFD(korean_begin,korean_end).size();
+	
+	});
+
+}
+
+
+int main () {
+
+	boundaries();
+	collator();
+	detectencoding();
+	encoding();
+	iostream();
+	latin1();
+	loadfile();
+	locale();
+	normalizer();
+	
+	return 0;
+
+}
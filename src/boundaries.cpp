@@ -1,7 +1,10 @@
 #include <unicode/boundaries.hpp>
 #include <unicode/makereverseiterator.hpp>
+#include "simd.hpp"
+#include <algorithm>
 #include <cstddef>
 #include <optional>
+#include <vector>
 
 
 namespace Unicode {
@@ -12,8 +15,7 @@ namespace Unicode {
 
 	static GCB get_gcb (CodePoint cp, const Locale & locale) noexcept {
 	
-		auto cpi=cp.GetInfo(locale);
-		return (cpi==nullptr) ? GCB::XX : cpi->GraphemeClusterBreak;
+		return locale.GetGraphemeClusterBreak(cp);
 	
 	}
 	
@@ -72,7 +74,12 @@ namespace Unicode {
 	}
 
 
-	bool IsGraphemeClusterBoundary (const CodePoint * loc, const CodePoint * begin, const CodePoint * end, const Locale & locale) noexcept {
+	//	Rules are applied to sequences of either code
+	//	points, whose properties are looked up by get,
+	//	or of properties looked up in advance, in which
+	//	case get simply returns its argument
+	template <typename T, typename Get>
+	static bool is_grapheme_cluster_boundary (const T * loc, const T * begin, const T * end, Get get) noexcept {
 	
 		//	Break at the start and end of text
 		if (
@@ -80,8 +87,8 @@ namespace Unicode {
 			(loc==end)
 		) return true;
 		
-		auto a=get_gcb(*(loc-1),locale);
-		auto b=get_gcb(*loc,locale);
+		GCB a=get(*(loc-1));
+		GCB b=get(*loc);
 		
 		//	Do not break between a CR and LF
 		if ((a==GCB::CR) && (b==GCB::LF)) return false;
@@ -107,13 +114,37 @@ namespace Unicode {
 	}
 	
 	
+	bool IsGraphemeClusterBoundary (const CodePoint * loc, const CodePoint * begin, const CodePoint * end, const Locale & locale) noexcept {
+	
+		return is_grapheme_cluster_boundary(loc,begin,end,[&] (CodePoint cp) noexcept {	return get_gcb(cp,locale);	});
+	
+	}
+	
+	
+	void FindGraphemeClusterBoundaries (const CodePoint * begin, const CodePoint * end, bool * out, const Locale & locale) {
+	
+		std::vector<GCB> gcbs(end-begin);
+		locale.GetGraphemeClusterBreak(begin,end,gcbs.data());
+		
+		auto gcbs_begin=gcbs.data();
+		auto gcbs_end=gcbs_begin+gcbs.size();
+		for (auto loc=gcbs_begin;;++loc,++out) {
+		
+			*out=is_grapheme_cluster_boundary(loc,gcbs_begin,gcbs_end,[] (GCB gcb) noexcept {	return gcb;	});
+			
+			if (loc==gcbs_end) break;
+		
+		}
+	
+	}
+	
+	
 	typedef WordBreak WB;
 	
 	
 	static WB get_wb (CodePoint cp, const Locale & locale) noexcept {
 	
-		auto cpi=cp.GetInfo(locale);
-		return (cpi==nullptr) ? WB::XX : cpi->WordBreak;
+		return locale.GetWordBreak(cp);
 	
 	}
 	
@@ -133,14 +164,14 @@ namespace Unicode {
 	}
 	
 	
-	template <typename T>
-	std::optional<WB> get_wb (T begin, T end, const Locale & locale, std::size_t skip=0) noexcept {
+	template <typename T, typename Get>
+	std::optional<WB> get_wb (T begin, T end, Get get, std::size_t skip=0) noexcept {
 	
 		std::size_t skipped=0;
 		
 		for (;begin!=end;++begin) {
 		
-			auto wb=get_wb(*begin,locale);
+			WB wb=get(*begin);
 			if (!is_ignored_wb(wb)) {
 			
 				if (skipped==skip) return wb;
@@ -248,7 +279,8 @@ namespace Unicode {
 	}
 	
 	
-	bool IsWordBoundary (const CodePoint * loc, const CodePoint * begin, const CodePoint * end, const Locale & locale) noexcept {
+	template <typename T, typename Get>
+	static bool is_word_boundary (const T * loc, const T * begin, const T * end, Get get) noexcept {
 	
 		//	Break at the start and end of text
 		if (
@@ -256,8 +288,8 @@ namespace Unicode {
 			(loc==end)
 		) return true;
 		
-		auto a=get_wb(*(loc-1),locale);
-		auto b=get_wb(*loc,locale);
+		WB a=get(*(loc-1));
+		WB b=get(*loc);
 		
 		//	Do not break within CRLF
 		if ((a==WB::CR) && (b==WB::LF)) return false;
@@ -276,7 +308,7 @@ namespace Unicode {
 			auto a_n=get_wb(
 				MakeReverseIterator(loc),
 				MakeReverseIterator(begin),
-				locale
+				get
 			);
 			
 			if (!a_n) return false;
@@ -297,7 +329,7 @@ namespace Unicode {
 		auto c=get_wb(
 			loc,
 			end,
-			locale,
+			get,
 			1
 		);
 		if (
@@ -312,7 +344,7 @@ namespace Unicode {
 		auto d=get_wb(
 			MakeReverseIterator(loc),
 			MakeReverseIterator(begin),
-			locale,
+			get,
 			1
 		);
 		if (
@@ -361,33 +393,46 @@ namespace Unicode {
 	}
 	
 	
-	static bool is_lf (CodePoint cp, const Locale & locale) noexcept {
+	bool IsWordBoundary (const CodePoint * loc, const CodePoint * begin, const CodePoint * end, const Locale & locale) noexcept {
+	
+		return is_word_boundary(loc,begin,end,[&] (CodePoint cp) noexcept {	return get_wb(cp,locale);	});
+	
+	}
+	
+	
+	void FindWordBoundaries (const CodePoint * begin, const CodePoint * end, bool * out, const Locale & locale) {
 	
-		auto cpi=cp.GetInfo(locale);
-		if (cpi==nullptr) return false;
+		std::vector<WB> wbs(end-begin);
+		locale.GetWordBreak(begin,end,wbs.data());
+		
+		auto wbs_begin=wbs.data();
+		auto wbs_end=wbs_begin+wbs.size();
+		for (auto loc=wbs_begin;;++loc,++out) {
 		
-		return cpi->LineBreak==LineBreak::LF;
+			*out=is_word_boundary(loc,wbs_begin,wbs_end,[] (WB wb) noexcept {	return wb;	});
+			
+			if (loc==wbs_end) break;
+		
+		}
 	
 	}
 	
 	
-	bool IsLineBreak (const CodePoint * loc, const CodePoint * begin, const CodePoint * end, const Locale & locale) noexcept {
+	template <typename T, typename Get>
+	static bool is_line_break (const T * loc, const T * begin, const T * end, Get get) noexcept {
 	
 		//	We want in all cases to examine the preceding character
 		if (begin==loc) return false;
 		
-		//	Look up information about this code point
-		auto cpi=(loc-1)->GetInfo(locale);
-		
-		//	If there's no info, no line break
-		if (cpi==nullptr) return false;
-		
-		switch (cpi->LineBreak) {
+		//	Code points about which there is no information
+		//	have a line break property of XX, which never
+		//	causes a line break
+		switch (get(*(loc-1))) {
 		
 			default:
 				return false;
 			case LineBreak::CR:
-				return (loc==end) || !is_lf(*loc,locale);
+				return (loc==end) || (get(*loc)!=LineBreak::LF);
 			case LineBreak::BK:
 			case LineBreak::LF:
 			case LineBreak::NL:
@@ -396,6 +441,113 @@ namespace Unicode {
 		}
 	
 	}
+	
+	
+	bool IsLineBreak (const CodePoint * loc, const CodePoint * begin, const CodePoint * end, const Locale & locale) noexcept {
+	
+		return is_line_break(loc,begin,end,[&] (CodePoint cp) noexcept {	return locale.GetLineBreak(cp);	});
+	
+	}
+	
+	
+	void FindLineBreaks (const CodePoint * begin, const CodePoint * end, bool * out, const Locale & locale) {
+	
+		std::vector<LineBreak> lbs(end-begin);
+		locale.GetLineBreak(begin,end,lbs.data());
+		
+		auto lbs_begin=lbs.data();
+		auto lbs_end=lbs_begin+lbs.size();
+		for (auto loc=lbs_begin;;++loc,++out) {
+		
+			*out=is_line_break(loc,lbs_begin,lbs_end,[] (LineBreak lb) noexcept {	return lb;	});
+			
+			if (loc==lbs_end) break;
+		
+		}
+	
+	}
+	
+	
+	//	Every code point which has a line break property of
+	//	BK, CR, LF, or NL is in the range U+000A through
+	//	U+000D, or is U+0085, U+2028, or U+2029
+	static bool may_terminate_line (CodePoint cp) noexcept {
+	
+		CodePoint::Type c=cp;
+		
+		return ((c>=0x0AU) && (c<=0x0DU)) || (c==0x85U) || ((c|1U)==0x2029U);
+	
+	}
+	
+	
+	#ifdef UNICODE_SSE2
+	//	Skips groups of four code points none of which
+	//	may terminate a line
+	static const CodePoint * skip_non_terminators (const CodePoint * begin, const CodePoint * end) noexcept {
+	
+		auto low=_mm_set1_epi32(0x09);
+		auto high=_mm_set1_epi32(0x0E);
+		auto nel=_mm_set1_epi32(0x85);
+		auto ls=_mm_set1_epi32(0x2029);
+		auto one=_mm_set1_epi32(1);
+		
+		for (;(end-begin)>=4;begin+=4) {
+		
+			//	Code points are never large enough for the
+			//	signed comparisons to matter
+			auto v=_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+			auto mask=_mm_or_si128(
+				_mm_and_si128(_mm_cmpgt_epi32(v,low),_mm_cmplt_epi32(v,high)),
+				_mm_or_si128(
+					_mm_cmpeq_epi32(v,nel),
+					_mm_cmpeq_epi32(_mm_or_si128(v,one),ls)
+				)
+			);
+			if (_mm_movemask_epi8(mask)!=0) break;
+		
+		}
+		
+		return begin;
+	
+	}
+	#endif
+	
+	
+	const CodePoint * FindLineTerminator (const CodePoint * begin, const CodePoint * end, const Locale & locale) noexcept {
+	
+		for (;;) {
+		
+			#ifdef UNICODE_SSE2
+			begin=skip_non_terminators(begin,end);
+			#endif
+			
+			//	Whatever couldn't be skipped a vector at a time
+			//	is examined one code point at a time, a vector's
+			//	worth before trying again
+			auto last=begin+std::min<std::ptrdiff_t>(end-begin,4);
+			for (;begin!=last;++begin) {
+			
+				if (!may_terminate_line(*begin)) continue;
+				
+				switch (locale.GetLineBreak(*begin)) {
+				
+					case LineBreak::BK:
+					case LineBreak::CR:
+					case LineBreak::LF:
+					case LineBreak::NL:
+						return begin;
+					default:
+						break;
+				
+				}
+			
+			}
+			
+			if (begin==end) return end;
+		
+		}
+	
+	}
 
 
 }
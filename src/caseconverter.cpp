@@ -75,6 +75,7 @@ namespace Unicode {
 	
 	
 	Array<CodePoint> CaseConverter::get (
+		const CodePointInfo * cpi,
 		const CodePoint * loc,
 		const CodePoint * begin,
 		const CodePoint * end,
@@ -82,7 +83,6 @@ namespace Unicode {
 		Array<CaseMapping> (CodePointInfo::* full)
 	) const noexcept {
 	
-		auto cpi=loc->GetInfo(locale);
 		if (cpi==nullptr) return Array<CodePoint>(loc,1);
 		
 		if (Full) {
@@ -98,6 +98,19 @@ namespace Unicode {
 	}
 	
 	
+	Array<CodePoint> CaseConverter::get (
+		const CodePoint * loc,
+		const CodePoint * begin,
+		const CodePoint * end,
+		std::optional<CodePoint::Type> (CodePointInfo::* simple),
+		Array<CaseMapping> (CodePointInfo::* full)
+	) const noexcept {
+	
+		return get(loc->GetInfo(locale),loc,begin,end,simple,full);
+	
+	}
+	
+	
 	std::vector<CodePoint> CaseConverter::impl (
 		const CodePoint * begin,
 		const CodePoint * end,
@@ -105,10 +118,25 @@ namespace Unicode {
 		Array<CaseMapping> (CodePointInfo::* full)
 	) const {
 	
+		//	Information is retrieved in batches, which is
+		//	much faster than retrieving it one code point
+		//	at a time
+		constexpr std::size_t batch=256;
+		const CodePointInfo * info [batch];
+		
 		std::vector<CodePoint> retr;
-		for (auto loc=begin;loc!=end;++loc) {
+		retr.reserve(end-begin);
+		for (auto loc=begin;loc!=end;) {
 		
-			for (auto cp : get(loc,begin,end,simple,full)) retr.push_back(cp);
+			std::size_t count=end-loc;
+			if (count>batch) count=batch;
+			
+			locale.GetInfo(loc,loc+count,info);
+			for (std::size_t i=0;i<count;++i,++loc) {
+			
+				for (auto cp : get(info[i],loc,begin,end,simple,full)) retr.push_back(cp);
+			
+			}
 		
 		}
 		
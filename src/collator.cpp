@@ -5,7 +5,6 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <cstring>
 #include <iterator>
 #include <type_traits>
 
@@ -212,6 +211,10 @@ namespace Unicode {
 			
 			
 				const Locale & locale;
+				//	Blocks whose unified ideographs have the
+				//	lowest implicit weights
+				std::uint16_t unified;
+				std::uint16_t compatibility;
 				//	Combining marks that have been removed from
 				//	the stream
 				std::vector<const CodePoint *> removed;
@@ -367,13 +370,13 @@ namespace Unicode {
 				
 					//	Get information on the current code point
 					auto cpi=begin->GetInfo(locale);
-					if ((cpi==nullptr) || !cpi->UnifiedIdeograph) return 0xFBC0;
+					if ((cpi==nullptr) || !cpi->HasAny(BinaryProperty::UnifiedIdeograph)) return 0xFBC0;
 					
 					if (
-						(cpi->Block==nullptr) ||
+						(cpi->Block==0) ||
 						!(
-							(std::strcmp(cpi->Block,"CJK Unified Ideographs")==0) ||
-							(std::strcmp(cpi->Block,"CJK Compatibility Ideographs")==0)
+							(cpi->Block==unified) ||
+							(cpi->Block==compatibility)
 						)
 					) return 0xFB80;
 					
@@ -418,8 +421,16 @@ namespace Unicode {
 			public:
 			
 			
-				CollationElementRetriever (const Locale & locale, const CodePoint * begin, const CodePoint * end) noexcept
+				CollationElementRetriever (
+					const Locale & locale,
+					std::uint16_t unified,
+					std::uint16_t compatibility,
+					const CodePoint * begin,
+					const CodePoint * end
+				) noexcept
 					:	locale(locale),
+						unified(unified),
+						compatibility(compatibility),
 						begin(begin),
 						end(end)
 				{	}
@@ -642,7 +653,7 @@ namespace Unicode {
 	std::vector<CodePoint::Type> Collator::get_sort_key (const CodePoint * begin, const CodePoint * end) const {
 	
 		//	Get the collation elements
-		auto ces=CollationElementRetriever(locale,begin,end).Get();
+		auto ces=CollationElementRetriever(locale,cjk_unified,cjk_compatibility,begin,end).Get();
 		
 		//	Form the sort key
 		
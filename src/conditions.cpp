@@ -16,12 +16,13 @@ namespace Unicode {
 		
 			for (;begin!=end;++begin) {
 			
-				auto cpi=locale.GetInfo(*begin);
-				if (cpi==nullptr) return false;
-				
-				if (cpi->Cased) return true;
+				//	Code points which are neither cased nor
+				//	case-ignorable (including those about which
+				//	there is no information) end the search
+				auto flags=locale.GetBinaryProperties(*begin);
+				if ((flags&(BinaryProperty::Cased|BinaryProperty::CaseIgnorable))==0) return false;
 				
-				if (!cpi->CaseIgnorable) return false;
+				if ((flags&BinaryProperty::Cased)!=0) return true;
 			
 			}
 			
@@ -76,7 +77,7 @@ namespace Unicode {
 				auto cpi=locale.GetInfo(*rbegin);
 				if (cpi==nullptr) return false;
 				
-				if (cpi->SoftDotted) return true;
+				if (cpi->HasAny(BinaryProperty::SoftDotted)) return true;
 				
 				switch (cpi->CanonicalCombiningClass) {
 				
@@ -104,10 +105,7 @@ namespace Unicode {
 			
 			for (++loc;loc!=end;++loc) {
 			
-				auto cpi=locale.GetInfo(*loc);
-				if (cpi==nullptr) return false;
-				
-				switch (cpi->CanonicalCombiningClass) {
+				switch (locale.GetCanonicalCombiningClass(*loc)) {
 				
 					case 0:
 						return false;
@@ -136,10 +134,7 @@ namespace Unicode {
 			
 				if (*loc==0x307) return true;
 				
-				auto cpi=locale.GetInfo(*loc);
-				if (cpi==nullptr) return false;
-				
-				switch (cpi->CanonicalCombiningClass) {
+				switch (locale.GetCanonicalCombiningClass(*loc)) {
 				
 					case 0:
 					case 230:
@@ -171,10 +166,7 @@ namespace Unicode {
 			
 				if (*rbegin=='I') return true;
 				
-				auto cpi=locale.GetInfo(*rbegin);
-				if (cpi==nullptr) return false;
-				
-				switch (cpi->CanonicalCombiningClass) {
+				switch (locale.GetCanonicalCombiningClass(*rbegin)) {
 				
 					case 0:
 					case 230:
@@ -14,6 +14,68 @@ namespace Unicode {
 	}
 	
 	
+	Array<CodePointRecord> DataRecords () noexcept {
+	
+		return MakeArray(info_records);
+	
+	}
+	
+	
+	Array<char> DataNames () noexcept {
+	
+		return MakeArray(names);
+	
+	}
+	
+	
+	Array<const char *> DataBlockNames () noexcept {
+	
+		return MakeArray(blocks);
+	
+	}
+	
+	
+	Array<const char *> DataScriptNames () noexcept {
+	
+		return MakeArray(scripts);
+	
+	}
+	
+	
+	CodePointIndex DataIndex () noexcept {
+	
+		CodePointIndex retr;
+		retr.Blocks=MakeArray(info_blocks);
+		retr.Indices=MakeArray(info_indices);
+		
+		return retr;
+	
+	}
+	
+	
+	Array<const CodePointInfo *> DataLatin1 () noexcept {
+	
+		return MakeArray(info_latin1);
+	
+	}
+	
+	
+	PropertyTables DataProperties () noexcept {
+	
+		PropertyTables retr;
+		retr.CanonicalCombiningClass.Data=MakeArray(packed_ccc);
+		retr.GeneralCategory.Data=MakeArray(packed_gc);
+		retr.GraphemeClusterBreak.Data=MakeArray(packed_gcb);
+		retr.WordBreak.Data=MakeArray(packed_wb);
+		retr.LineBreak.Data=MakeArray(packed_lb);
+		retr.NFCQuickCheck.Data=MakeArray(packed_nfc_qc);
+		retr.NFDQuickCheck.Data=MakeArray(packed_nfd_qc);
+		
+		return retr;
+	
+	}
+	
+	
 	Array<Composition> Compositions () noexcept {
 	
 		return MakeArray(compositions);
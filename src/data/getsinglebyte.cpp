@@ -0,0 +1,35 @@
+#include <unicode/singlebyte.hpp>
+
+
+#include "singlebyte.cpp"
+
+
+namespace Unicode {
+
+
+	const SingleByteTable SingleByte::Windows1250{windows_1250_decode,windows_1250_blocks,windows_1250_encode};
+	const SingleByteTable SingleByte::Windows1251{windows_1251_decode,windows_1251_blocks,windows_1251_encode};
+	const SingleByteTable SingleByte::Windows1252{windows_1252_decode,windows_1252_blocks,windows_1252_encode};
+	const SingleByteTable SingleByte::Windows1253{windows_1253_decode,windows_1253_blocks,windows_1253_encode};
+	const SingleByteTable SingleByte::Windows1254{windows_1254_decode,windows_1254_blocks,windows_1254_encode};
+	const SingleByteTable SingleByte::Windows1255{windows_1255_decode,windows_1255_blocks,windows_1255_encode};
+	const SingleByteTable SingleByte::Windows1256{windows_1256_decode,windows_1256_blocks,windows_1256_encode};
+	const SingleByteTable SingleByte::Windows1257{windows_1257_decode,windows_1257_blocks,windows_1257_encode};
+	const SingleByteTable SingleByte::Windows1258{windows_1258_decode,windows_1258_blocks,windows_1258_encode};
+	const SingleByteTable SingleByte::ISO8859_2{iso_8859_2_decode,iso_8859_2_blocks,iso_8859_2_encode};
+	const SingleByteTable SingleByte::ISO8859_3{iso_8859_3_decode,iso_8859_3_blocks,iso_8859_3_encode};
+	const SingleByteTable SingleByte::ISO8859_4{iso_8859_4_decode,iso_8859_4_blocks,iso_8859_4_encode};
+	const SingleByteTable SingleByte::ISO8859_5{iso_8859_5_decode,iso_8859_5_blocks,iso_8859_5_encode};
+	const SingleByteTable SingleByte::ISO8859_6{iso_8859_6_decode,iso_8859_6_blocks,iso_8859_6_encode};
+	const SingleByteTable SingleByte::ISO8859_7{iso_8859_7_decode,iso_8859_7_blocks,iso_8859_7_encode};
+	const SingleByteTable SingleByte::ISO8859_8{iso_8859_8_decode,iso_8859_8_blocks,iso_8859_8_encode};
+	const SingleByteTable SingleByte::ISO8859_9{iso_8859_9_decode,iso_8859_9_blocks,iso_8859_9_encode};
+	const SingleByteTable SingleByte::ISO8859_10{iso_8859_10_decode,iso_8859_10_blocks,iso_8859_10_encode};
+	const SingleByteTable SingleByte::ISO8859_11{iso_8859_11_decode,iso_8859_11_blocks,iso_8859_11_encode};
+	const SingleByteTable SingleByte::ISO8859_13{iso_8859_13_decode,iso_8859_13_blocks,iso_8859_13_encode};
+	const SingleByteTable SingleByte::ISO8859_14{iso_8859_14_decode,iso_8859_14_blocks,iso_8859_14_encode};
+	const SingleByteTable SingleByte::ISO8859_15{iso_8859_15_decode,iso_8859_15_blocks,iso_8859_15_encode};
+	const SingleByteTable SingleByte::ISO8859_16{iso_8859_16_decode,iso_8859_16_blocks,iso_8859_16_encode};
+
+
+}
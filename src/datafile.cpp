@@ -0,0 +1,245 @@
+#include <unicode/datafile.hpp>
+#include "mappedfile.hpp"
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+
+namespace Unicode {
+
+
+	[[noreturn]]
+	static void corrupt () {
+	
+		throw std::runtime_error("Data file corrupt");
+	
+	}
+	
+	
+	//	Retrieves a table from a mapped file, checking
+	//	that it lies entirely within the file and is
+	//	aligned for its elements
+	template <typename T>
+	static Array<T> table (const RelativeArray<T> & arr, const void * data, std::size_t size) {
+	
+		if (arr.Size==0) return Array<T>{};
+		
+		auto begin=reinterpret_cast<std::uintptr_t>(&arr)+static_cast<std::uintptr_t>(arr.Offset);
+		auto base=reinterpret_cast<std::uintptr_t>(data);
+		if (
+			(begin<base) ||
+			((begin-base)>size) ||
+			((begin%alignof(T))!=0) ||
+			(arr.Size>((size-(begin-base))/sizeof(T)))
+		) corrupt();
+		
+		return Array<T>(reinterpret_cast<const T *>(begin),static_cast<std::size_t>(arr.Size));
+	
+	}
+	
+	
+	//	Resolves an array within an element of a table,
+	//	whose Data is an index into a pool
+	template <typename T>
+	static Array<T> resolve (const Array<T> & arr, const T * pool, std::size_t size) {
+	
+		if (arr.Size==0) return Array<T>{};
+		
+		auto index=reinterpret_cast<std::uintptr_t>(arr.Data);
+		if ((index>size) || (arr.Size>(size-index))) corrupt();
+		
+		return Array<T>(pool+index,arr.Size);
+	
+	}
+	
+	
+	template <typename T>
+	static Array<T> resolve (const Array<T> & arr, const std::vector<T> & pool) {
+	
+		return resolve(arr,pool.data(),pool.size());
+	
+	}
+	
+	
+	template <typename T>
+	static Array<T> resolve (const Array<T> & arr, const Array<T> & pool) {
+	
+		return resolve(arr,pool.Data,pool.Size);
+	
+	}
+	
+	
+	//	Resolves a string, which is stored as one more
+	//	than its offset into the pool of strings
+	static const char * resolve (std::uint64_t offset, const Array<char> & strings) {
+	
+		if (offset==0) return nullptr;
+		if (offset>strings.Size) corrupt();
+		
+		return strings.Data+(offset-1);
+	
+	}
+	
+	
+	static const char * resolve (const char * str, const Array<char> & strings) {
+	
+		return resolve(reinterpret_cast<std::uintptr_t>(str),strings);
+	
+	}
+	
+	
+	template <typename T>
+	static std::vector<T> copy (const Array<T> & arr) {
+	
+		return std::vector<T>(arr.begin(),arr.end());
+	
+	}
+	
+	
+	//	Packed tables must cover the second stage of
+	//	the index they are parallel to
+	template <std::size_t Bits>
+	static void packed (PackedArray<Bits> & arr, const RelativeArray<std::uint8_t> & data, const CodePointIndex & index, const void * file, std::size_t size) {
+	
+		arr.Data=table(data,file,size);
+		
+		if (!(arr.IsEmpty() || (arr.Data.Size>=((index.Indices.Size+PackedArray<Bits>::PerByte-1)/PackedArray<Bits>::PerByte)))) corrupt();
+	
+	}
+	
+	
+	DataFile::DataFile (const char * filename) : file(new MappedFile(filename)), version(""), Locale(DefaultLocale) {
+	
+		auto data=file->begin();
+		auto size=file->Size();
+		if (size<sizeof(DataFileHeader)) corrupt();
+		
+		auto & h=*reinterpret_cast<const DataFileHeader *>(data);
+		if (std::memcmp(h.Magic,DataFileHeader::Identifier,sizeof(h.Magic))!=0) throw std::runtime_error("Not a data file");
+		if (h.Format!=FormatVersion) throw std::runtime_error("Unsupported data file format version");
+		if (std::memcmp(h.Layout,DataFileHeader::Representation,sizeof(h.Layout))!=0) throw std::runtime_error("Data file written by an incompatible build");
+		if (h.Size!=size) corrupt();
+		
+		//	Pools which contain no pointers are used in
+		//	place
+		auto strings=table(h.Strings,data,size);
+		if ((strings.Size!=0) && (strings[strings.Size-1]!='\0')) corrupt();
+		auto codepoints=table(h.CodePoints,data,size);
+		auto weights=table(h.Weights,data,size);
+		auto v=resolve(h.Version,strings);
+		if (v!=nullptr) version=v;
+		
+		//	Everything which contains pointers is copied
+		//	once, and every reference within it is checked
+		//	as it is resolved, so that nothing loaded from
+		//	the file is trusted
+		conditions=copy(table(h.Conditions,data,size));
+		for (auto & c : conditions) c.cond=resolve(c.cond,strings);
+		mappings=copy(table(h.CaseMappings,data,size));
+		for (auto & m : mappings) {
+		
+			m.Conditions=resolve(m.Conditions,conditions);
+			m.Mapping=resolve(m.Mapping,codepoints);
+		
+		}
+		for (auto offset : table(h.BlockNames,data,size)) blocks.push_back(resolve(offset,strings));
+		for (auto offset : table(h.ScriptNames,data,size)) scripts.push_back(resolve(offset,strings));
+		//	Only the first name may be null, searches by
+		//	name skip it
+		for (std::size_t i=1;i<blocks.size();++i) if (blocks[i]==nullptr) corrupt();
+		for (std::size_t i=1;i<scripts.size();++i) if (scripts[i]==nullptr) corrupt();
+		info=copy(table(h.Info,data,size));
+		for (auto & i : info) {
+		
+			if (
+				((i.Block!=0) && (i.Block>=blocks.size())) ||
+				((i.Script!=0) && (i.Script>=scripts.size()))
+			) corrupt();
+			i.Alias=resolve(i.Alias,strings);
+			i.Abbreviation=resolve(i.Abbreviation,strings);
+			i.LowercaseMappings=resolve(i.LowercaseMappings,mappings);
+			i.TitlecaseMappings=resolve(i.TitlecaseMappings,mappings);
+			i.UppercaseMappings=resolve(i.UppercaseMappings,mappings);
+			i.CaseFoldings=resolve(i.CaseFoldings,mappings);
+			i.DecompositionMapping=resolve(i.DecompositionMapping,codepoints);
+		
+		}
+		compositions=copy(table(h.Compositions,data,size));
+		for (auto & c : compositions) c.CodePoints=resolve(c.CodePoints,codepoints);
+		elements=copy(table(h.CollationElements,data,size));
+		for (auto & e : elements) e.Weights=resolve(e.Weights,weights);
+		collation=copy(table(h.CollationTable,data,size));
+		for (auto & e : collation) {
+		
+			e.CodePoints=resolve(e.CodePoints,codepoints);
+			e.CollationElements=resolve(e.CollationElements,elements);
+		
+		}
+		
+		//	Records must be ordered and must not overlap,
+		//	since they are searched
+		auto records=table(h.Records,data,size);
+		auto names=table(h.Names,data,size);
+		if ((names.Size!=0) && (names[names.Size-1]!='\0')) corrupt();
+		for (std::size_t i=0;i<records.Size;++i) {
+		
+			auto & r=records[i];
+			if (
+				(r.CodePoint>r.Last) ||
+				(r.Last>CodePoint::Max) ||
+				((i!=0) && (r.CodePoint<=records[i-1].Last)) ||
+				(r.Info>=info.size()) ||
+				(r.Name>=names.Size)
+			) corrupt();
+		
+		}
+		
+		//	Every block of the index must lie within the
+		//	second stage, and every entry of the second
+		//	stage must refer to a code point
+		CodePointIndex index;
+		index.Blocks=table(h.Blocks,data,size);
+		index.Indices=table(h.Indices,data,size);
+		for (auto b : index.Blocks) if (((static_cast<std::size_t>(b)+1)<<CodePointIndex::Shift)>index.Indices.Size) corrupt();
+		for (auto i : index.Indices) if ((i!=CodePointIndex::None) && (i>=info.size())) corrupt();
+		
+		auto & p=Locale.Properties;
+		packed(p.CanonicalCombiningClass,h.CanonicalCombiningClass,index,data,size);
+		packed(p.GeneralCategory,h.GeneralCategory,index,data,size);
+		packed(p.GraphemeClusterBreak,h.GraphemeClusterBreak,index,data,size);
+		packed(p.WordBreak,h.WordBreak,index,data,size);
+		packed(p.LineBreak,h.LineBreak,index,data,size);
+		packed(p.NFCQuickCheck,h.NFCQuickCheck,index,data,size);
+		packed(p.NFDQuickCheck,h.NFDQuickCheck,index,data,size);
+		
+		Locale.Info=Array<CodePointInfo>(info.data(),info.size());
+		Locale.Records=records;
+		Locale.Names=names;
+		Locale.BlockNames=Array<const char *>(blocks.data(),blocks.size());
+		Locale.ScriptNames=Array<const char *>(scripts.data(),scripts.size());
+		Locale.InfoIndex=index;
+		Locale.Compositions=Array<Composition>(compositions.data(),compositions.size());
+		Locale.CollationTable=Array<CollationTableEntry>(collation.data(),collation.size());
+		
+		//	Pointers cannot be stored in the file, so the
+		//	table for the Latin-1 range is built from the
+		//	index
+		Locale.Latin1Info=decltype(Locale.Latin1Info){};
+		for (CodePoint::Type cp=0;cp<(sizeof(latin1)/sizeof(*latin1));++cp) latin1[cp]=Locale.GetInfo(cp);
+		Locale.Latin1Info=MakeArray(latin1);
+	
+	}
+	
+	
+	DataFile::~DataFile () noexcept {	}
+	
+	
+	const char * DataFile::Version () const noexcept {
+	
+		return version;
+	
+	}
+
+
+}
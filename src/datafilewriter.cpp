@@ -0,0 +1,351 @@
+#include <unicode/datafile.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+namespace Unicode {
+
+
+	const char DataFileHeader::Identifier []="UNICODE";
+	
+	
+	const std::uint32_t DataFileHeader::Representation []={
+		0x01020304U,
+		sizeof(void *),
+		sizeof(CodePointInfo),
+		sizeof(CodePointRecord),
+		sizeof(CaseMapping),
+		sizeof(Condition),
+		sizeof(Composition),
+		sizeof(CollationTableEntry),
+		sizeof(CollationElement)
+	};
+	
+	
+	//	Everything is aligned to this boundary
+	static const std::size_t alignment=8;
+	
+	
+	static std::size_t align (std::size_t offset, std::size_t boundary) noexcept {
+	
+		return (offset+boundary-1)&~(boundary-1);
+	
+	}
+	
+	
+	static_assert(
+		std::is_standard_layout<DataFileHeader>::value &&
+		std::is_trivially_copyable<DataFileHeader>::value &&
+		std::is_trivially_copyable<CodePointInfo>::value &&
+		std::is_trivially_copyable<CodePointRecord>::value &&
+		std::is_trivially_copyable<CaseMapping>::value &&
+		std::is_trivially_copyable<Condition>::value &&
+		std::is_trivially_copyable<Composition>::value &&
+		std::is_trivially_copyable<CollationTableEntry>::value &&
+		std::is_trivially_copyable<CollationElement>::value,
+		"Structures in data files must be trivially copyable"
+	);
+	
+	
+	//	Lays out the tables of a locale
+	//
+	//	The contents of arrays and strings within the
+	//	elements of tables are gathered into pools, and
+	//	the arrays and strings are replaced by indices
+	//	into those pools (see DataFileHeader), so the file
+	//	contains no addresses.  Identical arrays and
+	//	strings are only pooled once.
+	class DataFile::writer {
+	
+	
+		private:
+		
+		
+			template <typename T>
+			class pool {
+			
+			
+				public:
+				
+				
+					std::vector<T> Elements;
+					std::map<std::pair<const void *,std::size_t>,std::size_t> Indices;
+			
+			
+			};
+			
+			
+			std::vector<unsigned char> bytes;
+			std::vector<char> strings;
+			std::unordered_map<std::string,std::uint64_t> offsets;
+			pool<CodePoint::Type> codepoints;
+			pool<std::uint16_t> weights;
+			pool<Condition> conditions;
+			pool<CaseMapping> mappings;
+			pool<CollationElement> elements;
+			
+			
+			//	Adds the elements of an array to a pool, each
+			//	passed through a callback which replaces the
+			//	arrays and strings within it, and returns an
+			//	array whose Data is the index of the first
+			template <typename T, typename F>
+			static Array<T> add (pool<T> & p, const Array<T> & arr, F && callback) {
+			
+				if (arr.Size==0) return Array<T>{};
+				
+				auto key=std::make_pair(static_cast<const void *>(arr.Data),arr.Size);
+				auto iter=p.Indices.find(key);
+				if (iter!=p.Indices.end()) return Array<T>(reinterpret_cast<const T *>(iter->second),arr.Size);
+				
+				auto retr=p.Elements.size();
+				p.Indices.emplace(key,retr);
+				for (auto & e : arr) p.Elements.push_back(callback(e));
+				
+				return Array<T>(reinterpret_cast<const T *>(retr),arr.Size);
+			
+			}
+			
+			
+			template <typename T>
+			static Array<T> add (pool<T> & p, const Array<T> & arr) {
+			
+				return add(p,arr,[] (const T & e) {	return e;	});
+			
+			}
+			
+			
+			const char * string (const char * str) {
+			
+				return reinterpret_cast<const char *>(static_cast<std::uintptr_t>(String(str)));
+			
+			}
+			
+			
+			Array<CaseMapping> caseMappings (const Array<CaseMapping> & arr) {
+			
+				return add(mappings,arr,[&] (CaseMapping m) {
+				
+					m.Conditions=add(conditions,m.Conditions,[&] (Condition c) {
+					
+						c.cond=string(c.cond);
+						
+						return c;
+					
+					});
+					m.Mapping=add(codepoints,m.Mapping);
+					
+					return m;
+				
+				});
+			
+			}
+		
+		
+		public:
+		
+		
+			writer () : bytes(sizeof(DataFileHeader),0) {	}
+			
+			
+			//	Retrieves one more than the offset of a string
+			//	in the pool of strings, or zero for null
+			std::uint64_t String (const char * str) {
+			
+				if (str==nullptr) return 0;
+				
+				std::string s(str);
+				auto iter=offsets.find(s);
+				if (iter!=offsets.end()) return iter->second;
+				
+				auto retr=static_cast<std::uint64_t>(strings.size()+1);
+				strings.insert(strings.end(),s.c_str(),s.c_str()+s.size()+1);
+				offsets.emplace(std::move(s),retr);
+				
+				return retr;
+			
+			}
+			
+			
+			std::vector<std::uint64_t> Strings (const Array<const char *> & arr) {
+			
+				std::vector<std::uint64_t> retr;
+				for (auto str : arr) retr.push_back(String(str));
+				
+				return retr;
+			
+			}
+			
+			
+			std::vector<CodePointInfo> Info (const Array<CodePointInfo> & arr) {
+			
+				std::vector<CodePointInfo> retr;
+				for (auto i : arr) {
+				
+					i.Alias=string(i.Alias);
+					i.Abbreviation=string(i.Abbreviation);
+					i.LowercaseMappings=caseMappings(i.LowercaseMappings);
+					i.TitlecaseMappings=caseMappings(i.TitlecaseMappings);
+					i.UppercaseMappings=caseMappings(i.UppercaseMappings);
+					i.CaseFoldings=caseMappings(i.CaseFoldings);
+					i.DecompositionMapping=add(codepoints,i.DecompositionMapping);
+					retr.push_back(i);
+				
+				}
+				
+				return retr;
+			
+			}
+			
+			
+			std::vector<Composition> Compositions (const Array<Composition> & arr) {
+			
+				std::vector<Composition> retr;
+				for (auto c : arr) {
+				
+					c.CodePoints=add(codepoints,c.CodePoints);
+					retr.push_back(c);
+				
+				}
+				
+				return retr;
+			
+			}
+			
+			
+			std::vector<CollationTableEntry> CollationTable (const Array<CollationTableEntry> & arr) {
+			
+				std::vector<CollationTableEntry> retr;
+				for (auto e : arr) {
+				
+					e.CodePoints=add(codepoints,e.CodePoints);
+					e.CollationElements=add(elements,e.CollationElements,[&] (CollationElement c) {
+					
+						c.Weights=add(weights,c.Weights);
+						
+						return c;
+					
+					});
+					retr.push_back(e);
+				
+				}
+				
+				return retr;
+			
+			}
+			
+			
+			//	Writes a table and makes a member of the header
+			//	refer to it
+			template <typename T>
+			void Table (const DataFileHeader & h, RelativeArray<T> & member, const T * data, std::size_t size) {
+			
+				member=RelativeArray<T>{};
+				if (size==0) return;
+				
+				auto loc=align(bytes.size(),alignment);
+				bytes.resize(loc+(size*sizeof(T)),0);
+				std::memcpy(bytes.data()+loc,data,size*sizeof(T));
+				
+				auto offset=reinterpret_cast<const unsigned char *>(&member)-reinterpret_cast<const unsigned char *>(&h);
+				member.Offset=static_cast<std::int64_t>(loc)-static_cast<std::int64_t>(offset);
+				member.Size=size;
+			
+			}
+			
+			
+			template <typename T>
+			void Table (const DataFileHeader & h, RelativeArray<T> & member, const Array<T> & arr) {
+			
+				Table(h,member,arr.Data,arr.Size);
+			
+			}
+			
+			
+			template <typename T>
+			void Table (const DataFileHeader & h, RelativeArray<T> & member, const std::vector<T> & vec) {
+			
+				Table(h,member,vec.data(),vec.size());
+			
+			}
+			
+			
+			//	Writes the pools, which must follow every table
+			//	which refers to them
+			void Pools (DataFileHeader & h) {
+			
+				Table(h,h.Strings,strings);
+				Table(h,h.CodePoints,codepoints.Elements);
+				Table(h,h.Weights,weights.Elements);
+				Table(h,h.Conditions,conditions.Elements);
+				Table(h,h.CaseMappings,mappings.Elements);
+				Table(h,h.CollationElements,elements.Elements);
+			
+			}
+			
+			
+			//	The header is written last, once the size of
+			//	the file is known
+			std::vector<unsigned char> Get (DataFileHeader & h) {
+			
+				if (bytes.size()>0xFFFFFFFFU) throw std::length_error("Data file too large");
+				
+				h.Size=bytes.size();
+				std::memcpy(bytes.data(),&h,sizeof(h));
+				
+				return std::move(bytes);
+			
+			}
+	
+	
+	};
+	
+	
+	void DataFile::Write (const Unicode::Locale & locale, const char * filename, const char * version) {
+	
+		writer w;
+		
+		DataFileHeader h{};
+		std::memcpy(h.Magic,DataFileHeader::Identifier,sizeof(h.Magic));
+		h.Format=FormatVersion;
+		std::memcpy(h.Layout,DataFileHeader::Representation,sizeof(h.Layout));
+		h.Version=w.String((version==nullptr) ? "" : version);
+		
+		w.Table(h,h.Info,w.Info(locale.Info));
+		w.Table(h,h.Records,locale.Records);
+		w.Table(h,h.Names,locale.Names);
+		w.Table(h,h.BlockNames,w.Strings(locale.BlockNames));
+		w.Table(h,h.ScriptNames,w.Strings(locale.ScriptNames));
+		w.Table(h,h.Blocks,locale.InfoIndex.Blocks);
+		w.Table(h,h.Indices,locale.InfoIndex.Indices);
+		auto & p=locale.Properties;
+		w.Table(h,h.CanonicalCombiningClass,p.CanonicalCombiningClass.Data);
+		w.Table(h,h.GeneralCategory,p.GeneralCategory.Data);
+		w.Table(h,h.GraphemeClusterBreak,p.GraphemeClusterBreak.Data);
+		w.Table(h,h.WordBreak,p.WordBreak.Data);
+		w.Table(h,h.LineBreak,p.LineBreak.Data);
+		w.Table(h,h.NFCQuickCheck,p.NFCQuickCheck.Data);
+		w.Table(h,h.NFDQuickCheck,p.NFDQuickCheck.Data);
+		w.Table(h,h.Compositions,w.Compositions(locale.Compositions));
+		w.Table(h,h.CollationTable,w.CollationTable(locale.CollationTable));
+		w.Pools(h);
+		
+		auto bytes=w.Get(h);
+		
+		std::ofstream file(filename,std::ios::out|std::ios::binary|std::ios::trunc);
+		file.write(reinterpret_cast<const char *>(bytes.data()),static_cast<std::streamsize>(bytes.size()));
+		file.close();
+		if (file.fail()) throw std::runtime_error("Error while writing data file");
+	
+	}
+
+
+}
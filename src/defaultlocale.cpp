@@ -31,6 +31,13 @@ namespace Unicode {
 		
 		Locale retr;
 		retr.Info=Data();
+		retr.Records=DataRecords();
+		retr.Names=DataNames();
+		retr.BlockNames=DataBlockNames();
+		retr.ScriptNames=DataScriptNames();
+		retr.InfoIndex=DataIndex();
+		retr.Latin1Info=DataLatin1();
+		retr.Properties=DataProperties();
 		retr.Compositions=Compositions();
 		retr.CollationTable=CollationTable();
 		retr.Digits=decltype(retr.Digits)(digit_map);
@@ -0,0 +1,298 @@
+#include <unicode/detectencoding.hpp>
+#include <unicode/ascii.hpp>
+#include <unicode/latin1.hpp>
+#include <unicode/utf8.hpp>
+#include <unicode/utf16.hpp>
+#include <unicode/utf32.hpp>
+#include "simd.hpp"
+#include <cstddef>
+#include <utility>
+
+
+namespace Unicode {
+
+
+	namespace {
+	
+	
+		//	What's learned from a single pass over the bytes
+		class statistics {
+		
+		
+			public:
+			
+			
+				//	The number of null bytes at each position
+				//	modulo four
+				std::size_t Nulls [4];
+				//	The number of bytes which aren't ASCII
+				std::size_t High;
+				//	The number of bytes which may begin multi-byte
+				//	UTF-8 sequences
+				std::size_t Leads;
+		
+		
+		};
+	
+	
+	}
+	
+	
+	static void count (statistics & s, const unsigned char * begin, const unsigned char * end, std::size_t offset) noexcept {
+	
+		for (;begin!=end;++begin,++offset) {
+		
+			if (*begin==0) ++s.Nulls[offset%4];
+			if (*begin>=0x80) ++s.High;
+			if (*begin>=0xC0) ++s.Leads;
+		
+		}
+	
+	}
+	
+	
+	#ifdef UNICODE_SSE2
+	static std::size_t sum (__m128i v) noexcept {
+	
+		auto s=_mm_sad_epu8(v,_mm_setzero_si128());
+		
+		return static_cast<std::size_t>(_mm_cvtsi128_si32(s))+static_cast<std::size_t>(_mm_cvtsi128_si32(_mm_srli_si128(s,8)));
+	
+	}
+	#endif
+	
+	
+	static statistics get_statistics (const unsigned char * begin, const unsigned char * end) noexcept {
+	
+		statistics retr{{0,0,0,0},0,0};
+		auto start=begin;
+		
+		#ifdef UNICODE_SSE2
+		//	Sixteen bytes are classified at once, and each
+		//	lane counts the bytes of its class which it's
+		//	seen.  Since sixteen is a multiple of four each
+		//	lane always sees bytes at the same position modulo
+		//	four.
+		auto zero=_mm_setzero_si128();
+		auto continuation=_mm_set1_epi8(static_cast<char>(0xBF));
+		while ((end-begin)>=16) {
+		
+			//	The counts must be collected before they
+			//	overflow a byte
+			auto nulls=zero;
+			auto high=zero;
+			auto leads=zero;
+			for (std::size_t i=0;(i<255) && ((end-begin)>=16);++i,begin+=16) {
+			
+				auto v=_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+				nulls=_mm_sub_epi8(nulls,_mm_cmpeq_epi8(v,zero));
+				auto h=_mm_cmplt_epi8(v,zero);
+				high=_mm_sub_epi8(high,h);
+				//	As signed integers bytes which begin multi-byte
+				//	UTF-8 sequences are negative and greater than
+				//	continuation bytes
+				leads=_mm_sub_epi8(leads,_mm_and_si128(h,_mm_cmpgt_epi8(v,continuation)));
+			
+			}
+			
+			unsigned char n [16];
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(n),nulls);
+			for (std::size_t i=0;i<16;++i) retr.Nulls[i%4]+=n[i];
+			retr.High+=sum(high);
+			retr.Leads+=sum(leads);
+		
+		}
+		#endif
+		
+		count(retr,begin,end,static_cast<std::size_t>(begin-start));
+		
+		return retr;
+	
+	}
+	
+	
+	//	Determines whether the bytes examined are valid in
+	//	a certain encoding, a sequence cut short by the end
+	//	of the bytes examined isn't an error since the
+	//	rest of it may follow
+	static bool is_valid (const Encoding & encoding, const unsigned char * begin, const unsigned char * end) {
+	
+		auto error=encoding.Measure(begin,end).Error;
+		
+		return !error || (error->Type==EncodingErrorType::UnexpectedEnd);
+	
+	}
+	
+	
+	static DetectedEncoding make (std::unique_ptr<Encoding> encoding, double confidence) noexcept {
+	
+		DetectedEncoding retr;
+		retr.Encoding=std::move(encoding);
+		retr.Confidence=confidence;
+		
+		return retr;
+	
+	}
+	
+	
+	//	Detects UTF-8, UTF-16, and UTF-32 from a byte
+	//	order mark
+	static std::unique_ptr<Encoding> detect_bom (const unsigned char * begin, const unsigned char * end) {
+	
+		//	The little endian UTF-32 byte order mark begins
+		//	with the little endian UTF-16 byte order mark, so
+		//	UTF-32 must be checked first
+		std::unique_ptr<Encoding> retr(new UTF32());
+		if (auto order=retr->BOM().Detect(begin,end)) {
+		
+			retr.reset(new UTF32(*order,*order));
+			
+			return retr;
+		
+		}
+		
+		retr.reset(new UTF16());
+		if (auto order=retr->BOM().Detect(begin,end)) {
+		
+			retr.reset(new UTF16(*order,*order));
+			
+			return retr;
+		
+		}
+		
+		//	The UTF-8 byte order mark has no byte order, so
+		//	only one form of it is accepted
+		retr.reset(new UTF8());
+		if (retr->BOM().Detect(begin,end)==Endianness::Big) {
+		
+			retr->OutputBOM=true;
+			retr->DetectBOM=true;
+			
+			return retr;
+		
+		}
+		
+		return nullptr;
+	
+	}
+	
+	
+	//	Creates an encoding of a certain type with a
+	//	certain byte order, which neither outputs nor
+	//	expects a byte order mark
+	template <typename T>
+	static std::unique_ptr<Encoding> make_endian (Endianness order) {
+	
+		std::unique_ptr<Encoding> retr(new T(order,order));
+		retr->OutputBOM=false;
+		retr->DetectBOM=false;
+		
+		return retr;
+	
+	}
+	
+	
+	DetectedEncoding DetectEncoding (const void * begin, const void * end, std::size_t max) {
+	
+		auto b=reinterpret_cast<const unsigned char *>(begin);
+		auto e=reinterpret_cast<const unsigned char *>(end);
+		auto whole=static_cast<std::size_t>(e-b)<=max;
+		if (!whole) e=b+max;
+		
+		if (auto bom=detect_bom(b,e)) return make(std::move(bom),1);
+		
+		auto s=get_statistics(b,e);
+		auto size=static_cast<std::size_t>(e-b);
+		
+		//	Text in UTF-32 has a null byte in its most
+		//	significant byte, and in the next most significant
+		//	byte for everything in the Basic Multilingual
+		//	Plane.  UTF-16 has a null byte in its most significant
+		//	byte for all of ASCII and Latin-1.  Since the most
+		//	significant bytes of UTF-32 coincide with those of
+		//	UTF-16 half the time, UTF-32 is checked first.
+		auto groups=size/4;
+		if (groups!=0) {
+		
+			const std::pair<Endianness,std::size_t> utf32 []={
+				{Endianness::Little,3},
+				{Endianness::Big,0}
+			};
+			for (auto & p : utf32) {
+			
+				//	The next most significant byte is to the
+				//	right of the most significant byte for
+				//	little endian, and to the left for big
+				auto high=s.Nulls[p.second];
+				auto next=s.Nulls[(p.first==Endianness::Little) ? 2 : 1];
+				if ((high!=groups) || ((next*2)<groups)) continue;
+				
+				auto encoding=make_endian<UTF32>(p.first);
+				if (is_valid(*encoding,b,e)) return make(
+					std::move(encoding),
+					static_cast<double>(next)/static_cast<double>(groups)
+				);
+			
+			}
+		
+		}
+		
+		auto units=size/2;
+		if (units!=0) {
+		
+			auto odd=s.Nulls[1]+s.Nulls[3];
+			auto even=s.Nulls[0]+s.Nulls[2];
+			const std::pair<Endianness,std::size_t> utf16 []={
+				{Endianness::Little,odd},
+				{Endianness::Big,even}
+			};
+			for (auto & p : utf16) {
+			
+				//	At least a quarter of code units must have a
+				//	null most significant byte, and their least
+				//	significant bytes must rarely be null
+				auto other=odd+even-p.second;
+				if (((p.second*4)<units) || (p.second<(other*4))) continue;
+				
+				auto encoding=make_endian<UTF16>(p.first);
+				if (is_valid(*encoding,b,e)) return make(
+					std::move(encoding),
+					static_cast<double>(p.second)/static_cast<double>(units)
+				);
+			
+			}
+		
+		}
+		
+		if (s.High==0) {
+		
+			//	If only part of the bytes were examined the
+			//	rest may not be ASCII, UTF-8 can decode ASCII
+			//	and is the most likely encoding of whatever
+			//	else follows
+			if (!whole) return make(std::unique_ptr<Encoding>(new UTF8()),0.5);
+			
+			return make(std::unique_ptr<Encoding>(new ASCII()),1);
+		
+		}
+		
+		//	Bytes outside ASCII are rarely valid UTF-8 by
+		//	accident, and each multi-byte sequence makes it
+		//	less likely
+		std::unique_ptr<Encoding> utf8(new UTF8());
+		if (is_valid(*utf8,b,e)) {
+		
+			return make(
+				std::move(utf8),
+				1-(1/static_cast<double>(s.Leads+1))
+			);
+		
+		}
+		
+		//	Anything at all is valid Latin-1
+		return make(std::unique_ptr<Encoding>(new Latin1()),0.25);
+	
+	}
+
+
+}
@@ -1,5 +1,8 @@
 #include <unicode/encoding.hpp>
 #include <unicode/vector.hpp>
+#include <algorithm>
+#include <exception>
+#include <thread>
 
 
 namespace Unicode {
@@ -26,6 +29,17 @@ namespace Unicode {
 	}
 
 
+	std::optional<CodePoint> Encoding::execute (const EncodingAction & action, EncodingErrorType type, const void * where, CodePoint fallback) const {
+	
+		if (Sink==nullptr) return action.Execute(where);
+		
+		Sink->Report(type,where);
+		
+		return action.Replacement(fallback);
+	
+	}
+	
+	
 	std::optional<CodePoint> Encoding::check (const CodePoint & cp) const {
 	
 		CodePoint retr=cp;
@@ -35,7 +49,7 @@ namespace Unicode {
 		//	Unicode strict errors being ignored?
 		if (!(retr.IsValid() || UnicodeStrict.Ignored())) {
 		
-			auto repl=UnicodeStrict.Execute(loc);
+			auto repl=execute(UnicodeStrict,EncodingErrorType::UnicodeStrict,loc,0xFFFD);
 			
 			if (!repl) return std::nullopt;
 			
@@ -54,13 +68,26 @@ namespace Unicode {
 			
 			//	Lossy errors not ignored -- handle it
 			
-			auto repl=Lossy.Execute(loc);
+			auto repl=execute(
+				Lossy,
+				EncodingErrorType::Lossy,
+				loc,
+				CanRepresent(0xFFFD) ? 0xFFFD : '?'
+			);
 			
 			if (!repl) return std::nullopt;
 			
 			//	Can the replacement be represented?
-			//	If not, WE MUST THROW
-			if (!CanRepresent(*repl)) Lossy.Throw(loc);
+			//	If not, WE MUST THROW, unless errors are
+			//	being reported, in which case the code point
+			//	is deleted from the stream
+			if (!CanRepresent(*repl)) {
+			
+				if (Sink!=nullptr) return std::nullopt;
+				
+				Lossy.Throw(loc);
+			
+			}
 			
 			retr=*repl;
 		
@@ -74,104 +101,73 @@ namespace Unicode {
 	std::optional<CodePoint> Encoding::handle (EncodingErrorType type, const void * where) const {
 	
 		//	Endianness errors are irrecoverable
-		if (type==EncodingErrorType::Endianness) Endianness.Throw(where);
+		if (type==EncodingErrorType::Endianness) {
+		
+			if (Sink!=nullptr) Sink->Report(type,where);
+			
+			Endianness.Throw(where);
+		
+		}
 	
 		auto & action=get(type);
 		
 		if (action.Ignored()) return std::nullopt;
 		
-		return action.Execute(where);
-	
-	}
-
-
-	void Encoding::GetBOM (std::vector<unsigned char> & buffer) const {
-	
-		BOM().Get(buffer);
-	
-	}
-	
-	
-	std::optional<Endianness> Encoding::GetBOM (const unsigned char * & begin, const unsigned char * end) const {
-	
-		const void * b=begin;
-		auto retr=BOM().Detect(b,end);
-		begin=reinterpret_cast<const unsigned char *>(b);
-		
-		return retr;
+		return execute(action,type,where,0xFFFD);
 	
 	}
-
-
-	Encoding::Encoding (bool output_bom, bool detect_bom) noexcept
-		:	UnicodeStrict(EncodingErrorType::UnicodeStrict),
-			Strict(EncodingErrorType::Strict),
-			Lossy(EncodingErrorType::Lossy),
-			UnexpectedEnd(EncodingErrorType::UnexpectedEnd),
-			Endianness(EncodingErrorType::Endianness),
-			OutputBOM(output_bom),
-			DetectBOM(detect_bom)
-	{	}
-	
-	
-	Encoding::~Encoding () noexcept {	}
 	
 	
-	std::vector<unsigned char> Encoding::Encode (const CodePoint * begin, const CodePoint * end) const {
+	std::size_t Encoding::encode (const CodePoint * begin, const CodePoint * end, bool bom, unsigned char * (* get) (void *, std::size_t), void * ptr) const {
 	
-		std::vector<unsigned char> retr;
+		std::size_t retr=0;
 		
-		if (OutputBOM) GetBOM(retr);
+		//	The BOM and code points which must be checked
+		//	are encoded into this buffer first, it never
+		//	allocates unless it's used
+		std::vector<unsigned char> buffer;
+		auto flush=[&] () {
 		
-		for (;begin!=end;++begin) {
-		
-			auto cp=check(*begin);
-			if (!cp) continue;
+			auto out=get(ptr,buffer.size());
+			if (out!=nullptr) std::copy(buffer.begin(),buffer.end(),out);
 			
-			Encoder(retr,*cp);
+			retr+=buffer.size();
+			buffer.clear();
 		
-		}
+		};
 		
-		return retr;
-	
-	}
-	
-	
-	std::vector<unsigned char> Encoding::Encode (const std::vector<CodePoint> & vec) const {
-	
-		return Encode(Begin(vec),End(vec));
-	
-	}
-	
-	
-	std::vector<unsigned char> Encoding::Encode (const String & str) const {
-	
-		return Encode(str.CodePoints());
-	
-	}
-	
-	
-	std::vector<CodePoint> Encoding::Decode (const void * begin, const void * end) const {
-	
-		//	Detect order (if applicable)
-		std::optional<Unicode::Endianness> order;
-		auto b=reinterpret_cast<const unsigned char *>(begin);
-		if (DetectBOM) order=GetBOM(
-			b,
-			reinterpret_cast<const unsigned char *>(end)
-		);
-		begin=b;
+		if (bom) {
 		
-		//	Decode
-		std::vector<CodePoint> retr;
-		Stream(retr,begin,end,order);
+			GetBOM(buffer);
+			flush();
 		
-		//	Handle unexpected end
-		if (begin!=end) {
+		}
 		
-			auto repl=handle(EncodingErrorType::UnexpectedEnd,begin);
+		while (begin!=end) {
+		
+			//	Encode everything that can be encoded
+			//	in bulk
+			std::size_t bytes=0;
+			auto last=BulkCounter(bytes,begin,end);
+			if (last!=begin) {
+			
+				auto out=get(ptr,bytes);
+				if (out!=nullptr) BulkEncoder(out,begin,last);
+				
+				retr+=bytes;
+				begin=last;
 			
-			if (repl) retr.push_back(*repl);
+			}
+			
+			if (begin==end) break;
+			
+			//	Bulk encoding stopped at a code point which
+			//	must be checked
+			auto cp=check(*(begin++));
+			if (!cp) continue;
+			
+			Encoder(buffer,*cp);
+			flush();
 		
 		}
 		
@@ -180,20 +176,18 @@ namespace Unicode {
 	}
 	
 	
-	std::optional<CodePoint> Encoding::Stream (const void * & begin, const void * end, std::optional<Unicode::Endianness> order) const {
-	
-		//	Convert iterators as appropriate
-		auto b=reinterpret_cast<const unsigned char *>(begin);
-		auto e=reinterpret_cast<const unsigned char *>(end);
+	std::optional<CodePoint> Encoding::next (const unsigned char * & begin, const unsigned char * limit, const unsigned char * end, std::optional<Unicode::Endianness> order) const {
 	
-		while (b!=e) {
+		auto b=begin;
+		
+		while (b<limit) {
 		
 			//	Cache start location
 			auto start=b;
 			
 			//	Decode
 			CodePoint cp;
-			auto error=Decoder(cp,b,e,order);
+			auto error=Decoder(cp,b,end,order);
 			
 			//	If the decoder didn't advance the iterator, do so to
 			//	avoid a potential infinite loop
@@ -261,32 +255,757 @@ namespace Unicode {
 			begin=b;
 			
 			return cp;
-			
+		
 		}
 		
-		//	Falling through to here means the end of the
-		//	buffer was reached gracefully, meaning there's
-		//	no character to return, but the begin iterator
-		//	should be fast forwarded all the way to the end
+		//	Falling through to here means the limit was
+		//	reached gracefully, meaning there's no character
+		//	to return, but the begin iterator should be fast
+		//	forwarded past everything that was skipped
 		
-		begin=end;
+		begin=b;
 		
 		return std::nullopt;
 	
 	}
 	
 	
-	void Encoding::Stream (std::vector<CodePoint> & cps, const void * & begin, const void * end, std::optional<Unicode::Endianness> order) const {
+	void Encoding::stream (CodePoint * & out, CodePoint * last, const unsigned char * & begin, const unsigned char * limit, const unsigned char * end, std::optional<Unicode::Endianness> order) const {
 	
-		for (;;) {
+		auto size=Size();
+		
+		while (out!=last) {
 		
-			auto cp=Stream(begin,end,order);
+			//	Decode everything that can be decoded in bulk,
+			//	but never more code units than there's room
+			//	for code points
+			auto units=std::min(
+				(begin<limit) ? (static_cast<std::size_t>(limit-begin)/size) : 0,
+				static_cast<std::size_t>(last-out)
+			);
+			auto bulk=begin+(units*size);
+			begin=BulkDecoder(out,begin,bulk,end,order);
+			
+			if ((units!=0) && (begin>=bulk)) continue;
+			
+			//	The bulk decoder stopped either at the limit
+			//	or at a sequence which must be handled one
+			//	code point at a time
+			auto cp=next(begin,limit,end,order);
 			
 			if (!cp) return;
 			
-			cps.push_back(*cp);
+			*(out++)=*cp;
+		
+		}
+	
+	}
+	
+	
+	std::size_t Encoding::decode (CodePoint * out, std::size_t size, const unsigned char * begin, const unsigned char * limit, const unsigned char * end, std::optional<Unicode::Endianness> order) const {
+	
+		//	Decode as much as there's room for
+		auto o=out;
+		auto last=out+size;
+		stream(o,last,begin,limit,end,order);
+		auto retr=static_cast<std::size_t>(o-out);
+		
+		//	If the buffer filled up, keep going so that
+		//	the size is known
+		CodePoint discard [256];
+		while (o==last) {
+		
+			o=discard;
+			last=std::end(discard);
+			stream(o,last,begin,limit,end,order);
+			retr+=static_cast<std::size_t>(o-discard);
+		
+		}
+		
+		//	Handle unexpected end
+		if (begin<limit) {
+		
+			auto repl=handle(EncodingErrorType::UnexpectedEnd,begin);
+			
+			if (repl) {
+			
+				if (retr<size) out[retr]=*repl;
+				++retr;
+			
+			}
+		
+		}
+		
+		return retr;
+	
+	}
+	
+	
+	const unsigned char * Encoding::detect (const void * begin, const void * end, std::optional<Unicode::Endianness> & order) const {
+	
+		auto retr=reinterpret_cast<const unsigned char *>(begin);
+		if (DetectBOM) order=GetBOM(
+			retr,
+			reinterpret_cast<const unsigned char *>(end)
+		);
+		
+		return retr;
+	
+	}
+	
+	
+	void Encoding::transcode (const void * begin, const void * end, const Encoding & encoding, unsigned char * (* get) (void *, std::size_t), void * ptr) const {
+	
+		//	Detect order (if applicable)
+		std::optional<Unicode::Endianness> order;
+		auto b=detect(begin,end,order);
+		auto e=reinterpret_cast<const unsigned char *>(end);
+		
+		//	Code points pass through a buffer small enough
+		//	to remain in cache rather than being decoded all
+		//	at once
+		CodePoint cps [1024];
+		for (auto bom=encoding.OutputBOM;;bom=false) {
+		
+			auto out=cps;
+			auto last=std::end(cps);
+			stream(out,last,b,e,e,order);
+			auto done=out!=last;
+			
+			//	Handle unexpected end, if the buffer didn't
+			//	fill up there's room for the replacement
+			if (done && (b!=e)) {
+			
+				auto repl=handle(EncodingErrorType::UnexpectedEnd,b);
+				
+				if (repl) *(out++)=*repl;
+			
+			}
+			
+			encoding.encode(cps,out,bom,get,ptr);
+			
+			if (done) return;
+		
+		}
+	
+	}
+
+
+	const CodePoint * Encoding::BulkCounter (std::size_t &, const CodePoint * begin, const CodePoint *) const {
+	
+		return begin;
+	
+	}
+	
+	
+	void Encoding::BulkEncoder (unsigned char *, const CodePoint *, const CodePoint *) const {	}
+	
+	
+	const unsigned char * Encoding::BulkDecoder (CodePoint * &, const unsigned char * begin, const unsigned char *, const unsigned char *, std::optional<Unicode::Endianness>) const {
+	
+		return begin;
+	
+	}
+	
+	
+	//	Every code point which terminates a line is in
+	//	the range U+000A through U+000D, or is U+0085,
+	//	U+2028, or U+2029
+	static bool is_line_terminator (CodePoint cp) noexcept {
+	
+		CodePoint::Type c=cp;
+		
+		return ((c>=0x0AU) && (c<=0x0DU)) || (c==0x85U) || ((c|1U)==0x2029U);
+	
+	}
+	
+	
+	bool Encoding::terminates (CodePoint cp, const unsigned char * next, const unsigned char * end, std::optional<Unicode::Endianness> order) const {
+	
+		if (!is_line_terminator(cp)) return false;
+		if ((cp!='\r') || (next==end)) return true;
+		
+		//	A CR immediately followed by a LF is counted
+		//	at the LF
+		CodePoint lf;
+		auto error=Decoder(lf,next,end,order);
+		
+		return error || (lf!='\n');
+	
+	}
+	
+	
+	const unsigned char * Encoding::BulkMeasurer (std::size_t & cps, std::size_t * lines, const unsigned char * begin, const unsigned char * limit, const unsigned char * end, std::optional<Unicode::Endianness> order) const {
+	
+		auto size=Size();
+		CodePoint buffer [256];
+		
+		while (begin<limit) {
+		
+			auto units=std::min(
+				static_cast<std::size_t>(limit-begin)/size,
+				sizeof(buffer)/sizeof(CodePoint)
+			);
+			if (units==0) break;
+			
+			auto bulk=begin+(units*size);
+			auto out=buffer;
+			begin=BulkDecoder(out,begin,bulk,end,order);
+			cps+=static_cast<std::size_t>(out-buffer);
+			
+			if (lines!=nullptr) for (auto ptr=buffer;ptr!=out;++ptr) {
+			
+				//	Whatever follows the last code point in the
+				//	buffer hasn't been decoded
+				if ((ptr+1)==out) {
+				
+					if (terminates(*ptr,begin,end,order)) ++*lines;
+				
+				} else if (is_line_terminator(*ptr) && ((*ptr!='\r') || (ptr[1]!='\n'))) {
+				
+					++*lines;
+				
+				}
+			
+			}
+			
+			if (begin<bulk) break;
 		
 		}
+		
+		return begin;
+	
+	}
+	
+	
+	const unsigned char * Encoding::Boundary (const unsigned char * begin, const unsigned char * where, const unsigned char * end, std::optional<Unicode::Endianness>) const {
+	
+		auto size=Size();
+		auto offset=((static_cast<std::size_t>(where-begin)+size-1)/size)*size;
+		
+		//	A partial code unit at the end belongs to
+		//	whatever precedes it
+		if ((static_cast<std::size_t>(end-begin)-offset)<size) return end;
+		
+		return begin+offset;
+	
+	}
+	
+	
+	void Encoding::GetBOM (std::vector<unsigned char> & buffer) const {
+	
+		BOM().Get(buffer);
+	
+	}
+	
+	
+	std::optional<Endianness> Encoding::GetBOM (const unsigned char * & begin, const unsigned char * end) const {
+	
+		const void * b=begin;
+		auto retr=BOM().Detect(b,end);
+		begin=reinterpret_cast<const unsigned char *>(b);
+		
+		return retr;
+	
+	}
+
+
+	Encoding::Encoding (bool output_bom, bool detect_bom) noexcept
+		:	UnicodeStrict(EncodingErrorType::UnicodeStrict),
+			Strict(EncodingErrorType::Strict),
+			Lossy(EncodingErrorType::Lossy),
+			UnexpectedEnd(EncodingErrorType::UnexpectedEnd),
+			Endianness(EncodingErrorType::Endianness),
+			OutputBOM(output_bom),
+			DetectBOM(detect_bom),
+			Sink(nullptr)
+	{	}
+	
+	
+	Encoding::~Encoding () noexcept {	}
+	
+	
+	std::vector<unsigned char> Encoding::Encode (const CodePoint * begin, const CodePoint * end) const {
+	
+		std::vector<unsigned char> retr;
+		Encode(begin,end,retr);
+		
+		return retr;
+	
+	}
+	
+	
+	std::vector<unsigned char> Encoding::Encode (const std::vector<CodePoint> & vec) const {
+	
+		return Encode(Begin(vec),End(vec));
+	
+	}
+	
+	
+	std::vector<unsigned char> Encoding::Encode (const String & str) const {
+	
+		return Encode(str.CodePoints());
+	
+	}
+	
+	
+	static unsigned char * get_vector (void * ptr, std::size_t n) {
+	
+		auto & vec=*reinterpret_cast<std::vector<unsigned char> *>(ptr);
+		auto size=vec.size();
+		vec.resize(size+n);
+		
+		return Begin(vec)+size;
+	
+	}
+	
+	
+	void Encoding::Encode (const CodePoint * begin, const CodePoint * end, std::vector<unsigned char> & buffer) const {
+	
+		encode(begin,end,OutputBOM,get_vector,&buffer);
+	
+	}
+	
+	
+	static unsigned char * get_string (void * ptr, std::size_t n) {
+	
+		auto & str=*reinterpret_cast<std::string *>(ptr);
+		auto size=str.size();
+		str.resize(size+n);
+		
+		return reinterpret_cast<unsigned char *>(&str[size]);
+	
+	}
+	
+	
+	void Encoding::Encode (const CodePoint * begin, const CodePoint * end, std::string & str) const {
+	
+		encode(begin,end,OutputBOM,get_string,&str);
+	
+	}
+	
+	
+	namespace {
+	
+	
+		class fixed_buffer {
+		
+		
+			public:
+			
+			
+				unsigned char * Out;
+				std::size_t Size;
+		
+		
+		};
+	
+	
+	}
+	
+	
+	static unsigned char * get_fixed (void * ptr, std::size_t n) noexcept {
+	
+		auto & buffer=*reinterpret_cast<fixed_buffer *>(ptr);
+		
+		//	Once something doesn't fit nothing more is
+		//	written
+		if (n>buffer.Size) {
+		
+			buffer.Size=0;
+			
+			return nullptr;
+		
+		}
+		
+		auto retr=buffer.Out;
+		buffer.Out+=n;
+		buffer.Size-=n;
+		
+		return retr;
+	
+	}
+	
+	
+	std::size_t Encoding::Encode (const CodePoint * begin, const CodePoint * end, void * out, std::size_t size) const {
+	
+		fixed_buffer buffer{reinterpret_cast<unsigned char *>(out),size};
+		
+		return encode(begin,end,OutputBOM,get_fixed,&buffer);
+	
+	}
+	
+	
+	static unsigned char * get_nothing (void *, std::size_t) noexcept {
+	
+		return nullptr;
+	
+	}
+	
+	
+	std::size_t Encoding::EncodedSize (const CodePoint * begin, const CodePoint * end) const {
+	
+		return encode(begin,end,OutputBOM,get_nothing,nullptr);
+	
+	}
+	
+	
+	//	Dividing the input any more finely than this costs
+	//	more in starting threads than it saves
+	static const std::size_t parallel_chunk=1U<<18;
+	
+	
+	//	Determines how many chunks to divide an input into
+	static std::size_t chunks (std::size_t size, std::size_t min, std::size_t threads) noexcept {
+	
+		if (threads==0) threads=std::thread::hardware_concurrency();
+		
+		return std::min(threads,size/min);
+	
+	}
+	
+	
+	//	Invokes a callable once for each chunk, each on
+	//	its own thread, and rethrows the exception thrown
+	//	for the earliest chunk, which is the exception
+	//	that processing the chunks in order would've
+	//	thrown
+	template <typename T>
+	static void parallel (std::size_t n, T callback) {
+	
+		std::vector<std::exception_ptr> errors(n);
+		auto work=[&] (std::size_t i) noexcept {
+		
+			try {
+			
+				callback(i);
+			
+			} catch (...) {
+			
+				errors[i]=std::current_exception();
+			
+			}
+		
+		};
+		
+		//	If a thread can't be started its chunk is
+		//	processed on this thread instead
+		std::vector<std::thread> workers;
+		workers.reserve(n-1);
+		for (std::size_t i=1;i<n;++i) {
+		
+			try {
+			
+				workers.emplace_back(work,i);
+			
+			} catch (...) {
+			
+				work(i);
+			
+			}
+		
+		}
+		work(0);
+		for (auto & worker : workers) worker.join();
+		
+		for (auto & error : errors) if (error) std::rethrow_exception(error);
+	
+	}
+	
+	
+	std::vector<unsigned char> Encoding::ParallelEncode (const CodePoint * begin, const CodePoint * end, std::size_t threads) const {
+	
+		auto size=static_cast<std::size_t>(end-begin);
+		//	Errors must be reported in order, so they can't
+		//	be encountered on several threads at once
+		auto n=(Sink==nullptr) ? chunks(size,parallel_chunk/sizeof(CodePoint),threads) : 0;
+		if (n<2) return Encode(begin,end);
+		
+		//	Code points are encoded independently, so any
+		//	division will do
+		std::vector<const CodePoint *> bounds(n+1,end);
+		for (std::size_t i=0;i<n;++i) bounds[i]=begin+((size/n)*i);
+		
+		std::vector<unsigned char> bom;
+		if (OutputBOM) GetBOM(bom);
+		std::vector<std::size_t> offsets(n+1,0);
+		offsets[0]=bom.size();
+		parallel(n,[&] (std::size_t i) {
+		
+			offsets[i+1]=encode(bounds[i],bounds[i+1],false,get_nothing,nullptr);
+		
+		});
+		for (std::size_t i=0;i<n;++i) offsets[i+1]+=offsets[i];
+		
+		std::vector<unsigned char> retr(offsets[n]);
+		std::copy(bom.begin(),bom.end(),retr.begin());
+		parallel(n,[&] (std::size_t i) {
+		
+			fixed_buffer buffer{Begin(retr)+offsets[i],offsets[i+1]-offsets[i]};
+			encode(bounds[i],bounds[i+1],false,get_fixed,&buffer);
+		
+		});
+		
+		return retr;
+	
+	}
+	
+	
+	std::vector<CodePoint> Encoding::Decode (const void * begin, const void * end) const {
+	
+		std::vector<CodePoint> retr;
+		Decode(begin,end,retr);
+		
+		return retr;
+	
+	}
+	
+	
+	void Encoding::Decode (const void * begin, const void * end, std::vector<CodePoint> & cps) const {
+	
+		//	Detect order (if applicable)
+		std::optional<Unicode::Endianness> order;
+		begin=detect(begin,end,order);
+		
+		//	Decode
+		Stream(cps,begin,end,order);
+		
+		//	Handle unexpected end
+		if (begin!=end) {
+		
+			auto repl=handle(EncodingErrorType::UnexpectedEnd,begin);
+			
+			if (repl) cps.push_back(*repl);
+		
+		}
+	
+	}
+	
+	
+	std::size_t Encoding::Decode (const void * begin, const void * end, CodePoint * out, std::size_t size) const {
+	
+		//	Detect order (if applicable)
+		std::optional<Unicode::Endianness> order;
+		auto b=detect(begin,end,order);
+		auto e=reinterpret_cast<const unsigned char *>(end);
+		
+		return decode(out,size,b,e,e,order);
+	
+	}
+	
+	
+	std::size_t Encoding::DecodedSize (const void * begin, const void * end) const {
+	
+		return Decode(begin,end,nullptr,0);
+	
+	}
+	
+	
+	EncodingMeasurement Encoding::Measure (const void * begin, const void * end, bool lines) const {
+	
+		EncodingMeasurement retr{0,0,std::nullopt};
+		auto count=lines ? &retr.Lines : nullptr;
+		
+		//	Detect order (if applicable)
+		std::optional<Unicode::Endianness> order;
+		auto b=detect(begin,end,order);
+		auto e=reinterpret_cast<const unsigned char *>(end);
+		
+		for (;;) {
+		
+			b=BulkMeasurer(retr.CodePoints,count,b,e,e,order);
+			if (b>=e) break;
+			
+			//	Bulk measuring stopped at a sequence which
+			//	must be decoded by itself
+			auto start=b;
+			CodePoint cp;
+			auto error=Decoder(cp,b,e,order);
+			if (b==start) ++b;
+			if (!(error || UnicodeStrict.Ignored() || cp.IsValid())) error=EncodingErrorType::UnicodeStrict;
+			
+			if (error) {
+			
+				//	Endianness errors are irrecoverable
+				if ((*error==EncodingErrorType::Endianness) || !get(*error).Ignored()) {
+				
+					retr.Error=EncodingErrorLog::Entry{
+						*error,
+						static_cast<std::size_t>(start-reinterpret_cast<const unsigned char *>(begin))
+					};
+					
+					break;
+				
+				}
+				
+				//	Decoding stops at an unexpected end even if
+				//	it's ignored
+				if (*error==EncodingErrorType::UnexpectedEnd) break;
+				
+				continue;
+			
+			}
+			
+			++retr.CodePoints;
+			if ((count!=nullptr) && terminates(cp,b,e,order)) ++*count;
+		
+		}
+		
+		return retr;
+	
+	}
+	
+	
+	std::vector<CodePoint> Encoding::ParallelDecode (const void * begin, const void * end, std::size_t threads) const {
+	
+		//	Detect order (if applicable)
+		std::optional<Unicode::Endianness> order;
+		auto b=detect(begin,end,order);
+		auto e=reinterpret_cast<const unsigned char *>(end);
+		
+		auto bytes=static_cast<std::size_t>(e-b);
+		//	Errors must be reported in order, and each chunk
+		//	is decoded twice, so errors can only be reported
+		//	when decoding on this thread alone
+		auto n=(Sink==nullptr) ? chunks(bytes,parallel_chunk,threads) : 0;
+		if (n<2) return Decode(begin,end);
+		
+		//	Each chunk begins where a sequence begins no
+		//	matter what precedes it, and sequences which begin
+		//	in a chunk are decoded with it even if they end in
+		//	the next, so that every chunk is decoded exactly
+		//	as it would be if everything were decoded at once
+		std::vector<const unsigned char *> bounds(n+1,e);
+		bounds[0]=b;
+		for (std::size_t i=1;i<n;++i) bounds[i]=std::max(
+			bounds[i-1],
+			Boundary(b,b+((bytes/n)*i),e,order)
+		);
+		
+		std::vector<std::size_t> offsets(n+1,0);
+		parallel(n,[&] (std::size_t i) {
+		
+			offsets[i+1]=decode(nullptr,0,bounds[i],bounds[i+1],e,order);
+		
+		});
+		for (std::size_t i=0;i<n;++i) offsets[i+1]+=offsets[i];
+		
+		std::vector<CodePoint> retr(offsets[n]);
+		auto out=Begin(retr);
+		parallel(n,[&] (std::size_t i) {
+		
+			decode(out+offsets[i],offsets[i+1]-offsets[i],bounds[i],bounds[i+1],e,order);
+		
+		});
+		
+		return retr;
+	
+	}
+	
+	
+	std::vector<unsigned char> Encoding::Transcode (const void * begin, const void * end, const Encoding & encoding) const {
+	
+		std::vector<unsigned char> retr;
+		Transcode(begin,end,encoding,retr);
+		
+		return retr;
+	
+	}
+	
+	
+	//	Estimates the size of the output of transcoding as
+	//	one code unit per code unit, which is exact for ASCII
+	static std::size_t estimate (const void * begin, const void * end, const Encoding & from, const Encoding & to) noexcept {
+	
+		auto bytes=static_cast<std::size_t>(
+			reinterpret_cast<const unsigned char *>(end)-
+			reinterpret_cast<const unsigned char *>(begin)
+		);
+		
+		return (bytes/from.Size())*to.Size();
+	
+	}
+	
+	
+	void Encoding::Transcode (const void * begin, const void * end, const Encoding & encoding, std::vector<unsigned char> & buffer) const {
+	
+		Reserve(buffer,estimate(begin,end,*this,encoding));
+		
+		transcode(begin,end,encoding,get_vector,&buffer);
+	
+	}
+	
+	
+	void Encoding::Transcode (const void * begin, const void * end, const Encoding & encoding, std::string & str) const {
+	
+		str.reserve(str.size()+estimate(begin,end,*this,encoding));
+		
+		transcode(begin,end,encoding,get_string,&str);
+	
+	}
+	
+	
+	std::optional<CodePoint> Encoding::Stream (const void * & begin, const void * end, std::optional<Unicode::Endianness> order) const {
+	
+		//	Convert iterators as appropriate
+		auto b=reinterpret_cast<const unsigned char *>(begin);
+		auto e=reinterpret_cast<const unsigned char *>(end);
+		
+		auto retr=next(b,e,e,order);
+		begin=b;
+		
+		return retr;
+	
+	}
+	
+	
+	void Encoding::Stream (std::vector<CodePoint> & cps, const void * & begin, const void * end, std::optional<Unicode::Endianness> order) const {
+	
+		//	Bounds the amount of the output that's resized
+		//	at once, so that resuming after an error costs
+		//	nothing more than what's decoded
+		const std::size_t chunk=4096;
+		
+		auto b=reinterpret_cast<const unsigned char *>(begin);
+		auto e=reinterpret_cast<const unsigned char *>(end);
+		auto size=Size();
+		
+		//	Decoding never yields more code points than
+		//	there are code units
+		Reserve(cps,static_cast<std::size_t>(e-b)/size);
+		
+		for (;;) {
+		
+			//	Nothing can be decoded from less than a
+			//	whole code unit
+			auto n=std::min(static_cast<std::size_t>(e-b)/size,chunk);
+			if (n==0) break;
+			
+			auto count=cps.size();
+			cps.resize(count+n);
+			
+			auto out=Begin(cps)+count;
+			auto last=out+n;
+			try {
+			
+				stream(out,last,b,e,e,order);
+			
+			} catch (...) {
+			
+				//	Keep everything decoded before the error
+				cps.resize(static_cast<std::size_t>(out-Begin(cps)));
+				begin=b;
+				
+				throw;
+			
+			}
+			cps.resize(static_cast<std::size_t>(out-Begin(cps)));
+			
+			if (out!=last) break;
+		
+		}
+		
+		begin=b;
 	
 	}
 	
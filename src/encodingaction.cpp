@@ -58,6 +58,22 @@ namespace Unicode {
 		raise(where);
 	
 	}
+	
+	
+	std::optional<CodePoint> EncodingAction::Replacement (CodePoint fallback) const noexcept {
+	
+		switch (action) {
+		
+			case Action::Nothing:
+				return std::optional<CodePoint>{};
+			case Action::Replace:
+				return cp;
+			default:
+				return fallback;
+		
+		}
+	
+	}
 
 
 }
@@ -0,0 +1,37 @@
+#include <unicode/encoding.hpp>
+
+
+namespace Unicode {
+
+
+	EncodingErrorLog::EncodingErrorLog (const void * begin) noexcept
+		:	base(reinterpret_cast<const unsigned char *>(begin)),
+			size(1),
+			stream(nullptr)
+	{	}
+	
+	
+	EncodingErrorLog::EncodingErrorLog (const CodePoint * begin) noexcept
+		:	base(reinterpret_cast<const unsigned char *>(begin)),
+			size(sizeof(CodePoint)),
+			stream(nullptr)
+	{	}
+	
+	
+	EncodingErrorLog::EncodingErrorLog (const StreamDecoder & decoder) noexcept
+		:	base(nullptr),
+			size(1),
+			stream(&decoder)
+	{	}
+	
+	
+	void EncodingErrorLog::Report (EncodingErrorType type, const void * where) {
+	
+		auto offset=(stream==nullptr) ? static_cast<std::size_t>(reinterpret_cast<const unsigned char *>(where)-base)/size : stream->Offset(where);
+		
+		Entries.push_back(Entry{type,offset});
+	
+	}
+
+
+}
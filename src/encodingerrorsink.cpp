@@ -0,0 +1,10 @@
+#include <unicode/encoding.hpp>
+
+
+namespace Unicode {
+
+
+	EncodingErrorSink::~EncodingErrorSink () noexcept {	}
+
+
+}
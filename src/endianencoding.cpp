@@ -1,4 +1,8 @@
 #include <unicode/endianencoding.hpp>
+#include "simd.hpp"
+#include <cstdint>
+#include <cstring>
+#include <limits>
 
 
 namespace Unicode {
@@ -15,6 +19,182 @@ namespace Unicode {
 		BOM().Get(buffer,OutputOrder);
 	
 	}
+	
+	
+	//	The scalar version of DecodeSingle, also used for
+	//	the tail which doesn't fill a vector
+	static const unsigned char * decode_single (CodePoint * & out, const unsigned char * begin, const unsigned char * limit, bool reverse) noexcept {
+	
+		for (;begin!=limit;begin+=sizeof(std::uint16_t)) {
+		
+			std::uint16_t cu;
+			std::memcpy(&cu,begin,sizeof(cu));
+			CodePoint cp(reverse ? EndianEncoding::Correct(cu) : cu);
+			if (!cp.IsValid()) break;
+			
+			*(out++)=cp;
+		
+		}
+		
+		return begin;
+	
+	}
+	
+	
+	#ifdef UNICODE_SSE2
+	//	Determines which of eight code units are not code
+	//	points by themselves: Surrogates, U+FDD0 through
+	//	U+FDEF, U+FFFE, and U+FFFF
+	static __m128i is_not_single (__m128i v) noexcept {
+	
+		auto surrogate=_mm_cmpeq_epi16(
+			_mm_and_si128(v,_mm_set1_epi16(static_cast<std::int16_t>(0xF800))),
+			_mm_set1_epi16(static_cast<std::int16_t>(0xD800))
+		);
+		
+		//	There's no unsigned comparison so the sign bit
+		//	is flipped and the bounds are flipped to match
+		auto s=_mm_xor_si128(v,_mm_set1_epi16(std::numeric_limits<std::int16_t>::min()));
+		auto nonchar=_mm_or_si128(
+			_mm_and_si128(
+				_mm_cmpgt_epi16(s,_mm_set1_epi16(0xFDCF-0x8000)),
+				_mm_cmplt_epi16(s,_mm_set1_epi16(0xFDF0-0x8000))
+			),
+			_mm_cmpgt_epi16(s,_mm_set1_epi16(0xFFFD-0x8000))
+		);
+		
+		return _mm_or_si128(surrogate,nonchar);
+	
+	}
+	
+	
+	static const unsigned char * decode_single_sse2 (CodePoint * & out, const unsigned char * begin, const unsigned char * limit, bool reverse) noexcept {
+	
+		auto zero=_mm_setzero_si128();
+		
+		while ((limit-begin)>=16) {
+		
+			auto v=_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+			if (reverse) v=_mm_or_si128(_mm_slli_epi16(v,8),_mm_srli_epi16(v,8));
+			
+			//	Widen all eight code units unconditionally, there's
+			//	room for one code point per code unit
+			auto o=reinterpret_cast<__m128i *>(out);
+			_mm_storeu_si128(o,_mm_unpacklo_epi16(v,zero));
+			_mm_storeu_si128(o+1,_mm_unpackhi_epi16(v,zero));
+			
+			//	Keep only those code points which precede the
+			//	first code unit which is not a code point by
+			//	itself
+			auto mask=static_cast<unsigned int>(_mm_movemask_epi8(is_not_single(v)));
+			if (mask!=0) {
+			
+				auto n=count_trailing_zeroes(mask)/2;
+				out+=n;
+				
+				return begin+(n*2);
+			
+			}
+			
+			out+=8;
+			begin+=16;
+		
+		}
+		
+		return decode_single(out,begin,limit,reverse);
+	
+	}
+	#endif
+	
+	
+	#ifdef UNICODE_AVX2
+	__attribute__((target("avx2")))
+	static __m256i is_not_single_avx2 (__m256i v) noexcept {
+	
+		auto surrogate=_mm256_cmpeq_epi16(
+			_mm256_and_si256(v,_mm256_set1_epi16(static_cast<std::int16_t>(0xF800))),
+			_mm256_set1_epi16(static_cast<std::int16_t>(0xD800))
+		);
+		
+		auto s=_mm256_xor_si256(v,_mm256_set1_epi16(std::numeric_limits<std::int16_t>::min()));
+		auto nonchar=_mm256_or_si256(
+			_mm256_and_si256(
+				_mm256_cmpgt_epi16(s,_mm256_set1_epi16(0xFDCF-0x8000)),
+				_mm256_cmpgt_epi16(_mm256_set1_epi16(0xFDF0-0x8000),s)
+			),
+			_mm256_cmpgt_epi16(s,_mm256_set1_epi16(0xFFFD-0x8000))
+		);
+		
+		return _mm256_or_si256(surrogate,nonchar);
+	
+	}
+	
+	
+	__attribute__((target("avx2")))
+	static const unsigned char * decode_single_avx2 (CodePoint * & out, const unsigned char * begin, const unsigned char * limit, bool reverse) noexcept {
+	
+		auto swap=_mm256_setr_epi8(
+			1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14,
+			1,0,3,2,5,4,7,6,9,8,11,10,13,12,15,14
+		);
+		
+		while ((limit-begin)>=32) {
+		
+			auto v=_mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+			if (reverse) v=_mm256_shuffle_epi8(v,swap);
+			
+			auto o=reinterpret_cast<__m256i *>(out);
+			_mm256_storeu_si256(o,_mm256_cvtepu16_epi32(_mm256_castsi256_si128(v)));
+			_mm256_storeu_si256(o+1,_mm256_cvtepu16_epi32(_mm256_extracti128_si256(v,1)));
+			
+			auto mask=static_cast<unsigned int>(_mm256_movemask_epi8(is_not_single_avx2(v)));
+			if (mask!=0) {
+			
+				auto n=count_trailing_zeroes(mask)/2;
+				out+=n;
+				
+				return begin+(n*2);
+			
+			}
+			
+			out+=16;
+			begin+=32;
+		
+		}
+		
+		return decode_single(out,begin,limit,reverse);
+	
+	}
+	#endif
+	
+	
+	typedef const unsigned char * (* kernel_type) (CodePoint * &, const unsigned char *, const unsigned char *, bool) noexcept;
+	
+	
+	//	Chooses the best kernel supported by the processor
+	//	on which we're running
+	static kernel_type get_kernel () noexcept {
+	
+		#ifdef UNICODE_AVX2
+		if (__builtin_cpu_supports("avx2")) return decode_single_avx2;
+		#endif
+		
+		#ifdef UNICODE_SSE2
+		return decode_single_sse2;
+		#else
+		return decode_single;
+		#endif
+	
+	}
+	
+	
+	const unsigned char * EndianEncoding::DecodeSingle (CodePoint * & out, const unsigned char * begin, const unsigned char * limit, bool reverse) noexcept {
+	
+		static const kernel_type kernel=get_kernel();
+		
+		return kernel(out,begin,limit,reverse);
+	
+	}
 
 
 }
@@ -1,4 +1,6 @@
 #include <unicode/latin1.hpp>
+#include "simd.hpp"
+#include <algorithm>
 #include <limits>
 
 
@@ -12,6 +14,23 @@ namespace Unicode {
 	}
 	
 	
+	const CodePoint * Latin1::BulkCounter (std::size_t & bytes, const CodePoint * begin, const CodePoint * end) const {
+	
+		auto last=skip_below(begin,end,0x100U);
+		bytes=static_cast<std::size_t>(last-begin);
+		
+		return last;
+	
+	}
+	
+	
+	void Latin1::BulkEncoder (unsigned char * out, const CodePoint * begin, const CodePoint * end) const {
+	
+		narrow(out,begin,end);
+	
+	}
+	
+	
 	std::optional<EncodingErrorType> Latin1::Decoder (CodePoint & cp, const unsigned char * & begin, const unsigned char * end, std::optional<Unicode::Endianness>) const {
 	
 		cp=*begin;
@@ -21,6 +40,16 @@ namespace Unicode {
 	}
 	
 	
+	const unsigned char * Latin1::BulkDecoder (CodePoint * & out, const unsigned char * begin, const unsigned char * limit, const unsigned char *, std::optional<Unicode::Endianness>) const {
+	
+		//	Every byte is a valid code point
+		out=std::copy(begin,limit,out);
+		
+		return limit;
+	
+	}
+	
+	
 	Latin1::Latin1 () noexcept : Encoding(false,false) {	}
 	
 	
@@ -0,0 +1,41 @@
+#include <unicode/loadfile.hpp>
+#include <unicode/utf8.hpp>
+#include <unicode/utf16.hpp>
+#include <unicode/utf32.hpp>
+#include "mappedfile.hpp"
+
+
+namespace Unicode {
+
+
+	String LoadFile (const char * filename) {
+	
+		MappedFile file(filename);
+		
+		UTF8 utf8;
+		utf8.DetectBOM=true;
+		UTF16 utf16;
+		UTF32 utf32;
+		
+		//	The little endian UTF-32 byte order mark begins
+		//	with the little endian UTF-16 byte order mark, so
+		//	UTF-32 must be checked first
+		const Encoding * encoding=&utf8;
+		if (utf32.BOM().Detect(file.begin(),file.end())) encoding=&utf32;
+		else if (utf16.BOM().Detect(file.begin(),file.end())) encoding=&utf16;
+		
+		return encoding->ParallelDecode(file.begin(),file.end());
+	
+	}
+	
+	
+	String LoadFile (const char * filename, const Encoding & encoding) {
+	
+		MappedFile file(filename);
+		
+		return encoding.ParallelDecode(file.begin(),file.end());
+	
+	}
+
+
+}
@@ -1,6 +1,11 @@
 #include <unicode/binarysearch.hpp>
+#include <unicode/hangul.hpp>
 #include <unicode/locale.hpp>
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
 
 
 namespace Unicode {
@@ -25,18 +30,505 @@ namespace Unicode {
 	
 	const CodePointInfo * Locale::GetInfo (CodePoint cp) const noexcept {
 	
-		auto end=Info.end();
+		if (cp<Latin1Info.Size) return Latin1Info[cp];
+		
+		if (!InfoIndex.IsEmpty()) {
+		
+			auto i=InfoIndex.Get(cp);
+			
+			return (i==CodePointIndex::None) ? nullptr : &Info[i];
+		
+		}
+		
+		auto record=GetRecord(cp);
+		
+		return (record==nullptr) ? nullptr : &Info[record->Info];
+	
+	}
+	
+	
+	//	Looks up the offsets within the second stage of
+	//	an index of many code points, retaining the
+	//	offset of the last block looked up so that runs
+	//	of code points within one block (i.e. text in
+	//	one script) only consult the first stage once
+	namespace {
+	
+	
+		class OffsetCache {
+		
+		
+			private:
+			
+			
+				const CodePointIndex & index;
+				std::size_t block;
+				std::size_t base;
+				
+				
+				static constexpr CodePoint::Type mask=(static_cast<CodePoint::Type>(1)<<CodePointIndex::Shift)-1;
+			
+			
+			public:
+			
+			
+				explicit OffsetCache (const CodePointIndex & index) noexcept
+					:	index(index),
+						block(index.Blocks.Size),
+						base(index.Indices.Size)
+				{	}
+				
+				
+				std::size_t Get (CodePoint::Type cp) noexcept {
+				
+					std::size_t block=cp>>CodePointIndex::Shift;
+					if (block!=this->block) {
+					
+						this->block=block;
+						base=(block<index.Blocks.Size) ? (static_cast<std::size_t>(index.Blocks[block])<<CodePointIndex::Shift) : index.Indices.Size;
+					
+					}
+					
+					return (base==index.Indices.Size) ? base : (base|(cp&mask));
+				
+				}
+		
+		
+		};
+	
+	
+	}
+	
+	
+	void Locale::GetInfo (const CodePoint * begin, const CodePoint * end, const CodePointInfo ** out) const noexcept {
+	
+		if (!InfoIndex.IsEmpty()) {
+		
+			OffsetCache cache(InfoIndex);
+			for (;begin!=end;++begin,++out) {
+			
+				CodePoint::Type cp=*begin;
+				if (cp<Latin1Info.Size) {
+				
+					*out=Latin1Info[cp];
+					
+					continue;
+				
+				}
+				
+				auto offset=cache.Get(cp);
+				std::uint16_t i=(offset==InfoIndex.Indices.Size) ? CodePointIndex::None : InfoIndex.Indices[offset];
+				*out=(i==CodePointIndex::None) ? nullptr : &Info[i];
+			
+			}
+			
+			return;
+		
+		}
+		
+		//	Without an index, the last record found is
+		//	retained, since it frequently describes the
+		//	next code point as well
+		const CodePointRecord * record=nullptr;
+		for (;begin!=end;++begin,++out) {
+		
+			CodePoint::Type cp=*begin;
+			if (cp<Latin1Info.Size) {
+			
+				*out=Latin1Info[cp];
+				
+				continue;
+			
+			}
+			
+			if (!(
+				(record!=nullptr) &&
+				(record->CodePoint<=cp) &&
+				(cp<=record->Last)
+			)) record=GetRecord(cp);
+			
+			*out=(record==nullptr) ? nullptr : &Info[record->Info];
+		
+		}
+	
+	}
+	
+	
+	const CodePointRecord * Locale::GetRecord (CodePoint cp) const noexcept {
+	
+		auto end=Records.end();
 		auto iter=BinarySearch(
-			Info.begin(),
+			Records.begin(),
 			end,
 			cp,
-			[] (const CodePointInfo & a, CodePoint b) noexcept {	return a.CodePoint<b;	},
-			[] (const CodePointInfo & a, CodePoint b) noexcept {	return a.CodePoint==b;	}
+			[] (const CodePointRecord & a, CodePoint b) noexcept {	return a.Last<b;	},
+			[] (const CodePointRecord & a, CodePoint b) noexcept {	return a.CodePoint<=b;	}
 		);
 		
 		return (iter==end) ? nullptr : iter;
 	
 	}
+	
+	
+	//	Short names of jamo, see section 3.12 of The
+	//	Unicode Standard
+	static const char * const jamo_l []={
+		"G","GG","N","D","DD","R","M","B","BB",
+		"S","SS","","J","JJ","C","K","T","P","H"
+	};
+	static const char * const jamo_v []={
+		"A","AE","YA","YAE","EO","E","YEO","YE","O",
+		"WA","WAE","OE","YO","U","WEO","WE","WI",
+		"YU","EU","YI","I"
+	};
+	static const char * const jamo_t []={
+		"","G","GG","GS","N","NJ","NH","D","L","LG",
+		"LM","LB","LS","LT","LP","LH","M","B","BS",
+		"S","SS","NG","J","C","K","T","P","H"
+	};
+	
+	
+	std::string Locale::GetName (CodePoint cp) const {
+	
+		std::string retr;
+		
+		//	Hangul syllable names are derived from the
+		//	short names of their jamo
+		if (Hangul::IsSyllable(cp)) {
+		
+			CodePoint::Type s_index=cp-Hangul::SBase;
+			retr="HANGUL SYLLABLE ";
+			retr+=jamo_l[s_index/Hangul::NCount];
+			retr+=jamo_v[(s_index%Hangul::NCount)/Hangul::TCount];
+			retr+=jamo_t[s_index%Hangul::TCount];
+			
+			return retr;
+		
+		}
+		
+		auto record=GetRecord(cp);
+		if ((record==nullptr) || (record->Name>=Names.Size)) return retr;
+		
+		retr=&Names[record->Name];
+		
+		//	No name ends with a hyphen, so a name which
+		//	does is a prefix to which the code point is
+		//	appended
+		if ((retr.size()==0) || (retr.back()!='-')) return retr;
+		
+		const char * digits="0123456789ABCDEF";
+		std::string hex;
+		for (CodePoint::Type i=cp;i!=0;i>>=4) hex.insert(hex.begin(),digits[i&15]);
+		if (hex.size()<4) hex.insert(hex.begin(),4-hex.size(),'0');
+		
+		return retr+hex;
+	
+	}
+	
+	
+	static std::uint16_t find (const Array<const char *> & names, const char * name) noexcept {
+	
+		for (std::size_t i=1;i<names.Size;++i) if (std::strcmp(names[i],name)==0) return static_cast<std::uint16_t>(i);
+		
+		return 0;
+	
+	}
+	
+	
+	std::uint16_t Locale::FindBlock (const char * name) const noexcept {
+	
+		return find(BlockNames,name);
+	
+	}
+	
+	
+	std::uint16_t Locale::FindScript (const char * name) const noexcept {
+	
+		return find(ScriptNames,name);
+	
+	}
+	
+	
+	template <typename T, std::size_t Bits, typename U>
+	static T get_property (const Locale & locale, const PackedArray<Bits> & table, U (CodePointInfo::* member), CodePoint cp, T def) noexcept {
+	
+		if (!(table.IsEmpty() || locale.InfoIndex.IsEmpty())) {
+		
+			auto offset=locale.InfoIndex.Offset(cp);
+			
+			return (offset==locale.InfoIndex.Indices.Size) ? def : static_cast<T>(table[offset]);
+		
+		}
+		
+		auto cpi=locale.GetInfo(cp);
+		
+		return (cpi==nullptr) ? def : static_cast<T>(cpi->*member);
+	
+	}
+	
+	
+	template <typename T, typename U>
+	static void get_member (const Locale & locale, U (CodePointInfo::* member), const CodePoint * begin, const CodePoint * end, T * out, T def) noexcept {
+	
+		//	Looks up information in batches, so that lookups
+		//	may share work
+		constexpr std::size_t batch=64;
+		const CodePointInfo * info [batch];
+		while (begin!=end) {
+		
+			std::size_t count=end-begin;
+			if (count>batch) count=batch;
+			
+			locale.GetInfo(begin,begin+count,info);
+			for (std::size_t i=0;i<count;++i) out[i]=(info[i]==nullptr) ? def : static_cast<T>(info[i]->*member);
+			
+			begin+=count;
+			out+=count;
+		
+		}
+	
+	}
+	
+	
+	template <typename T, std::size_t Bits, typename U>
+	static void get_property (const Locale & locale, const PackedArray<Bits> & table, U (CodePointInfo::* member), const CodePoint * begin, const CodePoint * end, T * out, T def) noexcept {
+	
+		if (!(table.IsEmpty() || locale.InfoIndex.IsEmpty())) {
+		
+			OffsetCache cache(locale.InfoIndex);
+			for (;begin!=end;++begin,++out) {
+			
+				auto offset=cache.Get(*begin);
+				*out=(offset==locale.InfoIndex.Indices.Size) ? def : static_cast<T>(table[offset]);
+			
+			}
+			
+			return;
+		
+		}
+		
+		get_member(locale,member,begin,end,out,def);
+	
+	}
+	
+	
+	std::size_t Locale::GetCanonicalCombiningClass (CodePoint cp) const noexcept {
+	
+		return get_property(
+			*this,
+			Properties.CanonicalCombiningClass,
+			&CodePointInfo::CanonicalCombiningClass,
+			cp,
+			std::size_t(0)
+		);
+	
+	}
+	
+	
+	void Locale::GetCanonicalCombiningClass (const CodePoint * begin, const CodePoint * end, std::size_t * out) const noexcept {
+	
+		get_property(
+			*this,
+			Properties.CanonicalCombiningClass,
+			&CodePointInfo::CanonicalCombiningClass,
+			begin,
+			end,
+			out,
+			std::size_t(0)
+		);
+	
+	}
+	
+	
+	GeneralCategory Locale::GetGeneralCategory (CodePoint cp) const noexcept {
+	
+		return get_property(
+			*this,
+			Properties.GeneralCategory,
+			&CodePointInfo::GeneralCategory,
+			cp,
+			GeneralCategory::Cn
+		);
+	
+	}
+	
+	
+	void Locale::GetGeneralCategory (const CodePoint * begin, const CodePoint * end, GeneralCategory * out) const noexcept {
+	
+		get_property(
+			*this,
+			Properties.GeneralCategory,
+			&CodePointInfo::GeneralCategory,
+			begin,
+			end,
+			out,
+			GeneralCategory::Cn
+		);
+	
+	}
+	
+	
+	GraphemeClusterBreak Locale::GetGraphemeClusterBreak (CodePoint cp) const noexcept {
+	
+		return get_property(
+			*this,
+			Properties.GraphemeClusterBreak,
+			&CodePointInfo::GraphemeClusterBreak,
+			cp,
+			GraphemeClusterBreak::XX
+		);
+	
+	}
+	
+	
+	void Locale::GetGraphemeClusterBreak (const CodePoint * begin, const CodePoint * end, GraphemeClusterBreak * out) const noexcept {
+	
+		get_property(
+			*this,
+			Properties.GraphemeClusterBreak,
+			&CodePointInfo::GraphemeClusterBreak,
+			begin,
+			end,
+			out,
+			GraphemeClusterBreak::XX
+		);
+	
+	}
+	
+	
+	WordBreak Locale::GetWordBreak (CodePoint cp) const noexcept {
+	
+		return get_property(
+			*this,
+			Properties.WordBreak,
+			&CodePointInfo::WordBreak,
+			cp,
+			WordBreak::XX
+		);
+	
+	}
+	
+	
+	void Locale::GetWordBreak (const CodePoint * begin, const CodePoint * end, WordBreak * out) const noexcept {
+	
+		get_property(
+			*this,
+			Properties.WordBreak,
+			&CodePointInfo::WordBreak,
+			begin,
+			end,
+			out,
+			WordBreak::XX
+		);
+	
+	}
+	
+	
+	LineBreak Locale::GetLineBreak (CodePoint cp) const noexcept {
+	
+		return get_property(
+			*this,
+			Properties.LineBreak,
+			&CodePointInfo::LineBreak,
+			cp,
+			LineBreak::XX
+		);
+	
+	}
+	
+	
+	void Locale::GetLineBreak (const CodePoint * begin, const CodePoint * end, LineBreak * out) const noexcept {
+	
+		get_property(
+			*this,
+			Properties.LineBreak,
+			&CodePointInfo::LineBreak,
+			begin,
+			end,
+			out,
+			LineBreak::XX
+		);
+	
+	}
+	
+	
+	QuickCheck Locale::GetNFCQuickCheck (CodePoint cp) const noexcept {
+	
+		return get_property(
+			*this,
+			Properties.NFCQuickCheck,
+			&CodePointInfo::NFCQuickCheck,
+			cp,
+			QuickCheck::Yes
+		);
+	
+	}
+	
+	
+	void Locale::GetNFCQuickCheck (const CodePoint * begin, const CodePoint * end, QuickCheck * out) const noexcept {
+	
+		get_property(
+			*this,
+			Properties.NFCQuickCheck,
+			&CodePointInfo::NFCQuickCheck,
+			begin,
+			end,
+			out,
+			QuickCheck::Yes
+		);
+	
+	}
+	
+	
+	QuickCheck Locale::GetNFDQuickCheck (CodePoint cp) const noexcept {
+	
+		return get_property(
+			*this,
+			Properties.NFDQuickCheck,
+			&CodePointInfo::NFDQuickCheck,
+			cp,
+			QuickCheck::Yes
+		);
+	
+	}
+	
+	
+	void Locale::GetNFDQuickCheck (const CodePoint * begin, const CodePoint * end, QuickCheck * out) const noexcept {
+	
+		get_property(
+			*this,
+			Properties.NFDQuickCheck,
+			&CodePointInfo::NFDQuickCheck,
+			begin,
+			end,
+			out,
+			QuickCheck::Yes
+		);
+	
+	}
+	
+	
+	std::uint64_t Locale::GetBinaryProperties (CodePoint cp) const noexcept {
+	
+		auto cpi=GetInfo(cp);
+		
+		return (cpi==nullptr) ? 0 : cpi->Flags;
+	
+	}
+	
+	
+	void Locale::GetBinaryProperties (const CodePoint * begin, const CodePoint * end, std::uint64_t * out) const noexcept {
+	
+		get_member(
+			*this,
+			&CodePointInfo::Flags,
+			begin,
+			end,
+			out,
+			std::uint64_t(0)
+		);
+	
+	}
 
 
 }
@@ -0,0 +1,162 @@
+#include "mappedfile.hpp"
+#include <stdexcept>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+namespace Unicode {
+
+
+	#ifdef _WIN32
+	
+	
+	MappedFile::MappedFile (const char * filename) : data(nullptr), size(0) {
+	
+		auto file=CreateFileA(filename,GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+		if (file==INVALID_HANDLE_VALUE) throw std::runtime_error("Could not open file");
+		
+		//	Pipes and devices cannot be mapped, and have
+		//	no size, so they're read until they end
+		if (GetFileType(file)!=FILE_TYPE_DISK) {
+		
+			unsigned char chunk [65536];
+			for (;;) {
+			
+				DWORD read;
+				if (!ReadFile(file,chunk,sizeof(chunk),&read,nullptr)) {
+				
+					//	The other end of a pipe being closed
+					//	is its end
+					if (GetLastError()==ERROR_BROKEN_PIPE) break;
+					
+					CloseHandle(file);
+					
+					throw std::runtime_error("Could not read file");
+				
+				}
+				
+				if (read==0) break;
+				
+				buffer.insert(buffer.end(),chunk,chunk+read);
+			
+			}
+			CloseHandle(file);
+			size=buffer.size();
+			
+			return;
+		
+		}
+		
+		LARGE_INTEGER s;
+		if (!GetFileSizeEx(file,&s)) {
+		
+			CloseHandle(file);
+			
+			throw std::runtime_error("Could not determine size of file");
+		
+		}
+		size=static_cast<std::size_t>(s.QuadPart);
+		
+		//	Empty files cannot be mapped
+		if (size==0) {
+		
+			CloseHandle(file);
+			
+			return;
+		
+		}
+		
+		auto m=CreateFileMappingA(file,nullptr,PAGE_READONLY,0,0,nullptr);
+		CloseHandle(file);
+		if (m==nullptr) throw std::runtime_error("Could not map file");
+		
+		data=MapViewOfFile(m,FILE_MAP_READ,0,0,0);
+		CloseHandle(m);
+		if (data==nullptr) throw std::runtime_error("Could not map file");
+	
+	}
+	
+	
+	MappedFile::~MappedFile () noexcept {
+	
+		if (data!=nullptr) UnmapViewOfFile(data);
+	
+	}
+	
+	
+	#else
+	
+	
+	MappedFile::MappedFile (const char * filename) : data(nullptr), size(0) {
+	
+		auto fd=open(filename,O_RDONLY);
+		if (fd==-1) throw std::runtime_error("Could not open file");
+		
+		struct stat s;
+		if (fstat(fd,&s)!=0) {
+		
+			close(fd);
+			
+			throw std::runtime_error("Could not determine size of file");
+		
+		}
+		size=static_cast<std::size_t>(s.st_size);
+		
+		//	Pipes and devices cannot be mapped, and files
+		//	such as those in /proc report a size of zero
+		//	whatever they contain, so all of these are read
+		//	until they end (which also takes care of empty
+		//	files, which cannot be mapped)
+		if (!S_ISREG(s.st_mode) || (size==0)) {
+		
+			unsigned char chunk [65536];
+			for (;;) {
+			
+				auto read=::read(fd,chunk,sizeof(chunk));
+				if (read==0) break;
+				if (read<0) {
+				
+					if (errno==EINTR) continue;
+					
+					close(fd);
+					
+					throw std::runtime_error("Could not read file");
+				
+				}
+				
+				buffer.insert(buffer.end(),chunk,chunk+read);
+			
+			}
+			close(fd);
+			size=buffer.size();
+			
+			return;
+		
+		}
+		
+		auto retr=mmap(nullptr,size,PROT_READ,MAP_SHARED,fd,0);
+		close(fd);
+		if (retr==MAP_FAILED) throw std::runtime_error("Could not map file");
+		data=retr;
+	
+	}
+	
+	
+	MappedFile::~MappedFile () noexcept {
+	
+		if (data!=nullptr) munmap(data,size);
+	
+	}
+	
+	
+	#endif
+
+
+}
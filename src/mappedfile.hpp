@@ -0,0 +1,59 @@
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+
+
+namespace Unicode {
+
+
+	//	A file mapped read only into memory, or read
+	//	into a buffer if it cannot be mapped
+	class MappedFile {
+	
+	
+		private:
+		
+		
+			void * data;
+			std::size_t size;
+			std::vector<unsigned char> buffer;
+		
+		
+		public:
+		
+		
+			explicit MappedFile (const char * filename);
+			MappedFile (const MappedFile &) = delete;
+			MappedFile & operator = (const MappedFile &) = delete;
+			~MappedFile () noexcept;
+			
+			
+			const unsigned char * begin () const noexcept {
+			
+				if (data==nullptr) return buffer.data();
+				
+				return static_cast<const unsigned char *>(data);
+			
+			}
+			
+			
+			const unsigned char * end () const noexcept {
+			
+				return begin()+size;
+			
+			}
+			
+			
+			std::size_t Size () const noexcept {
+			
+				return size;
+			
+			}
+	
+	
+	};
+
+
+}
@@ -1,4 +1,5 @@
 #include <unicode/binarysearch.hpp>
+#include <unicode/hangul.hpp>
 #include <unicode/normalizer.hpp>
 #include <algorithm>
 #include <cstddef>
@@ -8,18 +9,29 @@
 namespace Unicode {
 
 
-	QuickCheck Normalizer::is_impl (const CodePoint * begin, const CodePoint * end, QuickCheck (CodePointInfo::* qc)) const noexcept {
-	
+	QuickCheck Normalizer::is_impl (const CodePoint * begin, const CodePoint * end, void (Locale::* qc) (const CodePoint *, const CodePoint *, QuickCheck *) const) const noexcept {
+	
+		//	Properties are retrieved in batches, which is
+		//	much faster than retrieving them one code point
+		//	at a time
+		constexpr std::size_t batch=256;
+		QuickCheck qcs [batch];
+		std::size_t cccs [batch];
+		
 		QuickCheck retr=QuickCheck::Yes;
-		const CodePointInfo * prev=nullptr;
-		for (;begin!=end;++begin) {
+		std::size_t prev=0;
+		while (begin!=end) {
 		
-			auto cpi=begin->GetInfo(locale);
+			std::size_t count=end-begin;
+			if (count>batch) count=batch;
 			
-			if (cpi!=nullptr) {
+			(locale.*qc)(begin,begin+count,qcs);
+			locale.GetCanonicalCombiningClass(begin,begin+count,cccs);
+			
+			for (std::size_t i=0;i<count;++i) {
 			
 				//	Check quick check
-				switch (cpi->*qc) {
+				switch (qcs[i]) {
 				
 					//	No is definite, end at once
 					case QuickCheck::No:
@@ -34,16 +46,18 @@ namespace Unicode {
 				}
 				
 				//	Check that combining marks are ordered
+				auto ccc=cccs[i];
 				if (
-					(cpi->CanonicalCombiningClass!=0) &&
-					(prev!=nullptr) &&
-					(prev->CanonicalCombiningClass!=0) &&
-					(cpi->CanonicalCombiningClass<prev->CanonicalCombiningClass)
+					(ccc!=0) &&
+					(prev!=0) &&
+					(ccc<prev)
 				) return QuickCheck::No;
+				
+				prev=ccc;
 			
 			}
 			
-			prev=cpi;
+			begin+=count;
 		
 		}
 		
@@ -54,6 +68,15 @@ namespace Unicode {
 	
 	void Normalizer::decompose (std::vector<CodePoint> & vec, CodePoint cp) const {
 	
+		//	Hangul syllables decompose algorithmically
+		if (Hangul::IsSyllable(cp)) {
+		
+			Hangul::Decompose(cp,[&] (CodePoint::Type jamo) {	vec.push_back(jamo);	});
+			
+			return;
+		
+		}
+		
 		auto cpi=cp.GetInfo(locale);
 		if (
 			(cpi==nullptr) ||
@@ -88,7 +111,7 @@ namespace Unicode {
 			end,
 			[&] (CodePoint a, CodePoint b) noexcept {
 			
-				return a.GetInfo(locale)->CanonicalCombiningClass<b.GetInfo(locale)->CanonicalCombiningClass;
+				return locale.GetCanonicalCombiningClass(a)<locale.GetCanonicalCombiningClass(b);
 			
 			}
 		);
@@ -101,8 +124,7 @@ namespace Unicode {
 		auto b=begin;
 		for (;begin!=end;++begin) {
 		
-			auto cpi=begin->GetInfo(locale);
-			if (!((cpi==nullptr) || (cpi->CanonicalCombiningClass==0))) continue;
+			if (locale.GetCanonicalCombiningClass(*begin)!=0) continue;
 			
 			if (b!=begin) sort_impl(b,begin);
 			
@@ -208,11 +230,36 @@ namespace Unicode {
 		
 			//	If this code point is a starter, do maintenance
 			//	and continue to next iteration
-			auto cpi=begin->GetInfo(locale);
-			if ((cpi==nullptr) || (cpi->CanonicalCombiningClass==0)) {
+			auto cp_ccc=locale.GetCanonicalCombiningClass(*begin);
+			if (cp_ccc==0) {
 			
+				//	Hangul jamo are starters, and compose
+				//	algorithmically with the starter which
+				//	immediately precedes them (if any)
+				if (retr_starter && ((*retr_starter+1)==pos)) {
+				
+					auto repl=Hangul::Compose(
+						retr ? (*retr)[*retr_starter] : vec[*vec_starter],
+						*begin
+					);
+					if (repl) {
+					
+						//	Copy input array if necessary
+						if (!retr) retr.emplace(vb,begin);
+						
+						(*retr)[*retr_starter]=*repl;
+						
+						continue;
+					
+					}
+				
+				}
+				
 				vec_starter=begin-vb;
 				retr_starter=pos;
+				//	Code points before a starter cannot block
+				//	code points after it
+				ccc=0;
 				
 				goto maintenance;
 			
@@ -221,7 +268,7 @@ namespace Unicode {
 			//	If there's no starter to combine with, or if this
 			//	code point is blocked, do maintenance and continue
 			//	to next iteration
-			if (!vec_starter || (ccc==cpi->CanonicalCombiningClass)) goto maintenance;
+			if (!vec_starter || (ccc==cp_ccc)) goto maintenance;
 
 			{
 			
@@ -240,7 +287,7 @@ namespace Unicode {
 					//	class, because if we unconditionally record it,
 					//	further code points could be blocked by
 					//	a code point which no longer exists
-					ccc=cpi->CanonicalCombiningClass;
+					ccc=cp_ccc;
 					goto maintenance;
 					
 				}
@@ -275,7 +322,7 @@ namespace Unicode {
 		return is_impl(
 			begin,
 			end,
-			&CodePointInfo::NFDQuickCheck
+			&Locale::GetNFDQuickCheck
 		)==QuickCheck::Yes;
 	
 	}
@@ -286,7 +333,7 @@ namespace Unicode {
 		return is_impl(
 			begin,
 			end,
-			&CodePointInfo::NFCQuickCheck
+			&Locale::GetNFCQuickCheck
 		)==QuickCheck::Yes;
 	
 	}
@@ -294,6 +341,10 @@ namespace Unicode {
 	
 	std::vector<CodePoint> Normalizer::ToNFD (const CodePoint * begin, const CodePoint * end) const {
 	
+		//	A string which passes the quick check is
+		//	already normalized
+		if (IsNFD(begin,end)) return std::vector<CodePoint>(begin,end);
+		
 		auto retr=decompose(begin,end);
 		
 		sort(retr.begin(),retr.end());
@@ -305,6 +356,8 @@ namespace Unicode {
 	
 	std::vector<CodePoint> Normalizer::ToNFC (const CodePoint * begin, const CodePoint * end) const {
 	
+		if (IsNFC(begin,end)) return std::vector<CodePoint>(begin,end);
+		
 		return compose(ToNFD(begin,end));
 	
 	}
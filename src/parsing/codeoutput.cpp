@@ -4,7 +4,16 @@
 const NewlineT Newline;
 
 
-CodeOutput::CodeOutput (const std::string & file) : out(file.c_str(),std::ios::out|std::ios::trunc), indent(0), line(false) {	}
+CodeOutput::CodeOutput (const std::string & file) : out(file.c_str(),std::ios::out|std::ios::trunc), capturing(false), indent(0), line(false) {	}
+
+
+std::ostream & CodeOutput::stream () noexcept {
+
+	if (capturing) return captured;
+	
+	return out;
+
+}
 
 
 void CodeOutput::BeginIndent () {
@@ -126,13 +135,30 @@ void CodeOutput::EndArray () {
 }
 
 
+void CodeOutput::BeginCapture () {
+
+	captured.str(std::string());
+	capturing=true;
+
+}
+
+
+std::string CodeOutput::EndCapture () {
+
+	capturing=false;
+	
+	return captured.str();
+
+}
+
+
 CodeOutput & CodeOutput::operator << (const NewlineT &) {
 
 	line=false;
 
-	out << std::endl;
+	stream() << std::endl;
 	
-	for (std::size_t i=0;i<indent;++i) out << "\t";
+	for (std::size_t i=0;i<indent;++i) stream() << "\t";
 	
 	return *this;
 
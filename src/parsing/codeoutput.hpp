@@ -3,6 +3,8 @@
 
 #include <cstddef>
 #include <fstream>
+#include <ostream>
+#include <sstream>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -30,10 +32,15 @@ class CodeOutput {
 	
 	
 		std::fstream out;
+		std::ostringstream captured;
+		bool capturing;
 		std::size_t indent;
 		bool line;
 		
 		
+		std::ostream & stream () noexcept;
+	
+	
 	public:
 	
 	
@@ -65,6 +72,14 @@ class CodeOutput {
 		void EndArray ();
 		
 		
+		//	Causes output to be collected rather than
+		//	written until EndCapture is called
+		void BeginCapture ();
+		//	Stops collecting output and returns everything
+		//	collected since BeginCapture was called
+		std::string EndCapture ();
+		
+		
 		template <typename T>
 		typename std::enable_if<
 			!std::is_same<
@@ -76,7 +91,7 @@ class CodeOutput {
 		
 			line=true;
 		
-			out << std::forward<T>(obj);
+			stream() << std::forward<T>(obj);
 			
 			return *this;
 		
@@ -1,18 +1,24 @@
 #include "ducet.hpp"
 #include <unicode/binarysearch.hpp>
 #include <unicode/data.hpp>
+#include <unicode/datafile.hpp>
+#include <unicode/locale.hpp>
 #include <algorithm>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 
 using namespace Unicode;
 
 
-DUCETParser::DUCETParser (const std::string & in, const std::string & out)
-	:	keys(in.c_str()),
-		out(out)
-{	}
+DUCETParser::DUCETParser (const std::string & in, const std::string & output)
+	:	keys(in.c_str())
+{
+
+	if (output.size()!=0) out.emplace(output);
+
+}
 
 
 [[noreturn]]
@@ -25,18 +31,18 @@ static void bad_line () {
 
 static const CodePointInfo * get (CodePoint::Type cp) noexcept {
 
-	auto arr=Data();
+	auto arr=DataRecords();
 	auto end=arr.end();
 
 	auto iter=BinarySearch(
 		arr.begin(),
 		end,
 		cp,
-		[] (const CodePointInfo & cpi, CodePoint::Type cp) noexcept {	return cpi.CodePoint<cp;	},
-		[] (const CodePointInfo & cpi, CodePoint::Type cp) noexcept {	return cpi.CodePoint==cp;	}
+		[] (const CodePointRecord & r, CodePoint::Type cp) noexcept {	return r.Last<cp;	},
+		[] (const CodePointRecord & r, CodePoint::Type cp) noexcept {	return r.CodePoint<=cp;	}
 	);
 	
-	return (iter==end) ? nullptr : iter;
+	return (iter==end) ? nullptr : &Data()[iter->Info];
 
 }
 
@@ -136,97 +142,97 @@ void DUCETParser::sort () {
 
 void DUCETParser::output (const ::Array & arr, const std::string & str) {
 
-	out << "{";
-	if (arr.Size!=0) out << "&" << str << "[" << arr.Offset << "]," << arr.Size;
-	out << "}";
+	*out << "{";
+	if (arr.Size!=0) *out << "&" << str << "[" << arr.Offset << "]," << arr.Size;
+	*out << "}";
 
 }
 
 
 void DUCETParser::output_cps () {
 
-	out.BeginArray("CodePoint::Type","cps");
+	out->BeginArray("CodePoint::Type","cps");
 	
 	bool first=true;
 	for (auto cp : cps) {
 	
 		if (first) first=false;
-		else out << ",";
+		else *out << ",";
 		
-		out << "0x" << std::hex << cp << std::dec;
+		*out << "0x" << std::hex << cp << std::dec;
 	
 	}
 	
-	out.EndArray();
+	out->EndArray();
 
 }
 
 
 void DUCETParser::output_weights () {
 
-	out.BeginArray("std::uint16_t","weights");
+	out->BeginArray("std::uint16_t","weights");
 	
 	bool first=true;
 	for (auto w : weights) {
 	
 		if (first) first=false;
-		else out << ",";
+		else *out << ",";
 		
-		out << "0x" << std::hex << w << std::dec;
+		*out << "0x" << std::hex << w << std::dec;
 	
 	}
 	
-	out.EndArray();
+	out->EndArray();
 
 }
 
 
 void DUCETParser::output_elements () {
 
-	out.BeginArray("CollationElement","elements");
+	out->BeginArray("CollationElement","elements");
 	
 	bool first=true;
 	for (auto e : elements) {
 	
 		if (first) first=false;
-		else out << ",";
+		else *out << ",";
 		
-		out << "{" << (e.Variable ? "true" : "false") << ",";
+		*out << "{" << (e.Variable ? "true" : "false") << ",";
 		
 		output(weights.Get(e.Weights),"weights");
 		
-		out << "}";
+		*out << "}";
 	
 	}
 	
-	out.EndArray();
+	out->EndArray();
 
 }
 
 
 void DUCETParser::output_table () {
 
-	out.BeginArray("CollationTableEntry","table");
-	out.BeginIndent();
+	out->BeginArray("CollationTableEntry","table");
+	out->BeginIndent();
 	
 	bool first=true;
 	for (auto & entry : entries) {
 	
 		if (first) first=false;
-		else out << "," << Newline;
+		else *out << "," << Newline;
 		
-		out << "{";
+		*out << "{";
 		
 		output(cps.Get(entry.CodePoints),"cps");
-		out << ",";
+		*out << ",";
 		output(elements.Get(entry.CollationElements),"elements");
 		
-		out << "}";
+		*out << "}";
 	
 	}
 	
-	out.EndIndent();
-	out.EndArray();
+	out->EndIndent();
+	out->EndArray();
 
 }
 
@@ -243,27 +249,78 @@ void DUCETParser::Get () {
 void DUCETParser::Output () {
 
 	//	Required headers
-	out.Header("unicode/codepoint.hpp");
-	out.Header("cstdint");
+	out->Header("unicode/codepoint.hpp");
+	out->Header("cstdint");
 	
 	//	Begin the Unicode namespace
-	out.WhiteSpace();
-	out.BeginNamespace("Unicode");
+	out->WhiteSpace();
+	out->BeginNamespace("Unicode");
 	
 	//	Output helper arrays
 	output_cps();
-	out.WhiteSpace();
+	out->WhiteSpace();
 	output_weights();
-	out.WhiteSpace();
+	out->WhiteSpace();
 	output_elements();
 	
-	out.WhiteSpace();
+	out->WhiteSpace();
 	
 	//	Output table
 	output_table();
 	
 	//	Done
-	out.EndNamespace();
-	out.End();
+	out->EndNamespace();
+	out->End();
+
+}
+
+
+void DUCETParser::Write (const std::string & filename, const std::string & version) {
+
+	//	The collation table refers into copies of the
+	//	aggregated arrays, which must outlive it
+	std::vector<CodePoint::Type> cps_vec;
+	for (auto cp : cps) cps_vec.push_back(cp);
+	std::vector<std::uint16_t> weights_vec;
+	for (auto w : weights) weights_vec.push_back(w);
+	
+	std::vector<Unicode::CollationElement> elements_vec;
+	for (auto e : elements) {
+	
+		auto w=weights.Get(e.Weights);
+		elements_vec.push_back(Unicode::CollationElement{
+			e.Variable,
+			Unicode::Array<std::uint16_t>(weights_vec.data()+w.Offset,w.Size)
+		});
+	
+	}
+	
+	std::vector<CollationTableEntry> table;
+	for (auto & entry : entries) {
+	
+		auto c=cps.Get(entry.CodePoints);
+		auto e=elements.Get(entry.CollationElements);
+		table.push_back(CollationTableEntry{
+			Unicode::Array<CodePoint::Type>(cps_vec.data()+c.Offset,c.Size),
+			Unicode::Array<Unicode::CollationElement>(elements_vec.data()+e.Offset,e.Size)
+		});
+	
+	}
+	
+	//	The tables from the Unicode Character Database
+	//	are those generated by bin/data, which this
+	//	program is linked against
+	Locale locale;
+	locale.Info=Data();
+	locale.Records=DataRecords();
+	locale.Names=DataNames();
+	locale.BlockNames=DataBlockNames();
+	locale.ScriptNames=DataScriptNames();
+	locale.InfoIndex=DataIndex();
+	locale.Properties=DataProperties();
+	locale.Compositions=Compositions();
+	locale.CollationTable=Unicode::Array<CollationTableEntry>(table.data(),table.size());
+	
+	DataFile::Write(locale,filename.c_str(),version.c_str());
 
 }
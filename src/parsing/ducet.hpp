@@ -6,6 +6,7 @@
 #include <unicode/codepoint.hpp>
 #include <unicode/ucd.hpp>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -65,7 +66,8 @@ class DUCETParser {
 		Unicode::File keys;
 		
 		
-		CodeOutput out;
+		//	Absent if no C++ source file is to be written
+		std::optional<CodeOutput> out;
 		
 		
 		//	Processes a line from the file
@@ -81,8 +83,8 @@ class DUCETParser {
 		void output_weights ();
 		void output_elements ();
 		void output_table ();
-		
-		
+	
+	
 	public:
 	
 	
@@ -93,6 +95,12 @@ class DUCETParser {
 		
 		
 		void Output ();
+		
+		
+		//	Writes a data file containing the collation
+		//	table and the tables generated from the Unicode
+		//	Character Database
+		void Write (const std::string &, const std::string &);
 
 
 };
@@ -7,15 +7,19 @@ int main (int argc, char ** argv) {
 
 	if (argc<3) {
 	
-		std::cout << "Expected 2 command line arguments, " << (argc-1) << " provided" << std::endl;
+		std::cout << "Expected 2 to 4 command line arguments, " << (argc-1) << " provided" << std::endl;
 		
 		return EXIT_FAILURE;
 	
 	}
 	
+	//	The C++ source file may be omitted by passing
+	//	an empty string when only a data file is wanted
+	std::string source(argv[2]);
+	
 	DUCETParser parser(
 		argv[1],
-		argv[2]
+		source
 	);
 	
 	std::cout << "Reading collation elements table..." << std::endl;
@@ -24,10 +28,24 @@ int main (int argc, char ** argv) {
 	
 	std::cout << "Done!" << std::endl;
 	
-	std::cout << "Writing C++ source file..." << std::endl;
+	if (source.size()!=0) {
+	
+		std::cout << "Writing C++ source file..." << std::endl;
+		
+		parser.Output();
+		
+		std::cout << "Done!" << std::endl;
 	
-	parser.Output();
+	}
 	
-	std::cout << "Done!" << std::endl;
+	if (argc>3) {
+	
+		std::cout << "Writing data file..." << std::endl;
+		
+		parser.Write(argv[3],(argc>4) ? argv[4] : "");
+		
+		std::cout << "Done!" << std::endl;
+	
+	}
 
 }
@@ -4,6 +4,8 @@
 #include "tointeger.hpp"
 #include <algorithm>
 #include <cstdlib>
+#include <iostream>
+#include <map>
 
 
 using namespace Unicode;
@@ -223,6 +225,7 @@ bool Parser::Info::in_range (CodePoint::Type low, CodePoint::Type high) const no
 
 Parser::Info::Info (Unicode::CodePoint::Type cp) noexcept
 	:	CodePoint(cp),
+		Last(cp),
 		WhiteSpace(false),
 		Alphabetic(false),
 		NoncharacterCodePoint(false),
@@ -254,6 +257,7 @@ Parser::Info::Info (Unicode::CodePoint::Type cp) noexcept
 		Math(false),
 		QuotationMark(false),
 		Dash(false),
+		Hyphen(false),
 		STerm(false),
 		TerminalPunctuation(false),
 		Diacritic(false),
@@ -390,7 +394,7 @@ std::vector<Parser::Info>::iterator Parser::lower_bound (CodePoint::Type cp) noe
 		info.begin(),
 		info.end(),
 		cp,
-		[] (const Info & a, CodePoint::Type cp) noexcept {	return a.CodePoint<cp;	}
+		[] (const Info & a, CodePoint::Type cp) noexcept {	return a.Last<cp;	}
 	);
 
 }
@@ -400,7 +404,31 @@ std::vector<Parser::Info>::iterator Parser::find (CodePoint::Type cp) noexcept {
 
 	auto iter=lower_bound(cp);
 	auto end=info.end();
-	return ((iter==end) || (iter->CodePoint!=cp)) ? end : iter;
+	return ((iter==end) || (iter->CodePoint>cp)) ? end : iter;
+
+}
+
+
+void Parser::split (CodePoint::Type cp) {
+
+	auto iter=lower_bound(cp);
+	if ((iter==info.end()) || (iter->CodePoint>=cp)) return;
+	
+	//	The entry begins before cp, and ends at or
+	//	after cp, split it in two
+	Info back(*iter);
+	back.CodePoint=cp;
+	iter->Last=cp-1;
+	
+	info.insert(iter+1,std::move(back));
+
+}
+
+
+void Parser::split (const Range & range) {
+
+	split(range.Low);
+	if (range.High!=CodePoint::Max) split(range.High+1);
 
 }
 
@@ -411,7 +439,7 @@ Parser::Info & Parser::get (CodePoint::Type cp) {
 	
 	if (
 		(iter!=info.end()) &&
-		(iter->CodePoint==cp)
+		(iter->CodePoint<=cp)
 	) return *iter;
 	
 	auto loc=iter-info.begin();
@@ -610,6 +638,22 @@ static std::optional<Numeric> get_numeric (const Line & line) {
 }
 
 
+std::string Parser::get_range_name (const std::string & name) {
+
+	auto starts_with=[&] (const std::string & prefix) {	return name.compare(0,prefix.size(),prefix)==0;	};
+	
+	//	See section 4.8 of The Unicode Standard
+	if (starts_with("<CJK Ideograph")) return "CJK UNIFIED IDEOGRAPH-";
+	if (starts_with("<Tangut Ideograph")) return "TANGUT IDEOGRAPH-";
+	
+	//	Hangul syllable names are derived from their
+	//	decompositions, and surrogates and private use
+	//	code points have no names
+	return std::string();
+
+}
+
+
 void Parser::get_data (const Line & line) {
 
 	//	Verify this line, there must be 15 fields:
@@ -631,13 +675,47 @@ void Parser::get_data (const Line & line) {
 	//	15.	Titlecase mapping (simple)
 	if (line.size()<15) throw std::runtime_error("Bad line in UnicodeData.txt");
 
+	//	Ranges are given by two lines, the first
+	//	of which has a name ending in ", First>",
+	//	and the second of which has a name ending
+	//	in ", Last>" and the same properties
+	auto & name=line[1].Get();
+	auto ends_with=[&] (const std::string & suffix) {
+	
+		return (name.size()>=suffix.size()) && (name.compare(name.size()-suffix.size(),suffix.size(),suffix)==0);
+	
+	};
+	if (ends_with(", First>")) {
+	
+		if (range_first) throw std::runtime_error("Unterminated range in UnicodeData.txt");
+		
+		range_first=get_cp(line[0]);
+		
+		return;
+	
+	}
+	
+	bool is_range=ends_with(", Last>");
+	if (is_range!=static_cast<bool>(range_first)) throw std::runtime_error("Bad range in UnicodeData.txt");
+	
 	//	Get the code point info structure
 	//	for this code point
-	auto & info=get(line[0]);
+	auto & info=get(is_range ? *range_first : get_cp(line[0]));
 	
 	//	Populate
 	
-	info.Name=line[1].Get();
+	if (is_range) {
+	
+		info.Last=get_cp(line[0]);
+		info.Name=get_range_name(name);
+		
+		range_first=std::optional<CodePoint::Type>{};
+	
+	} else {
+	
+		info.Name=name;
+	
+	}
 	
 	info.GeneralCategory=ToEnum(general_category,line[2].Get());
 	
@@ -669,6 +747,8 @@ void Parser::get_data (const Line & line) {
 void Parser::get_data () {
 
 	for (auto & line : data) get_data(line);
+	
+	if (range_first) throw std::runtime_error("Unterminated range in UnicodeData.txt");
 
 }
 
@@ -701,6 +781,41 @@ const std::pair<bool (Parser::Info::*),const char *> Parser::prop_map []={
 };
 
 
+const std::pair<bool (Parser::Info::*),const char *> Parser::flag_map []={
+	{&Info::WhiteSpace,"WhiteSpace"},
+	{&Info::Alphabetic,"Alphabetic"},
+	{&Info::NoncharacterCodePoint,"NoncharacterCodePoint"},
+	{&Info::DefaultIgnorableCodePoint,"DefaultIgnorableCodePoint"},
+	{&Info::Deprecated,"Deprecated"},
+	{&Info::LogicalOrderException,"LogicalOrderException"},
+	{&Info::VariationSelector,"VariationSelector"},
+	{&Info::Uppercase,"Uppercase"},
+	{&Info::Lowercase,"Lowercase"},
+	{&Info::SoftDotted,"SoftDotted"},
+	{&Info::Cased,"Cased"},
+	{&Info::CaseIgnorable,"CaseIgnorable"},
+	{&Info::HexDigit,"HexDigit"},
+	{&Info::ASCIIHexDigit,"ASCIIHexDigit"},
+	{&Info::CompositionExclusion,"CompositionExclusion"},
+	{&Info::FullCompositionExclusion,"FullCompositionExclusion"},
+	{&Info::BidirectionalControl,"BidirectionalControl"},
+	{&Info::Mirrored,"Mirrored"},
+	{&Info::Ideographic,"Ideographic"},
+	{&Info::UnifiedIdeograph,"UnifiedIdeograph"},
+	{&Info::Radical,"Radical"},
+	{&Info::Math,"Math"},
+	{&Info::QuotationMark,"QuotationMark"},
+	{&Info::Dash,"Dash"},
+	{&Info::Hyphen,"Hyphen"},
+	{&Info::STerm,"STerm"},
+	{&Info::TerminalPunctuation,"TerminalPunctuation"},
+	{&Info::Diacritic,"Diacritic"},
+	{&Info::Extender,"Extender"},
+	{&Info::GraphemeBase,"GraphemeBase"},
+	{&Info::GraphemeLink,"GraphemeLink"}
+};
+
+
 void Parser::get_prop_list () {
 
 	foreach(prop_list,2,[&] (Info & info, const Line & line) noexcept {
@@ -752,6 +867,7 @@ void Parser::get_blocks (const Line & line) {
 	if (line.size()<2) throw std::runtime_error("Bad line in Blocks.txt");
 	
 	auto i=get_string(line[1].Get(),blocks,blocks_map);
+	if (i>=0xFFFFU) throw std::runtime_error("Too many blocks in Blocks.txt");
 	
 	auto range=line[0].Range();
 	if (range) {
@@ -787,6 +903,7 @@ void Parser::get_scripts (const Line & line) {
 	if (line.size()<2) throw std::runtime_error("Bad line in Scripts.txt");
 	
 	auto i=get_string(line[1].Get(),scripts,scripts_map);
+	if (i>=0xFFFFU) throw std::runtime_error("Too many scripts in Scripts.txt");
 	
 	auto range=line[0].Range();
 	if (range) {
@@ -814,7 +931,9 @@ void Parser::get_name_aliases (const Line & line) {
 
 	if (line.size()<3) throw std::runtime_error("Bad line in NameAliases.txt");
 	
-	auto iter=find(get_cp(line[0]));
+	auto cp=get_cp(line[0]);
+	split(Range{cp,cp});
+	auto iter=find(cp);
 	if (iter==info.end()) return;
 	
 	auto & alias=line[1].Get();
@@ -888,7 +1007,7 @@ void Parser::get_sentence_break () {
 
 void Parser::get_word_break () {
 
-	foreach(sentence_break,2,[&] (Info & info, const Line & line) {
+	foreach(word_break,2,[&] (Info & info, const Line & line) {
 	
 		info.WordBreak=ToEnum(::word_break,line[1].Get());
 		
@@ -1149,14 +1268,13 @@ void Parser::output_cps () {
 
 void Parser::output_blocks () {
 
+	//	Code points not in any block have block zero
 	out.BeginArray("char *","blocks");
 	out.BeginIndent();
-	bool first=true;
+	out << "nullptr";
 	for (auto & block : blocks) {
 	
-		if (first) first=false;
-		else out << "," << Newline;
-		
+		out << "," << Newline;
 		output(block);
 	
 	}
@@ -1168,14 +1286,13 @@ void Parser::output_blocks () {
 
 void Parser::output_scripts () {
 
+	//	Code points with no script have script zero
 	out.BeginArray("char *","scripts");
 	out.BeginIndent();
-	bool first=true;
+	out << "nullptr";
 	for (auto & script : scripts) {
 		
-		if (first) first=false;
-		else out << "," << Newline;
-		
+		out << "," << Newline;
 		output(script);
 		
 	}
@@ -1223,60 +1340,45 @@ void Parser::output_arrays () {
 }
 
 
+void Parser::output_flags (const Info & info) {
+
+	bool first=true;
+	for (auto & pair : flag_map) if (info.*(pair.first)) {
+	
+		if (first) first=false;
+		else out << "|";
+		
+		out << "BinaryProperty::" << pair.second;
+	
+	}
+	
+	if (first) out << "0";
+
+}
+
+
 void Parser::output_code_point_info_inner (const Info & info) {
 
 	//	Get casing information for this
 	//	code point
 	auto casing_info=casing.Get(info.CodePoint);
 	
-	output(info.CodePoint);
-	next();
-
-	output(info.Name);
-	next();
-	
 	output(info.Alias);
 	next();
 	
 	output(info.Abbreviation);
 	next();
 	
-	if (info.Block) out << "blocks[" << *info.Block << "]";
-	else out << "nullptr";
+	out << (info.Block ? (*info.Block+1) : 0);
 	next();
 	
 	out << "GeneralCategory::" << from_enum(general_category,info.GeneralCategory);
 	next();
 	
-	if (info.Script) out << "scripts[" << *info.Script << "]";
-	else out << "nullptr";
-	next();
-	
-	output(info.WhiteSpace);
-	next();
-	
-	output(info.Alphabetic);
+	out << (info.Script ? (*info.Script+1) : 0);
 	next();
 	
-	output(info.NoncharacterCodePoint);
-	next();
-	
-	output(info.DefaultIgnorableCodePoint);
-	next();
-	
-	output(info.Deprecated);
-	next();
-	
-	output(info.LogicalOrderException);
-	next();
-	
-	output(info.VariationSelector);
-	next();
-	
-	output(info.Uppercase);
-	next();
-	
-	output(info.Lowercase);
+	output_flags(info);
 	next();
 	
 	auto str="mappings";
@@ -1305,24 +1407,9 @@ void Parser::output_code_point_info_inner (const Info & info) {
 	output(casing_info.SimpleCaseFolding);
 	next();
 	
-	output(info.SoftDotted);
-	next();
-	
-	output(info.Cased);
-	next();
-	
-	output(info.CaseIgnorable);
-	next();
-	
 	output(info.Numeric);
 	next();
 	
-	output(info.HexDigit);
-	next();
-	
-	output(info.ASCIIHexDigit);
-	next();
-	
 	out << info.CanonicalCombiningClass;
 	next();
 	
@@ -1332,12 +1419,6 @@ void Parser::output_code_point_info_inner (const Info & info) {
 	);
 	next();
 	
-	output(info.CompositionExclusion);
-	next();
-	
-	output(info.FullCompositionExclusion);
-	next();
-	
 	out << "QuickCheck::" << from_enum(quick_check,info.NFCQuickCheck);
 	next();
 	
@@ -1357,85 +1438,276 @@ void Parser::output_code_point_info_inner (const Info & info) {
 	next();
 	
 	out << "BidirectionalClass::" << from_enum(bidi_class,info.BidirectionalClass);
-	next();
+
+}
+
+
+void Parser::output_code_point_info (const Info & info) {
+
+	out << "{";
+	out.BeginIndent();
 	
-	output(info.BidirectionalControl);
-	next();
+	output_code_point_info_inner(info);
 	
-	output(info.Mirrored);
-	next();
+	out.EndIndent();
+	out << "}";
+
+}
+
+
+void Parser::output_code_point_info () {
+
+	out.BeginArray("CodePointInfo","info");
+	out.BeginIndent();
 	
-	output(info.Ideographic);
-	next();
+	//	Entries are identical in all their properties
+	//	exactly when the code output for them is
+	//	identical
+	std::unordered_map<std::string,std::uint16_t> unique;
+	shapes.clear();
+	shape_entries.clear();
+	for (std::size_t i=0;i<info.size();++i) {
+	
+		out.BeginCapture();
+		output_code_point_info(info[i]);
+		auto code=out.EndCapture();
+		
+		auto pair=unique.emplace(std::move(code),static_cast<std::uint16_t>(unique.size()));
+		shapes.push_back(pair.first->second);
+		if (!pair.second) continue;
+		
+		//	Indices must fit in the second stage of
+		//	the index without colliding with the
+		//	sentinel
+		if (shape_entries.size()>=CodePointIndex::None) throw std::runtime_error("Too many CodePointInfo structures to index");
+		
+		if (shape_entries.size()!=0) out << "," << Newline;
+		out << pair.first->first;
+		
+		shape_entries.push_back(i);
 	
-	output(info.UnifiedIdeograph);
-	next();
+	}
 	
-	output(info.Radical);
-	next();
+	out.EndIndent();
+	out.EndArray();
+
+}
+
+
+void Parser::output_names () {
+
+	//	The empty string is first so that all entries
+	//	without names share it, prefixes of names which
+	//	are derived algorithmically are also shared
+	names.assign(1,'\0');
+	std::unordered_map<std::string,std::uint32_t> unique{{std::string(),0}};
+	name_offsets.clear();
+	for (auto & i : info) {
 	
-	output(info.Math);
-	next();
+		auto pair=unique.emplace(i.Name,static_cast<std::uint32_t>(names.size()));
+		if (pair.second) {
+		
+			names.insert(names.end(),i.Name.begin(),i.Name.end());
+			names.push_back('\0');
+		
+		}
+		
+		name_offsets.push_back(pair.first->second);
 	
-	output(info.QuotationMark);
-	next();
+	}
 	
-	output(info.Dash);
-	next();
+	out.WhiteSpace();
+	output(names,"char","names");
+
+}
+
+
+void Parser::output_record (std::size_t i) {
+
+	out << "{";
+	output(info[i].CodePoint);
+	out << ",";
+	output(info[i].Last);
+	out << ",";
+	output(name_offsets[i]);
+	out << ",";
+	output(shapes[i]);
+	out << "}";
+
+}
+
+
+void Parser::output_records () {
+
+	out.BeginArray("CodePointRecord","info_records");
+	out.BeginIndent();
 	
-	output(info.Hyphen);
-	next();
+	for (std::size_t i=0;i<info.size();++i) {
 	
-	output(info.STerm);
-	next();
+		if (i!=0) out << "," << Newline;
+		
+		output_record(i);
 	
-	output(info.TerminalPunctuation);
-	next();
+	}
 	
-	output(info.Diacritic);
-	next();
+	out.EndIndent();
+	out.EndArray();
+
+}
+
+
+void Parser::output_latin1 () {
+
+	out.BeginArray("CodePointInfo *","info_latin1");
+	out.BeginIndent();
 	
-	output(info.Extender);
-	next();
+	for (CodePoint::Type cp=0;cp<256;++cp) {
 	
-	output(info.GraphemeBase);
-	next();
+		if (cp!=0) out << "," << Newline;
+		
+		auto iter=find(cp);
+		if (iter==info.end()) out << "nullptr";
+		else out << "&info[" << shapes[iter-info.begin()] << "]";
+	
+	}
 	
-	output(info.GraphemeLink);
+	out.EndIndent();
+	out.EndArray();
 
 }
 
 
-void Parser::output_code_point_info (const Info & info) {
+template <typename T>
+void Parser::output (const std::vector<T> & vec, const std::string & type, const std::string & name) {
 
-	out << "{";
+	out.BeginArray(type,name);
 	out.BeginIndent();
 	
-	output_code_point_info_inner(info);
+	for (std::size_t i=0;i<vec.size();++i) {
+	
+		if (i!=0) {
+		
+			out << ",";
+			//	Keep lines to a manageable length
+			if ((i%16)==0) out << Newline;
+		
+		}
+		
+		//	Widen so that bytes aren't output as
+		//	characters
+		output(static_cast<std::size_t>(vec[i]));
+	
+	}
 	
 	out.EndIndent();
-	out << "}";
+	out.EndArray();
 
 }
 
 
-void Parser::output_code_point_info () {
+template <typename T>
+void Parser::output_property (const std::vector<std::uint16_t> & indices, T (Info::* member), T def, std::size_t bits, const std::string & name) {
 
-	out.BeginArray("CodePointInfo","info");
-	out.BeginIndent();
+	std::size_t per=8/bits;
+	std::vector<std::uint8_t> packed((indices.size()+per-1)/per,0);
+	for (std::size_t i=0;i<indices.size();++i) {
+	
+		auto index=indices[i];
+		auto value=static_cast<std::size_t>(
+			(index==CodePointIndex::None) ? def : (info[shape_entries[index]].*member)
+		);
+		if (value>=(static_cast<std::size_t>(1)<<bits)) throw std::runtime_error("Property value does not fit in packed table");
+		
+		packed[i/per]|=static_cast<std::uint8_t>(value<<((i%per)*bits));
+	
+	}
+	
+	out.WhiteSpace();
+	output(packed,"std::uint8_t",name);
 
-	bool first=true;
+}
+
+
+void Parser::output_statistics (std::size_t blocks, std::size_t indices) const {
+
+	std::size_t cps=0;
+	std::size_t ranges=0;
 	for (auto & i : info) {
 	
-		if (first) first=false;
-		else out << "," << Newline;
+		cps+=i.Last-i.CodePoint+1;
+		if (i.Last!=i.CodePoint) ++ranges;
+	
+	}
+	
+	std::cout	<<	"CodePointRecord structures: " << info.size()
+				<<	" (" << ranges << " ranges) describing "
+				<<	cps << " code points, "
+				<<	(info.size()*sizeof(CodePointRecord)) << " bytes" << std::endl;
+	std::cout	<<	"CodePointInfo structures: " << shape_entries.size() << ", "
+				<<	(shape_entries.size()*sizeof(CodePointInfo)) << " bytes" << std::endl;
+	std::cout	<<	"Names: " << names.size() << " bytes" << std::endl;
+	std::cout	<<	"Index: " << blocks << " first stage entries, "
+				<<	indices << " second stage entries, "
+				<<	((blocks+indices)*sizeof(std::uint16_t)) << " bytes" << std::endl;
+
+}
+
+
+void Parser::output_index () {
+
+	constexpr std::size_t size=static_cast<std::size_t>(1)<<CodePointIndex::Shift;
+	
+	std::vector<std::uint16_t> blocks;
+	std::vector<std::uint16_t> indices;
+	//	Maps the contents of a block to its position
+	//	in the second stage so identical blocks are
+	//	only output once
+	std::map<std::vector<std::uint16_t>,std::uint16_t> unique;
+	
+	std::vector<std::uint16_t> block(size);
+	auto iter=info.begin();
+	auto end=info.end();
+	for (std::size_t base=0;base<=CodePoint::Max;base+=size) {
+	
+		for (std::size_t i=0;i<size;++i) {
 		
-		output_code_point_info(i);
+			if ((iter!=end) && (iter->CodePoint<=(base+i))) {
+			
+				block[i]=shapes[iter-info.begin()];
+				if (iter->Last==(base+i)) ++iter;
+			
+			} else {
+			
+				block[i]=CodePointIndex::None;
+			
+			}
+		
+		}
+		
+		auto pair=unique.emplace(block,static_cast<std::uint16_t>(unique.size()));
+		if (pair.second) indices.insert(indices.end(),block.begin(),block.end());
+		
+		blocks.push_back(pair.first->second);
 	
 	}
 	
-	out.EndIndent();
-	out.EndArray();
+	output_statistics(blocks.size(),indices.size());
+	
+	output(blocks,"std::uint16_t","info_blocks");
+	out.WhiteSpace();
+	
+	output(indices,"std::uint16_t","info_indices");
+	
+	//	Output packed tables of frequently accessed
+	//	properties, which are parallel to the second
+	//	stage
+	output_property(indices,&Info::CanonicalCombiningClass,std::size_t(0),8,"packed_ccc");
+	output_property(indices,&Info::GeneralCategory,GeneralCategory::Cn,8,"packed_gc");
+	output_property(indices,&Info::GraphemeClusterBreak,GraphemeClusterBreak::XX,4,"packed_gcb");
+	output_property(indices,&Info::WordBreak,WordBreak::XX,8,"packed_wb");
+	output_property(indices,&Info::LineBreak,LineBreak::XX,8,"packed_lb");
+	output_property(indices,&Info::NFCQuickCheck,QuickCheck::Yes,2,"packed_nfc_qc");
+	output_property(indices,&Info::NFDQuickCheck,QuickCheck::Yes,2,"packed_nfd_qc");
 
 }
 
@@ -1545,6 +1817,7 @@ void Parser::Output () {
 
 	//	Print out required headers
 	out.Header("unicode/codepoint.hpp");
+	out.Header("cstdint");
 	out.Header("utility");
 	
 	//	Begin the Unicode namespace
@@ -1558,6 +1831,22 @@ void Parser::Output () {
 	//	Output CodePointInfo structures
 	output_code_point_info();
 	
+	//	Output names
+	output_names();
+	
+	//	Output the records which associate code
+	//	points with their names and CodePointInfo
+	//	structures
+	output_records();
+	
+	//	Output the direct lookup table for the
+	//	Latin-1 range
+	output_latin1();
+	
+	//	Output the index into the CodePointInfo
+	//	structures
+	output_index();
+	
 	//	Output compositions
 	output_compositions();
 	
@@ -7,6 +7,7 @@
 #include <unicode/codepoint.hpp>
 #include <unicode/ucd.hpp>
 #include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <stdexcept>
 #include <string>
@@ -42,6 +43,10 @@ class Parser {
 			
 				//	So we can find/identify this structure
 				Unicode::CodePoint::Type CodePoint;
+				//	The last code point this structure
+				//	describes, equal to CodePoint unless
+				//	this structure describes a range
+				Unicode::CodePoint::Type Last;
 			
 			
 				//	General
@@ -137,12 +142,34 @@ class Parser {
 		
 		
 		static const std::pair<bool (Parser::Info::*),const char *> prop_map [];
+		//	Maps members of Info to the BinaryProperty
+		//	constants which represent them
+		static const std::pair<bool (Parser::Info::*),const char *> flag_map [];
 	
 	
 		std::vector<Info> info;
 		std::vector<Composition> comps;
 		
 		
+		//	The CodePointInfo structure output for each
+		//	entry, entries with identical properties
+		//	sharing a structure
+		std::vector<std::uint16_t> shapes;
+		//	An entry with the properties of each
+		//	CodePointInfo structure output
+		std::vector<std::size_t> shape_entries;
+		//	The null terminated names of all entries
+		std::vector<char> names;
+		//	The offset of the name of each entry
+		std::vector<std::uint32_t> name_offsets;
+		
+		
+		//	The first code point of the range whose
+		//	last code point is expected on the next
+		//	line of UnicodeData.txt
+		std::optional<Unicode::CodePoint::Type> range_first;
+		
+		
 		cps_type cps;
 		ArrayAggregator<Unicode::ConditionInfo> conds;
 		
@@ -174,10 +201,19 @@ class Parser {
 		CasingParser casing;
 		
 		
-		//	Gets a lower bound
+		//	Gets a lower bound, i.e. the first entry
+		//	which ends at or after a certain code point
 		std::vector<Info>::iterator lower_bound (Unicode::CodePoint::Type) noexcept;
-		//	Attempts to find an entry
+		//	Attempts to find the entry which contains
+		//	a code point
 		std::vector<Info>::iterator find (Unicode::CodePoint::Type) noexcept;
+		//	Splits the entry which contains a code point
+		//	(if any) such that an entry begins at that
+		//	code point
+		void split (Unicode::CodePoint::Type);
+		//	Splits entries such that no entry is partially
+		//	within a range
+		void split (const Unicode::Range &);
 		//	Gets an entry
 		Info & get (Unicode::CodePoint::Type);
 		//	Gets a code point from an item, throwing if it
@@ -194,6 +230,13 @@ class Parser {
 			Args &&... args
 		) noexcept(noexcept(callback(std::declval<Info &>(),std::forward<Args>(args)...))) {
 		
+			//	Entries which describe ranges of code
+			//	points may only be partially within
+			//	this range, in which case they must be
+			//	split so properties are only applied
+			//	to the code points within this range
+			split(range);
+			
 			auto iter=lower_bound(range.Low);
 			
 			for (
@@ -222,10 +265,8 @@ class Parser {
 				
 				}
 				
-				auto iter=find(get_cp(line[0]));
-				if (iter==info.end()) continue;
-				
-				callback(*iter,line);
+				auto cp=get_cp(line[0]);
+				foreach(Unicode::Range{cp,cp},callback,line);
 			
 			}
 		
@@ -234,6 +275,9 @@ class Parser {
 		
 		//	Gets a decomposition mapping
 		cps_key get_decomposition_mapping (const Unicode::Item &);
+		//	Gets the name prefix for a range from the
+		//	name given for it in UnicodeData.txt
+		static std::string get_range_name (const std::string &);
 		//	Gets an individual line from UnicodeData.txt
 		void get_data (const Unicode::Line &);
 		//	Gets data from UnicodeData.txt
@@ -355,12 +399,43 @@ class Parser {
 		void output_arrays();
 		
 		
+		//	Outputs the binary properties of a CodePointInfo
+		//	object
+		void output_flags (const Info &);
 		//	Outputs a CodePointInfo object
 		void output_code_point_info_inner (const Info &);
 		//	Outputs an entry
 		void output_code_point_info (const Info &);
-		//	Outputs CodePointInfo structures
+		//	Outputs CodePointInfo structures, only
+		//	outputting one for each distinct set of
+		//	properties
 		void output_code_point_info ();
+		//	Outputs the names of all entries
+		void output_names ();
+		//	Outputs a CodePointRecord object
+		void output_record (std::size_t);
+		//	Outputs CodePointRecord structures
+		void output_records ();
+		//	Outputs pointers to the CodePointInfo
+		//	structures for the Latin-1 range
+		void output_latin1 ();
+		
+		
+		//	Outputs an array of integers
+		template <typename T>
+		void output (const std::vector<T> &, const std::string &, const std::string &);
+		//	Outputs a table of some property parallel to
+		//	the second stage of the index, packing each
+		//	value into a certain number of bits
+		template <typename T>
+		void output_property (const std::vector<std::uint16_t> &, T (Info::*), T, std::size_t, const std::string &);
+		//	Outputs statistics about the generated tables
+		void output_statistics (std::size_t, std::size_t) const;
+		//	Outputs the two stage index which maps
+		//	code points to CodePointInfo structures, and
+		//	the packed property tables which share its
+		//	first stage
+		void output_index ();
 		
 		
 		//	Outputs a single composition
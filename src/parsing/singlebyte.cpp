@@ -0,0 +1,240 @@
+#include "singlebyte.hpp"
+#include "path.hpp"
+#include <cstddef>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+
+using namespace Unicode;
+
+
+namespace {
+
+
+	class mapping {
+	
+	
+		public:
+		
+		
+			const char * File;
+			const char * Name;
+	
+	
+	};
+
+
+}
+
+
+//	The mapping files, which are named as they are on
+//	unicode.org, and the names given to the arrays
+//	generated from each
+static const mapping mappings []={
+	{"CP1250.TXT","windows_1250"},
+	{"CP1251.TXT","windows_1251"},
+	{"CP1252.TXT","windows_1252"},
+	{"CP1253.TXT","windows_1253"},
+	{"CP1254.TXT","windows_1254"},
+	{"CP1255.TXT","windows_1255"},
+	{"CP1256.TXT","windows_1256"},
+	{"CP1257.TXT","windows_1257"},
+	{"CP1258.TXT","windows_1258"},
+	{"8859-2.TXT","iso_8859_2"},
+	{"8859-3.TXT","iso_8859_3"},
+	{"8859-4.TXT","iso_8859_4"},
+	{"8859-5.TXT","iso_8859_5"},
+	{"8859-6.TXT","iso_8859_6"},
+	{"8859-7.TXT","iso_8859_7"},
+	{"8859-8.TXT","iso_8859_8"},
+	{"8859-9.TXT","iso_8859_9"},
+	{"8859-10.TXT","iso_8859_10"},
+	{"8859-11.TXT","iso_8859_11"},
+	{"8859-13.TXT","iso_8859_13"},
+	{"8859-14.TXT","iso_8859_14"},
+	{"8859-15.TXT","iso_8859_15"},
+	{"8859-16.TXT","iso_8859_16"}
+};
+
+
+SingleByteParser::SingleByteParser (const std::string & in, const std::string & out)
+	:	directory(in),
+		out(out)
+{	}
+
+
+[[noreturn]]
+static void bad_line (const std::string & file) {
+
+	throw std::runtime_error("Bad line in "+file);
+
+}
+
+
+static unsigned long get_integer (const std::string & str, const std::string & file) {
+
+	std::size_t pos;
+	unsigned long retr;
+	try {
+	
+		retr=std::stoul(str,&pos,16);
+	
+	} catch (...) {
+	
+		bad_line(file);
+	
+	}
+	if (pos!=str.size()) bad_line(file);
+	
+	return retr;
+
+}
+
+
+void SingleByteParser::read (Table & table, const std::string & file) {
+
+	std::ifstream in(Join(directory,file));
+	if (!in.is_open()) throw std::runtime_error("Could not open "+file);
+	
+	table.Decode.resize(256);
+	
+	//	Each line is a byte and the code point it
+	//	represents, both in hexadecimal, followed by a
+	//	comment.  Bytes which represent nothing either
+	//	have no code point or don't appear at all.
+	std::string line;
+	while (std::getline(in,line)) {
+	
+		line.erase(std::min(line.find('#'),line.size()));
+		
+		std::istringstream s(line);
+		std::string b;
+		std::string cp;
+		if (!(s >> b)) continue;
+		if (!(s >> cp)) continue;
+		
+		auto byte=get_integer(b,file);
+		auto c=get_integer(cp,file);
+		if ((byte>0xFFU) || (c>CodePoint::Max)) bad_line(file);
+		
+		table.Decode[byte]=static_cast<CodePoint::Type>(c);
+	
+	}
+
+}
+
+
+void SingleByteParser::reverse (Table & table) {
+
+	//	Block zero represents nothing, every byte in it
+	//	is zero and zero only represents U+0000 which is
+	//	never looked up in it
+	table.Blocks.assign(256,0);
+	table.Encode.assign(256,0);
+	
+	for (std::size_t i=0;i<table.Decode.size();++i) {
+	
+		auto & cp=table.Decode[i];
+		if (!cp) continue;
+		
+		if (*cp>0xFFFFU) throw std::runtime_error(table.Name+" maps a byte outside the Basic Multilingual Plane");
+		
+		auto & block=table.Blocks[*cp>>8];
+		if (block==0) {
+		
+			auto n=table.Encode.size()/256;
+			if (n>0xFFU) throw std::runtime_error(table.Name+" requires too many blocks");
+			
+			block=static_cast<unsigned char>(n);
+			table.Encode.resize(table.Encode.size()+256,0);
+		
+		}
+		
+		auto & e=table.Encode[(static_cast<std::size_t>(block)<<8)|(*cp&0xFFU)];
+		
+		//	If several bytes represent the same code point
+		//	it's encoded as the first
+		if (e==0) e=static_cast<unsigned char>(i);
+	
+	}
+
+}
+
+
+void SingleByteParser::Get () {
+
+	for (auto & m : mappings) {
+	
+		Table table;
+		table.Name=m.Name;
+		read(table,m.File);
+		reverse(table);
+		
+		tables.push_back(std::move(table));
+	
+	}
+
+}
+
+
+void SingleByteParser::output (const Table & table) {
+
+	out.BeginArray("CodePoint::Type",table.Name+"_decode");
+	bool first=true;
+	for (auto & cp : table.Decode) {
+	
+		if (first) first=false;
+		else out << ",";
+		
+		if (cp) out << "0x" << std::hex << *cp << std::dec;
+		else out << "SingleByteTable::Unmapped";
+	
+	}
+	out.EndArray();
+	
+	out.BeginArray("unsigned char",table.Name+"_blocks");
+	first=true;
+	for (auto b : table.Blocks) {
+	
+		if (first) first=false;
+		else out << ",";
+		
+		out << static_cast<unsigned int>(b);
+	
+	}
+	out.EndArray();
+	
+	out.BeginArray("unsigned char",table.Name+"_encode");
+	first=true;
+	for (auto b : table.Encode) {
+	
+		if (first) first=false;
+		else out << ",";
+		
+		out << static_cast<unsigned int>(b);
+	
+	}
+	out.EndArray();
+
+}
+
+
+void SingleByteParser::Output () {
+
+	//	Required headers
+	out.Header("unicode/singlebyte.hpp");
+	
+	//	Begin the Unicode namespace
+	out.WhiteSpace();
+	out.BeginNamespace("Unicode");
+	
+	for (auto & table : tables) output(table);
+	
+	//	Done
+	out.EndNamespace();
+	out.End();
+
+}
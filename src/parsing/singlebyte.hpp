@@ -0,0 +1,61 @@
+#pragma once
+
+
+#include "codeoutput.hpp"
+#include <unicode/codepoint.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+class SingleByteParser {
+
+
+	private:
+	
+	
+		class Table {
+		
+		
+			public:
+			
+			
+				std::string Name;
+				std::vector<std::optional<Unicode::CodePoint::Type>> Decode;
+				std::vector<unsigned char> Blocks;
+				std::vector<unsigned char> Encode;
+		
+		
+		};
+		
+		
+		std::string directory;
+		std::vector<Table> tables;
+		
+		
+		CodeOutput out;
+		
+		
+		//	Reads the mapping file for a table
+		void read (Table &, const std::string &);
+		//	Builds the tables used for encoding from
+		//	the table used for decoding
+		void reverse (Table &);
+		
+		
+		void output (const Table &);
+	
+	
+	public:
+	
+	
+		SingleByteParser (const std::string &, const std::string &);
+		
+		
+		void Get ();
+		
+		
+		void Output ();
+
+
+};
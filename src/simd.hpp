@@ -0,0 +1,182 @@
+#pragma once
+
+
+#include <unicode/codepoint.hpp>
+#include <cstddef>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP>=2))
+#define UNICODE_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UNICODE_AVX2
+#include <immintrin.h>
+#endif
+
+
+namespace Unicode {
+
+
+	//	The vectorized kernels treat code points as
+	//	32 bit integers
+	static_assert(sizeof(CodePoint)==4,"CodePoint is not 32 bits");
+	
+	
+	#if defined(UNICODE_SSE2) || defined(UNICODE_AVX2)
+	inline std::size_t count_trailing_zeroes (unsigned int mask) noexcept {
+	
+		#ifdef __GNUC__
+		return static_cast<std::size_t>(__builtin_ctz(mask));
+		#else
+		std::size_t retr=0;
+		for (;(mask&1U)==0;mask>>=1,++retr);
+		
+		return retr;
+		#endif
+	
+	}
+	#endif
+	
+	
+	#ifdef UNICODE_SSE2
+	//	Determines whether sixteen code points are all
+	//	less than some power of two
+	inline bool is_below (__m128i a, __m128i b, __m128i c, __m128i d, CodePoint::Type limit) noexcept {
+	
+		auto all=_mm_or_si128(_mm_or_si128(a,b),_mm_or_si128(c,d));
+		auto mask=_mm_set1_epi32(static_cast<int>(~(limit-1)));
+		
+		return _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all,mask),_mm_setzero_si128()))==0xFFFF;
+	
+	}
+	
+	
+	//	Narrows sixteen code points which are all less
+	//	than 256 to bytes
+	inline void narrow (unsigned char * out, __m128i a, __m128i b, __m128i c, __m128i d) noexcept {
+	
+		//	Every value fits in a signed 16 bit integer and
+		//	an unsigned byte, so neither narrowing saturates
+		_mm_storeu_si128(
+			reinterpret_cast<__m128i *>(out),
+			_mm_packus_epi16(_mm_packs_epi32(a,b),_mm_packs_epi32(c,d))
+		);
+	
+	}
+	
+	
+	//	Widens sixteen bytes to code points
+	inline void widen (CodePoint * out, __m128i v) noexcept {
+	
+		auto zero=_mm_setzero_si128();
+		auto lo=_mm_unpacklo_epi8(v,zero);
+		auto hi=_mm_unpackhi_epi8(v,zero);
+		auto o=reinterpret_cast<__m128i *>(out);
+		_mm_storeu_si128(o,_mm_unpacklo_epi16(lo,zero));
+		_mm_storeu_si128(o+1,_mm_unpackhi_epi16(lo,zero));
+		_mm_storeu_si128(o+2,_mm_unpacklo_epi16(hi,zero));
+		_mm_storeu_si128(o+3,_mm_unpackhi_epi16(hi,zero));
+	
+	}
+	#endif
+	
+	
+	//	Finds the end of the run of code points less than
+	//	some power of two at the beginning of a range of
+	//	code points
+	inline const CodePoint * skip_below (const CodePoint * begin, const CodePoint * end, CodePoint::Type limit) noexcept {
+	
+		#ifdef UNICODE_SSE2
+		for (;(end-begin)>=16;begin+=16) {
+		
+			auto in=reinterpret_cast<const __m128i *>(begin);
+			if (!is_below(
+				_mm_loadu_si128(in),
+				_mm_loadu_si128(in+1),
+				_mm_loadu_si128(in+2),
+				_mm_loadu_si128(in+3),
+				limit
+			)) break;
+		
+		}
+		#endif
+		
+		for (;(begin!=end) && (*begin<limit);++begin);
+		
+		return begin;
+	
+	}
+	
+	
+	//	Narrows code points which are all less than 256
+	//	to bytes
+	inline void narrow (unsigned char * out, const CodePoint * begin, const CodePoint * end) noexcept {
+	
+		#ifdef UNICODE_SSE2
+		for (;(end-begin)>=16;begin+=16,out+=16) {
+		
+			auto in=reinterpret_cast<const __m128i *>(begin);
+			narrow(
+				out,
+				_mm_loadu_si128(in),
+				_mm_loadu_si128(in+1),
+				_mm_loadu_si128(in+2),
+				_mm_loadu_si128(in+3)
+			);
+		
+		}
+		#endif
+		
+		for (;begin!=end;++begin) *(out++)=static_cast<unsigned char>(*begin);
+	
+	}
+	
+	
+	//	Encodes the run of ASCII at the beginning of a
+	//	range of code points
+	inline void encode_ascii (unsigned char * & out, const CodePoint * & begin, const CodePoint * end) noexcept {
+	
+		#ifdef UNICODE_SSE2
+		for (;(end-begin)>=16;begin+=16,out+=16) {
+		
+			auto in=reinterpret_cast<const __m128i *>(begin);
+			auto a=_mm_loadu_si128(in);
+			auto b=_mm_loadu_si128(in+1);
+			auto c=_mm_loadu_si128(in+2);
+			auto d=_mm_loadu_si128(in+3);
+			if (!is_below(a,b,c,d,0x80U)) break;
+			
+			narrow(out,a,b,c,d);
+		
+		}
+		#endif
+		
+		for (;(begin!=end) && (*begin<0x80U);++begin) *(out++)=static_cast<unsigned char>(*begin);
+	
+	}
+	
+	
+	//	Decodes a run of ASCII sixteen bytes at a time,
+	//	stops at the first sixteen bytes which aren't all
+	//	ASCII
+	inline const unsigned char * decode_ascii_blocks (CodePoint * & out, const unsigned char * begin, const unsigned char * limit) noexcept {
+	
+		#ifdef UNICODE_SSE2
+		for (;(limit-begin)>=16;begin+=16,out+=16) {
+		
+			auto v=_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+			if (_mm_movemask_epi8(v)!=0) break;
+			
+			widen(out,v);
+		
+		}
+		#else
+		(void)out;
+		(void)limit;
+		#endif
+		
+		return begin;
+	
+	}
+
+
+}
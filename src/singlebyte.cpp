@@ -0,0 +1,153 @@
+#include <unicode/singlebyte.hpp>
+#include "simd.hpp"
+#include <algorithm>
+#include <cstddef>
+
+
+namespace Unicode {
+
+
+	constexpr CodePoint::Type SingleByteTable::Unmapped;
+	
+	
+	std::optional<unsigned char> SingleByte::get (CodePoint cp) const noexcept {
+	
+		CodePoint::Type c=cp;
+		if (c>0xFFFFU) return std::nullopt;
+		
+		//	Code points which can't be represented are looked
+		//	up in a block which doesn't represent them
+		auto retr=table.Encode[(static_cast<std::size_t>(table.Blocks[c>>8])<<8)|(c&0xFFU)];
+		if (table.Decode[retr]!=c) return std::nullopt;
+		
+		return retr;
+	
+	}
+	
+	
+	void SingleByte::Encoder (std::vector<unsigned char> & buffer, CodePoint cp) const {
+	
+		buffer.push_back(*get(cp));
+	
+	}
+	
+	
+	const CodePoint * SingleByte::BulkCounter (std::size_t & bytes, const CodePoint * begin, const CodePoint * end) const {
+	
+		auto last=begin;
+		while (last!=end) {
+		
+			//	Each code point in a run of ASCII is
+			//	represented by itself
+			if (ascii) {
+			
+				last=skip_below(last,end,0x80U);
+				if (last==end) break;
+			
+			}
+			
+			if (!get(*last)) break;
+			++last;
+		
+		}
+		bytes=static_cast<std::size_t>(last-begin);
+		
+		return last;
+	
+	}
+	
+	
+	void SingleByte::BulkEncoder (unsigned char * out, const CodePoint * begin, const CodePoint * end) const {
+	
+		while (begin!=end) {
+		
+			if (ascii) {
+			
+				encode_ascii(out,begin,end);
+				if (begin==end) break;
+			
+			}
+			
+			*(out++)=*get(*(begin++));
+		
+		}
+	
+	}
+	
+	
+	std::optional<EncodingErrorType> SingleByte::Decoder (CodePoint & cp, const unsigned char * & begin, const unsigned char *, std::optional<Unicode::Endianness>) const {
+	
+		auto c=table.Decode[*begin];
+		if (c==SingleByteTable::Unmapped) return EncodingErrorType::Strict;
+		
+		cp=c;
+		
+		return std::nullopt;
+	
+	}
+	
+	
+	const unsigned char * SingleByte::BulkDecoder (CodePoint * & out, const unsigned char * begin, const unsigned char * limit, const unsigned char *, std::optional<Unicode::Endianness>) const {
+	
+		auto decode=table.Decode;
+		while (begin!=limit) {
+		
+			if (ascii) begin=decode_ascii_blocks(out,begin,limit);
+			
+			//	Whatever couldn't be decoded as ASCII is looked
+			//	up, sixteen bytes' worth before trying again
+			auto last=begin+std::min<std::ptrdiff_t>(limit-begin,16);
+			for (;begin!=last;++begin) {
+			
+				auto cp=decode[*begin];
+				if (cp==SingleByteTable::Unmapped) return begin;
+				
+				*(out++)=cp;
+			
+			}
+		
+		}
+		
+		return begin;
+	
+	}
+	
+	
+	static bool is_ascii_compatible (const SingleByteTable & table) noexcept {
+	
+		for (CodePoint::Type i=0;i<0x80U;++i) if (table.Decode[i]!=i) return false;
+		
+		return true;
+	
+	}
+	
+	
+	SingleByte::SingleByte (const SingleByteTable & table) noexcept
+		:	Encoding(false,false),
+			table(table),
+			ascii(is_ascii_compatible(table))
+	{	}
+	
+	
+	bool SingleByte::CanRepresent (CodePoint cp) const noexcept {
+	
+		return (ascii && (cp<0x80U)) || get(cp);
+	
+	}
+	
+	
+	std::size_t SingleByte::Count (CodePoint cp) const noexcept {
+	
+		return CanRepresent(cp) ? 1 : 0;
+	
+	}
+	
+	
+	std::size_t SingleByte::Size () const noexcept {
+	
+		return sizeof(CodeUnit);
+	
+	}
+
+
+}
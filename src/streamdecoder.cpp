@@ -0,0 +1,161 @@
+#include <unicode/encoding.hpp>
+#include <algorithm>
+
+
+namespace Unicode {
+
+
+	//	Determines whether a range of bytes is too short to
+	//	tell whether or not it begins with a BOM
+	static bool maybe_bom (const ByteOrderMark & bom, const unsigned char * begin, const unsigned char * end) {
+	
+		auto size=static_cast<std::size_t>(end-begin);
+		std::vector<unsigned char> buffer;
+		for (auto order : {Endianness::Big,Endianness::Little}) {
+		
+			buffer.clear();
+			bom.Get(buffer,order);
+			
+			if ((size<buffer.size()) && std::equal(begin,end,buffer.begin())) return true;
+		
+		}
+		
+		return false;
+	
+	}
+	
+	
+	StreamDecoder::StreamDecoder (const Encoding & encoding) noexcept
+		:	encoding(encoding),
+			detected(false),
+			position(0),
+			base(nullptr),
+			base_position(0)
+	{	}
+	
+	
+	void StreamDecoder::Decode (const void * begin, const void * end, std::vector<CodePoint> & cps) {
+	
+		auto b=reinterpret_cast<const unsigned char *>(begin);
+		auto e=reinterpret_cast<const unsigned char *>(end);
+		
+		//	Until whatever was carried from the last chunk is
+		//	complete, bytes are moved from this chunk a few at
+		//	a time, so that it's never copied as a whole
+		while ((b!=e) && !(detected && carry.empty())) {
+		
+			auto size=carry.size();
+			auto n=std::min<std::size_t>(static_cast<std::size_t>(e-b),16);
+			carry.insert(carry.end(),b,b+n);
+			
+			const unsigned char * c=carry.data();
+			auto c_e=c+carry.size();
+			base=c;
+			base_position=position;
+			if (!detected) {
+			
+				if (encoding.DetectBOM && maybe_bom(encoding.BOM(),c,c_e)) {
+				
+					b+=n;
+					
+					continue;
+				
+				}
+				
+				c=encoding.detect(c,c_e,order);
+				detected=true;
+			
+			}
+			
+			const void * ptr=c;
+			encoding.Stream(cps,ptr,c_e,order);
+			auto consumed=static_cast<std::size_t>(reinterpret_cast<const unsigned char *>(ptr)-carry.data());
+			
+			//	If decoding got past the bytes which were carried,
+			//	only the bytes of this chunk which it consumed
+			//	have been dealt with
+			if (consumed>=size) {
+			
+				b+=consumed-size;
+				carry.clear();
+			
+			} else {
+			
+				carry.erase(carry.begin(),carry.begin()+consumed);
+				b+=n;
+			
+			}
+			position+=consumed;
+		
+		}
+		
+		if (!carry.empty()) return;
+		
+		base=b;
+		base_position=position;
+		const void * ptr=b;
+		encoding.Stream(cps,ptr,e,order);
+		auto p=reinterpret_cast<const unsigned char *>(ptr);
+		carry.assign(p,e);
+		position+=static_cast<std::size_t>(p-b);
+	
+	}
+	
+	
+	void StreamDecoder::Finish (std::vector<CodePoint> & cps) {
+	
+		//	The decoder is reset before anything which could
+		//	throw
+		std::vector<unsigned char> bytes;
+		bytes.swap(carry);
+		auto o=order;
+		auto d=detected;
+		auto p=position;
+		Reset();
+		
+		const unsigned char * b=bytes.data();
+		auto e=b+bytes.size();
+		base=b;
+		base_position=p;
+		if (!d) b=encoding.detect(b,e,o);
+		
+		const void * ptr=b;
+		encoding.Stream(cps,ptr,e,o);
+		
+		//	Handle unexpected end
+		if (ptr!=e) {
+		
+			auto repl=encoding.handle(EncodingErrorType::UnexpectedEnd,ptr);
+			
+			if (repl) cps.push_back(*repl);
+		
+		}
+	
+	}
+	
+	
+	void StreamDecoder::Reset () noexcept {
+	
+		carry.clear();
+		order=std::nullopt;
+		detected=false;
+		position=0;
+	
+	}
+	
+	
+	std::size_t StreamDecoder::Pending () const noexcept {
+	
+		return carry.size();
+	
+	}
+	
+	
+	std::size_t StreamDecoder::Offset (const void * where) const noexcept {
+	
+		return base_position+static_cast<std::size_t>(reinterpret_cast<const unsigned char *>(where)-base);
+	
+	}
+
+
+}
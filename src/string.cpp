@@ -8,6 +8,7 @@
 #include <unicode/utf16.hpp>
 #include <unicode/utf32.hpp>
 #include <algorithm>
+#include <cstring>
 #include <stdexcept>
 
 
@@ -22,24 +23,27 @@ namespace Unicode {
 	}
 
 
-	std::vector<unsigned char> String::to_c_string (std::size_t cu_size) const {
+	//	Invokes a callable with the encoding appropriate
+	//	to code units of a certain size
+	template <typename T>
+	static auto with_encoding (std::size_t cu_size, T && func) {
 	
 		switch (cu_size) {
 		
 			//	UTF-8
 			case 1:
-				return UTF8{}.Encode(begin(),end());
+				return func(UTF8{});
 			//	UTF-16
 			case 2:{
 				UTF16 encoder(EndianEncoding::Detect());
 				encoder.OutputBOM=false;
-				return encoder.Encode(begin(),end());
+				return func(encoder);
 			}
 			//	UTF-32
 			case 4:{
 				UTF32 encoder(EndianEncoding::Detect());
 				encoder.OutputBOM=false;
-				return encoder.Encode(begin(),end());
+				return func(encoder);
 			}
 			//	No known encoding
 			default:
@@ -50,6 +54,34 @@ namespace Unicode {
 	}
 	
 	
+	std::vector<unsigned char> String::to_c_string (std::size_t cu_size) const {
+	
+		return with_encoding(cu_size,[&] (const Encoding & encoding) {
+		
+			//	Guess one code unit per code point, plus the
+			//	null terminator CString adds
+			std::vector<unsigned char> retr;
+			retr.reserve((cps.size()+1)*cu_size);
+			encoding.Encode(begin(),end(),retr);
+			
+			return retr;
+		
+		});
+	
+	}
+	
+	
+	std::size_t String::to_c_string (void * out, std::size_t size, std::size_t cu_size) const {
+	
+		return with_encoding(cu_size,[&] (const Encoding & encoding) {
+		
+			return encoding.Encode(begin(),end(),out,size);
+		
+		});
+	
+	}
+	
+	
 	template <typename T>
 	typename std::enable_if<
 		sizeof(T)==1,
@@ -109,6 +141,15 @@ namespace Unicode {
 	}
 	
 	
+	static std::size_t strlen (const unsigned char * str) noexcept {
+	
+		if (str==nullptr) return 0;
+		
+		return std::strlen(reinterpret_cast<const char *>(str));
+	
+	}
+	
+	
 	template <typename T>
 	std::vector<CodePoint> decode (const T * str) {
 	
@@ -150,7 +191,7 @@ namespace Unicode {
 			std::move(end),
 			[&] (CodePoint cp) noexcept {
 			
-				return !cp.IsWhiteSpace();
+				return !cp.IsWhiteSpace(locale);
 			
 			}
 		);
@@ -1,13 +1,19 @@
 #include <unicode/ascii.hpp>
 #include <unicode/binarysearch.hpp>
+#include <unicode/boundaries.hpp>
 #include <unicode/caseconverter.hpp>
 #include <unicode/codepoint.hpp>
+#include <unicode/collator.hpp>
 #include <unicode/comparer.hpp>
 #include <unicode/converter.hpp>
+#include <unicode/datafile.hpp>
+#include <unicode/detectencoding.hpp>
 #include <unicode/iostream.hpp>
 #include <unicode/latin1.hpp>
+#include <unicode/loadfile.hpp>
 #include <unicode/locale.hpp>
 #include <unicode/normalizer.hpp>
+#include <unicode/singlebyte.hpp>
 #include <unicode/string.hpp>
 #include <unicode/ucs2.hpp>
 #include <unicode/ucs4.hpp>
@@ -19,7 +25,9 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <functional>
 #include <iomanip>
 #include <iterator>
@@ -28,8 +36,12 @@
 #include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <thread>
 #include <utility>
 #include <vector>
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
 
 
 namespace Catch {
@@ -280,6 +292,161 @@ std::string Get (const T & t) {
 }
 
 
+//	Encodes code points one at a time
+std::vector<unsigned char> EncodeEach (const Encoding & encoding, const std::vector<CodePoint> & cps) {
+
+	std::vector<unsigned char> retr;
+	for (auto & cp : cps) {
+	
+		auto encoded=encoding.Encode(&cp,&cp+1);
+		retr.insert(retr.end(),encoded.begin(),encoded.end());
+	
+	}
+	
+	return retr;
+
+}
+
+
+//	Decodes a buffer one code point at a time, in the
+//	same manner as Encoding::Decode
+std::vector<CodePoint> DecodeEach (const Encoding & encoding, const void * begin, const void * end) {
+
+	std::vector<CodePoint> retr;
+	for (;;) {
+	
+		auto cp=encoding.Stream(begin,end);
+		if (!cp) break;
+		
+		retr.push_back(*cp);
+	
+	}
+	
+	if (!((begin==end) || encoding.UnexpectedEnd.Ignored())) {
+	
+		auto repl=encoding.UnexpectedEnd.Execute(begin);
+		if (repl) retr.push_back(*repl);
+	
+	}
+	
+	return retr;
+
+}
+
+
+//	Decodes a buffer in chunks of a certain size with
+//	a StreamDecoder
+std::vector<CodePoint> DecodeChunks (const Encoding & encoding, const std::vector<unsigned char> & buffer, std::size_t size) {
+
+	std::vector<CodePoint> retr;
+	StreamDecoder decoder(encoding);
+	for (std::size_t i=0;i<buffer.size();i+=size) {
+	
+		auto begin=Begin(buffer)+i;
+		decoder.Decode(begin,begin+std::min(size,buffer.size()-i),retr);
+	
+	}
+	decoder.Finish(retr);
+	
+	return retr;
+
+}
+
+
+//	Requires that decoding a buffer in bulk raises an
+//	exception exactly when decoding it one code point at
+//	a time does, and otherwise gives the same results
+void RequireDecodesAsEach (const Encoding & encoding, const void * begin, const void * end) {
+
+	std::vector<CodePoint> expected;
+	try {
+	
+		expected=DecodeEach(encoding,begin,end);
+	
+	} catch (const EncodingError &) {
+	
+		REQUIRE_THROWS_AS(encoding.Decode(begin,end),EncodingError);
+		
+		return;
+	
+	}
+	
+	REQUIRE(encoding.Decode(begin,end)==expected);
+
+}
+
+
+//	Writes 16 bit code units in a certain byte order
+//	after a number of padding bytes, so that they may
+//	begin at an odd address
+std::vector<unsigned char> WriteCodeUnits (const std::vector<std::uint16_t> & cus, Endianness order, std::size_t padding) {
+
+	std::vector<unsigned char> retr(padding,0);
+	for (auto cu : cus) {
+	
+		unsigned char b []={static_cast<unsigned char>(cu>>8),static_cast<unsigned char>(cu&255)};
+		if (order==Endianness::Little) std::swap(b[0],b[1]);
+		retr.insert(retr.end(),std::begin(b),std::end(b));
+	
+	}
+	
+	return retr;
+
+}
+
+
+//	Generates short runs of 16 bit code units with a
+//	surrogate pair, a lone lead surrogate, or a lone trail
+//	surrogate at every offset, with lengths on either side
+//	of those decoded a vector at a time
+std::vector<std::vector<std::uint16_t>> SurrogatesAtEdges () {
+
+	std::vector<std::vector<std::uint16_t>> retr;
+	const std::size_t lengths []={7,8,9,15,16,17,23,24,25,31,32,33};
+	const std::vector<std::uint16_t> surrogates []={{0xD83D,0xDE00},{0xD83D},{0xDE00}};
+	for (auto len : lengths) for (auto & s : surrogates) for (std::size_t i=0;(i+s.size())<=len;++i) {
+	
+		std::vector<std::uint16_t> cus(len,'a');
+		std::copy(s.begin(),s.end(),cus.begin()+i);
+		retr.push_back(std::move(cus));
+	
+	}
+	
+	return retr;
+
+}
+
+
+//	Requires that runs of 16 bit code units decode in
+//	bulk as they do one code point at a time in each byte
+//	order, at both even and odd addresses
+void RequireDecodesAsEach (EndianEncoding & encoding, const std::vector<std::vector<std::uint16_t>> & runs) {
+
+	const Endianness orders []={Endianness::Big,Endianness::Little};
+	for (auto order : orders) for (std::size_t padding=0;padding<2;++padding) {
+	
+		encoding.InputOrder=order;
+		for (auto & run : runs) {
+		
+			auto b=WriteCodeUnits(run,order,padding);
+			RequireDecodesAsEach(encoding,Begin(b)+padding,End(b));
+		
+		}
+	
+	}
+
+}
+
+
+//	Writes bytes to a file
+void WriteFile (const char * filename, const std::vector<unsigned char> & buffer) {
+
+	std::ofstream stream(filename,std::ios::binary|std::ios::trunc);
+	stream.write(reinterpret_cast<const char *>(Begin(buffer)),static_cast<std::streamsize>(buffer.size()));
+
+}
+
+
 //
 //	ASCII
 //
@@ -657,6 +824,110 @@ SCENARIO("Elements in a sorted collection may be efficiently located","[binaryse
 }
 
 
+//
+//	BOUNDARIES
+//
+
+
+SCENARIO("Boundaries throughout a string are found identically to boundaries at each location","[boundaries]") {
+
+	GIVEN("A string containing controls, combining marks, Hangul, words, and numbers") {
+	
+		std::vector<CodePoint> s;
+		for (auto c : U"A\u0301b\r\n\u1100\u1161\u11A8 can't \u05D0\"\u05D1 3.14,15 \u30AB\u30AB_x\u2028\r") if (c!=0) s.push_back(c);
+		auto begin=s.data();
+		auto end=begin+s.size();
+		
+		THEN("Grapheme cluster boundaries are found identically") {
+		
+			std::vector<char> found(s.size()+1);
+			FindGraphemeClusterBoundaries(begin,end,reinterpret_cast<bool *>(found.data()));
+			
+			for (std::size_t i=0;i<=s.size();++i) {
+			
+				INFO("At " << i);
+				REQUIRE(static_cast<bool>(found[i])==IsGraphemeClusterBoundary(begin+i,begin,end));
+			
+			}
+			
+			REQUIRE(!found[1]);
+			REQUIRE(found[2]);
+			REQUIRE(!found[4]);
+			REQUIRE(!found[6]);
+		
+		}
+		
+		THEN("Word boundaries are found identically") {
+		
+			std::vector<char> found(s.size()+1);
+			FindWordBoundaries(begin,end,reinterpret_cast<bool *>(found.data()));
+			
+			for (std::size_t i=0;i<=s.size();++i) {
+			
+				INFO("At " << i);
+				REQUIRE(static_cast<bool>(found[i])==IsWordBoundary(begin+i,begin,end));
+			
+			}
+		
+		}
+		
+		THEN("Line breaks are found identically") {
+		
+			std::vector<char> found(s.size()+1);
+			FindLineBreaks(begin,end,reinterpret_cast<bool *>(found.data()));
+			
+			for (std::size_t i=0;i<=s.size();++i) {
+			
+				INFO("At " << i);
+				REQUIRE(static_cast<bool>(found[i])==IsLineBreak(begin+i,begin,end));
+			
+			}
+			
+			REQUIRE(!found[4]);
+			REQUIRE(found[5]);
+			REQUIRE(found[s.size()]);
+		
+		}
+		
+		THEN("Line terminators are found where line breaks follow") {
+		
+			for (std::size_t i=0;i<=s.size();++i) {
+			
+				auto expected=begin+i;
+				for (;(expected!=end) && !((*expected=='\r') || IsLineBreak(expected+1,begin,end));++expected);
+				
+				INFO("From " << i);
+				REQUIRE(FindLineTerminator(begin+i,end)==expected);
+			
+			}
+			
+			REQUIRE(FindLineTerminator(begin,end)==(begin+3));
+		
+		}
+	
+	}
+	
+	GIVEN("An empty string") {
+	
+		std::vector<CodePoint> s;
+		
+		THEN("There is a grapheme cluster boundary and a word boundary, but no line break") {
+		
+			bool found [1];
+			FindGraphemeClusterBoundaries(s.data(),s.data(),found);
+			REQUIRE(found[0]);
+			FindWordBoundaries(s.data(),s.data(),found);
+			REQUIRE(found[0]);
+			FindLineBreaks(s.data(),s.data(),found);
+			REQUIRE(!found[0]);
+		
+		}
+	
+	}
+
+}
+
+
 //
 //	CASE CONVERTER
 //
@@ -1136,6 +1407,54 @@ SCENARIO("Code points may be tested to see if they are white space or not","[cod
 }
 
 
+//
+//	COLLATOR
+//
+
+
+SCENARIO("Code points without collation elements are given implicit weights","[collator]") {
+
+	GIVEN("A collator") {
+	
+		Collator c;
+		auto first=[&] (CodePoint::Type cp) {
+		
+			CodePoint s []={cp};
+			
+			return c.GetSortKey(std::begin(s),std::end(s)).at(0);
+		
+		};
+		
+		THEN("Unified ideographs in the CJK Unified Ideographs block are weighted first") {
+		
+			REQUIRE(first(0x4E00U)==0xFB40U);
+		
+		}
+		
+		THEN("Unified ideographs in the CJK Compatibility Ideographs block are weighted first") {
+		
+			REQUIRE(first(0xFA0EU)==0xFB41U);
+		
+		}
+		
+		THEN("Other unified ideographs are weighted next") {
+		
+			REQUIRE(first(0x3400U)==0xFB80U);
+			REQUIRE(first(0x20000U)==0xFB84U);
+		
+		}
+		
+		THEN("All other code points are weighted last") {
+		
+			REQUIRE(first(0x10FFFDU)==(0xFBC0U+(0x10FFFDU>>15)));
+		
+		}
+	
+	}
+
+}
+
+
 //
 //	COMPARER
 //
@@ -1452,120 +1771,1937 @@ SCENARIO("Strings may be compared case insensitively","[comparer]") {
 
 
 //
-//	FLOATING POINT CONVERSION
+//	DATA FILE
 //
 
 
-SCENARIO("Floating point values may be converted to strings","[converter]") {
+SCENARIO("The tables of a locale may be written to and loaded from data files","[datafile]") {
 
-	GIVEN("A float converter") {
+	GIVEN("The default locale written to a data file") {
 	
-		Converter<float> c;
+		const char * filename="test.dat";
+		DataFile::Write(DefaultLocale,filename,"test");
 		
-		GIVEN("The largest float value") {
+		GIVEN("That data file loaded") {
 		
-			auto f=std::numeric_limits<float>::max();
+			DataFile file(filename);
+			auto & l=file.Locale;
 			
-			GIVEN("A string containing this value") {
+			THEN("Its version is retrieved") {
 			
-				auto s=Get(f);
-				
-				THEN("Converting the former to a Unicode string results in the latter") {
-				
-					REQUIRE(IsEqual(c(f),s));
-				
-				}
+				REQUIRE(std::strcmp(file.Version(),"test")==0U);
 			
 			}
-		
-		}
-		
-		GIVEN("The smallest float value") {
-		
-			auto f=std::numeric_limits<float>::min();
 			
-			GIVEN("A string containing this value") {
+			THEN("Its tables are within the data file") {
 			
-				auto s=Get(f);
-				
-				THEN("Converting the former to a Unicode string results in the latter") {
-				
-					REQUIRE(IsEqual(c(f),s));
-				
-				}
+				CHECK(l.Info.begin()!=DefaultLocale.Info.begin());
+				CHECK(l.Info.size()==DefaultLocale.Info.size());
+				CHECK(l.Records.size()==DefaultLocale.Records.size());
+				CHECK(l.Compositions.size()==DefaultLocale.Compositions.size());
+				REQUIRE(l.CollationTable.size()==DefaultLocale.CollationTable.size());
 			
 			}
-		
-		}
-		
-		GIVEN("The epsilon value") {
-		
-			auto f=std::numeric_limits<float>::epsilon();
 			
-			GIVEN("A string containing this value") {
+			THEN("Every code point has the same name and properties in both locales") {
 			
-				auto s=Get(f);
-				
-				THEN("Converting the former to a Unicode string results in the latter") {
+				CodePoint::Type mismatch=0;
+				bool matched=true;
+				for (CodePoint::Type cp=0;cp<=CodePoint::Max;++cp) {
 				
-					REQUIRE(IsEqual(c(f),s));
+					auto a=DefaultLocale.GetInfo(cp);
+					auto b=l.GetInfo(cp);
+					if (
+						(DefaultLocale.GetName(cp)==l.GetName(cp)) &&
+						(DefaultLocale.GetGraphemeClusterBreak(cp)==l.GetGraphemeClusterBreak(cp)) &&
+						(DefaultLocale.GetWordBreak(cp)==l.GetWordBreak(cp)) &&
+						((a==nullptr)==(b==nullptr)) &&
+						(
+							(a==nullptr) ||
+							(
+								(a->GeneralCategory==b->GeneralCategory) &&
+								(a->CanonicalCombiningClass==b->CanonicalCombiningClass) &&
+								std::equal(
+									a->DecompositionMapping.begin(),
+									a->DecompositionMapping.end(),
+									b->DecompositionMapping.begin(),
+									b->DecompositionMapping.end()
+								) &&
+								(a->LowercaseMappings.size()==b->LowercaseMappings.size()) &&
+								(a->Block==b->Block) &&
+								(a->Script==b->Script) &&
+								(a->Flags==b->Flags)
+							)
+						)
+					) continue;
+					
+					mismatch=cp;
+					matched=false;
+					
+					break;
 				
 				}
+				
+				INFO("Mismatch at " << Catch::toString(CodePoint(mismatch)));
+				REQUIRE(matched);
 			
 			}
-		
-		}
-		
-		GIVEN("The infinity value") {
-		
-			auto f=std::numeric_limits<float>::infinity();
 			
-			GIVEN("A string containing this value") {
+			THEN("Blocks and scripts have the same names in both locales") {
 			
-				auto s=Get(f);
+				auto same=[] (const Array<const char *> & a, const Array<const char *> & b) {
 				
-				THEN("Converting the former to a Unicode string results in the latter") {
+					return std::equal(
+						a.begin(),
+						a.end(),
+						b.begin(),
+						b.end(),
+						[] (const char * a, const char * b) noexcept {
+						
+							return (a==nullptr) ? (b==nullptr) : ((b!=nullptr) && (std::strcmp(a,b)==0));
+						
+						}
+					);
 				
-					REQUIRE(IsEqual(c(f),s));
+				};
 				
-				}
+				REQUIRE(l.BlockNames.begin()!=DefaultLocale.BlockNames.begin());
+				REQUIRE(same(l.BlockNames,DefaultLocale.BlockNames));
+				REQUIRE(same(l.ScriptNames,DefaultLocale.ScriptNames));
 			
 			}
-		
-		}
-		
-		GIVEN("The NaN value") {
-		
-			auto f=std::numeric_limits<float>::quiet_NaN();
-		
-			GIVEN("A string containing this value") {
 			
-				auto s=Get(f);
-				
-				THEN("Converting the former to a Unicode string results in the latter") {
-				
-					REQUIRE(IsEqual(c(f),s));
+			THEN("Strings are normalized, case converted, and collated identically in both locales") {
+			
+				std::vector<CodePoint> s={'S','t','r','a',0xDF,'e',' ',0x130,'I',0x3A3,'a',0x301,0xAC00,0x4E01};
+				std::vector<CodePoint> t={'S','t','r','a','s','s','e'};
+				auto begin=s.data();
+				auto end=begin+s.size();
 				
-				}
+				CHECK(Normalizer(l).ToNFD(begin,end)==Normalizer().ToNFD(begin,end));
+				CHECK(Normalizer(l).ToNFC(begin,end)==Normalizer().ToNFC(begin,end));
+				CHECK(CaseConverter(l).ToUpper(begin,end)==CaseConverter().ToUpper(begin,end));
+				CHECK(CaseConverter(l).ToLower(begin,end)==CaseConverter().ToLower(begin,end));
+				CHECK(CaseConverter(l).Fold(begin,end)==CaseConverter().Fold(begin,end));
+				REQUIRE(
+					Collator(l).GetSortKey(begin,end)==
+					Collator(DefaultLocale).GetSortKey(begin,end)
+				);
+				REQUIRE(
+					Collator(l).Compare(begin,end,t.data(),t.data()+t.size())==
+					Collator(DefaultLocale).Compare(begin,end,t.data(),t.data()+t.size())
+				);
 			
 			}
 		
 		}
+		
+		std::remove(filename);
 	
 	}
-
-}
-
-
-SCENARIO("Strings may be converted to floating point values","[converter]") {
-
-	GIVEN("A float converter") {
 	
-		Converter<float> c;
+	GIVEN("A data file which has been truncated") {
+	
+		const char * filename="test.dat";
+		DataFile::Write(DefaultLocale,filename);
+		std::string bytes;
+		{
 		
-		THEN("The empty string represented as two null pointers is not found to represent an integer") {
+			std::ifstream in(filename,std::ios::binary);
+			bytes.assign(std::istreambuf_iterator<char>(in),std::istreambuf_iterator<char>());
 		
-			REQUIRE_THROWS_AS(c(nullptr,nullptr),ConversionError);
+		}
+		{
+		
+			std::ofstream out(filename,std::ios::binary|std::ios::trunc);
+			out.write(bytes.data(),static_cast<std::streamsize>(bytes.size()/2));
+		
+		}
+		
+		THEN("It cannot be loaded") {
+		
+			REQUIRE_THROWS_AS(DataFile(filename),std::runtime_error);
+		
+		}
+		
+		std::remove(filename);
+	
+	}
+	
+	GIVEN("A data file whose header has been damaged") {
+	
+		const char * filename="test.dat";
+		DataFile::Write(DefaultLocale,filename);
+		
+		THEN("Tables which no longer lie within the file are rejected rather than used") {
+		
+			//	Setting a high bit of each word of the header
+			//	moves a table far outside the file or makes
+			//	it impossibly long
+			std::fstream file(filename,std::ios::in|std::ios::out|std::ios::binary);
+			std::size_t rejected=0;
+			for (std::size_t i=7;i<256;i+=8) {
+			
+				char c;
+				file.seekg(static_cast<std::streamoff>(i));
+				file.read(&c,1);
+				file.seekp(static_cast<std::streamoff>(i));
+				file.put(static_cast<char>(c^0x40));
+				file.flush();
+				
+				try {
+				
+					DataFile damaged(filename);
+				
+				} catch (const std::runtime_error &) {
+				
+					++rejected;
+				
+				}
+				
+				file.seekp(static_cast<std::streamoff>(i));
+				file.put(c);
+				file.flush();
+			
+			}
+			file.close();
+			
+			CHECK(rejected!=0U);
+			DataFile restored(filename);
+			REQUIRE(restored.Locale.GetInfo('A')!=nullptr);
+		
+		}
+		
+		std::remove(filename);
+	
+	}
+	
+	GIVEN("A data file whose tables have been damaged") {
+	
+		const char * filename="test.dat";
+		DataFile::Write(DefaultLocale,filename);
+		std::string bytes;
+		{
+		
+			std::ifstream in(filename,std::ios::binary);
+			bytes.assign(std::istreambuf_iterator<char>(in),std::istreambuf_iterator<char>());
+		
+		}
+		DataFileHeader h;
+		std::memcpy(&h,bytes.data(),sizeof(h));
+		auto offset=[&] (const auto & table) {
+		
+			return static_cast<std::size_t>((reinterpret_cast<const char *>(&table)-reinterpret_cast<const char *>(&h))+table.Offset);
+		
+		};
+		auto write=[&] () {
+		
+			std::ofstream out(filename,std::ios::binary|std::ios::trunc);
+			out.write(bytes.data(),static_cast<std::streamsize>(bytes.size()));
+		
+		};
+		
+		THEN("An index which refers to information which does not exist is rejected") {
+		
+			auto i=static_cast<std::uint16_t>(h.Info.Size);
+			std::memcpy(&bytes[offset(h.Indices)],&i,sizeof(i));
+			write();
+			
+			REQUIRE_THROWS_AS(DataFile(filename),std::runtime_error);
+		
+		}
+		
+		THEN("Records which are out of order are rejected") {
+		
+			REQUIRE(h.Records.Size>=2U);
+			CodePointRecord r [2];
+			std::memcpy(r,&bytes[offset(h.Records)],sizeof(r));
+			std::swap(r[0],r[1]);
+			std::memcpy(&bytes[offset(h.Records)],r,sizeof(r));
+			write();
+			
+			REQUIRE_THROWS_AS(DataFile(filename),std::runtime_error);
+		
+		}
+		
+		std::remove(filename);
+	
+	}
+	
+	GIVEN("A file which does not exist") {
+	
+		THEN("It cannot be loaded") {
+		
+			REQUIRE_THROWS_AS(DataFile("does not exist.dat"),std::runtime_error);
+		
+		}
+	
+	}
+
+}
+
+
+//
+//	DETECT ENCODING
+//
+
+
+SCENARIO("The encoding of unlabelled bytes may be detected","[detectencoding]") {
+
+	GIVEN("Text which is mostly ASCII, with some Latin-1 and other characters") {
+	
+		std::vector<CodePoint> cps;
+		const CodePoint::Type samples []={0xE9,0x4E2D,0xFC,0x3B1,0x1D11E};
+		for (std::size_t i=0;cps.size()<100000;++i) {
+		
+			for (std::size_t j=0;j<(i%29);++j) cps.push_back('a'+(j%26));
+			cps.push_back(samples[i%5]);
+		
+		}
+		
+		THEN("Its encoding is detected with certainty from a byte order mark") {
+		
+			UTF8 utf8;
+			utf8.OutputBOM=true;
+			UTF16 utf16be(Endianness::Big);
+			UTF16 utf16le(Endianness::Little);
+			UTF32 utf32be(Endianness::Big);
+			UTF32 utf32le(Endianness::Little);
+			const Encoding * encoders []={&utf8,&utf16be,&utf16le,&utf32be,&utf32le};
+			for (auto encoder : encoders) {
+			
+				auto buffer=encoder->Encode(cps);
+				auto detected=DetectEncoding(Begin(buffer),End(buffer));
+				REQUIRE(detected.Encoding);
+				CHECK(detected.Confidence==1);
+				CHECK(detected.Encoding->Size()==encoder->Size());
+				REQUIRE(detected.Encoding->Decode(Begin(buffer),End(buffer))==cps);
+			
+			}
+		
+		}
+		
+		THEN("UTF-16 and UTF-32 are detected in either byte order without a byte order mark") {
+		
+			for (auto order : {Endianness::Big,Endianness::Little}) {
+			
+				UTF16 utf16(order);
+				utf16.OutputBOM=false;
+				UTF32 utf32(order);
+				utf32.OutputBOM=false;
+				const Encoding * encoders []={&utf16,&utf32};
+				for (auto encoder : encoders) {
+				
+					auto buffer=encoder->Encode(cps);
+					auto detected=DetectEncoding(Begin(buffer),End(buffer));
+					REQUIRE(detected.Encoding);
+					CHECK(detected.Confidence>0.5);
+					CHECK(detected.Encoding->Size()==encoder->Size());
+					REQUIRE(detected.Encoding->Decode(Begin(buffer),End(buffer))==cps);
+					
+					//	Encoding with the detected encoding gives
+					//	bytes in the same form
+					REQUIRE(detected.Encoding->Encode(cps)==buffer);
+				
+				}
+			
+			}
+		
+		}
+		
+		THEN("UTF-8 is detected without a byte order mark") {
+		
+			UTF8 utf8;
+			auto buffer=utf8.Encode(cps);
+			auto detected=DetectEncoding(Begin(buffer),End(buffer));
+			REQUIRE(detected.Encoding);
+			CHECK(detected.Confidence>0.9);
+			CHECK(detected.Encoding->Size()==1U);
+			REQUIRE(detected.Encoding->Decode(Begin(buffer),End(buffer))==cps);
+			
+			AND_THEN("It is detected when only a prefix which ends partway through a sequence is examined") {
+			
+				auto last=std::find_if(Begin(buffer)+1000,End(buffer),[] (unsigned char c) {	return c>=0xC0;	});
+				auto max=static_cast<std::size_t>(last-Begin(buffer))+1;
+				auto detected=DetectEncoding(Begin(buffer),End(buffer),max);
+				REQUIRE(detected.Encoding);
+				REQUIRE(detected.Encoding->Decode(Begin(buffer),End(buffer))==cps);
+			
+			}
+		
+		}
+		
+		THEN("Latin-1 is detected when nothing else fits, with little confidence") {
+		
+			Latin1 latin1;
+			latin1.Lossy.Ignore();
+			auto buffer=latin1.Encode(cps);
+			auto detected=DetectEncoding(Begin(buffer),End(buffer));
+			REQUIRE(detected.Encoding);
+			CHECK(detected.Confidence<0.5);
+			REQUIRE(detected.Encoding->Decode(Begin(buffer),End(buffer))==latin1.Decode(Begin(buffer),End(buffer)));
+		
+		}
+	
+	}
+	
+	GIVEN("Text which is entirely ASCII") {
+	
+		const std::string str="The quick brown fox jumps over the lazy dog.";
+		auto begin=str.data();
+		auto end=begin+str.size();
+		
+		THEN("ASCII is detected with certainty") {
+		
+			auto detected=DetectEncoding(begin,end);
+			REQUIRE(detected.Encoding);
+			CHECK(detected.Confidence==1);
+			REQUIRE(detected.Encoding->Decode(begin,end).size()==str.size());
+		
+		}
+		
+		THEN("UTF-8 is detected with less certainty when only a prefix is examined") {
+		
+			auto detected=DetectEncoding(begin,end,16);
+			REQUIRE(detected.Encoding);
+			CHECK(detected.Confidence<1);
+			
+			const unsigned char more []={0xC3,0xA9};
+			REQUIRE(detected.Encoding->Decode(std::begin(more),std::end(more)).size()==1U);
+		
+		}
+	
+	}
+
+}
+
+
+//
+//	ENCODING
+//
+
+
+SCENARIO("Encoding and decoding in bulk gives the same results as doing so one code point at a time","[encoding]") {
+
+	GIVEN("Encoder/decoders for each encoding") {
+	
+		UTF8 utf8;
+		UTF16 utf16_be(Endianness::Big,Endianness::Big);
+		UTF16 utf16_le(Endianness::Little,Endianness::Little);
+		UTF32 utf32_be(Endianness::Big,Endianness::Big);
+		UTF32 utf32_le(Endianness::Little,Endianness::Little);
+		UCS2 ucs2_be(Endianness::Big,Endianness::Big);
+		UCS2 ucs2_le(Endianness::Little,Endianness::Little);
+		Latin1 latin1;
+		ASCII ascii;
+		SingleByte windows1252(SingleByte::Windows1252);
+		Encoding * encoders []={&utf8,&utf16_be,&utf16_le,&utf32_be,&utf32_le,&ucs2_be,&ucs2_le,&latin1,&ascii,&windows1252};
+		for (auto encoder : encoders) {
+		
+			encoder->OutputBOM=false;
+			encoder->DetectBOM=false;
+		
+		}
+		
+		GIVEN("A long sequence of code points, some of which are invalid or cannot be represented by every encoding") {
+		
+			std::vector<CodePoint> cps;
+			const CodePoint::Type samples []={0xE9,0x200B,0x1D11E,0xD800,0xFFFF,0x110000};
+			for (std::size_t i=0;cps.size()<5000;++i) {
+			
+				for (std::size_t j=0;j<(i%37);++j) cps.push_back('a'+(j%26));
+				cps.push_back(samples[i%6]);
+			
+			}
+			
+			THEN("Encoding raises an exception") {
+			
+				for (auto encoder : encoders) REQUIRE_THROWS_AS(encoder->Encode(cps),EncodingError);
+			
+			}
+			
+			GIVEN("Errors result in a replacement") {
+			
+				for (auto encoder : encoders) {
+				
+					encoder->UnicodeStrict.Replace('?');
+					encoder->Lossy.Replace('?');
+				
+				}
+				
+				THEN("Encoding gives the same results as encoding one code point at a time") {
+				
+					for (auto encoder : encoders) REQUIRE(encoder->Encode(cps)==EncodeEach(*encoder,cps));
+				
+				}
+			
+			}
+			
+			GIVEN("Errors are ignored") {
+			
+				for (auto encoder : encoders) {
+				
+					encoder->UnicodeStrict.Ignore();
+					encoder->Lossy.Ignore();
+				
+				}
+				
+				THEN("Encoding gives the same results as encoding one code point at a time") {
+				
+					for (auto encoder : encoders) REQUIRE(encoder->Encode(cps)==EncodeEach(*encoder,cps));
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("Buffers in each encoding with ill formed, invalid, and truncated sequences at various offsets") {
+		
+			std::vector<CodePoint> cps;
+			const CodePoint::Type samples []={0xE9,0x200B,0x1D11E};
+			for (std::size_t i=0;cps.size()<3000;++i) {
+			
+				for (std::size_t j=0;j<(i%37);++j) cps.push_back('a'+(j%26));
+				cps.push_back(samples[i%3]);
+			
+			}
+			
+			const std::vector<unsigned char> bad []={
+				{0x80},
+				{0xFF},
+				{0x00,0xD8},
+				{0xDC,0x00},
+				{0xFF,0xFF,0x00,0x00},
+				{0x00,0x00,0xD8,0x00}
+			};
+			std::vector<std::vector<std::vector<unsigned char>>> buffers;
+			for (auto encoder : encoders) {
+			
+				std::vector<CodePoint> representable;
+				for (auto cp : cps) if (encoder->CanRepresent(cp)) representable.push_back(cp);
+				auto buffer=encoder->Encode(representable);
+				
+				buffers.emplace_back();
+				for (std::size_t i=0,offset=0;offset<buffer.size();++i,offset+=offset/2+1) {
+				
+					auto & b=bad[i%(sizeof(bad)/sizeof(*bad))];
+					auto copy=buffer;
+					copy.insert(copy.begin()+offset,b.begin(),b.end());
+					buffers.back().push_back(std::move(copy));
+				
+				}
+				buffers.back().push_back(buffer);
+				buffers.back().back().pop_back();
+			
+			}
+			
+			THEN("Decoding each buffer raises an exception exactly when decoding one code point at a time does") {
+			
+				for (std::size_t i=0;i<buffers.size();++i) for (auto & b : buffers[i]) RequireDecodesAsEach(*encoders[i],Begin(b),End(b));
+			
+			}
+			
+			GIVEN("Errors result in a replacement") {
+			
+				for (auto encoder : encoders) {
+				
+					encoder->Strict.Replace(0xFFFD);
+					encoder->UnicodeStrict.Replace(0xFFFD);
+					encoder->UnexpectedEnd.Replace(0xFFFD);
+				
+				}
+				
+				THEN("Decoding each buffer gives the same results as decoding one code point at a time") {
+				
+					for (std::size_t i=0;i<buffers.size();++i) for (auto & b : buffers[i]) REQUIRE(encoders[i]->Decode(Begin(b),End(b))==DecodeEach(*encoders[i],Begin(b),End(b)));
+				
+				}
+			
+			}
+			
+			GIVEN("Errors are ignored") {
+			
+				for (auto encoder : encoders) {
+				
+					encoder->Strict.Ignore();
+					encoder->UnicodeStrict.Ignore();
+					encoder->UnexpectedEnd.Ignore();
+				
+				}
+				
+				THEN("Decoding each buffer gives the same results as decoding one code point at a time") {
+				
+					for (std::size_t i=0;i<buffers.size();++i) for (auto & b : buffers[i]) REQUIRE(encoders[i]->Decode(Begin(b),End(b))==DecodeEach(*encoders[i],Begin(b),End(b)));
+				
+				}
+			
+			}
+		
+		}
+	
+	}
+
+}
+
+
+SCENARIO("Encoding and decoding may determine the exact size of the output and write to memory owned by the caller","[encoding]") {
+
+	GIVEN("A UTF-16 encoder/decoder which outputs a BOM and replaces errors") {
+	
+		UTF16 utf16(Endianness::Little,Endianness::Little);
+		utf16.OutputBOM=true;
+		utf16.UnicodeStrict.Replace(0xFFFD);
+		utf16.Strict.Replace(0xFFFD);
+		utf16.UnexpectedEnd.Replace(0xFFFD);
+		
+		GIVEN("A sequence of code points, some of which are invalid") {
+		
+			std::vector<CodePoint> cps;
+			const CodePoint::Type samples []={0xE9,0x1D11E,0xD800,0x110000};
+			for (std::size_t i=0;cps.size()<1000;++i) {
+			
+				for (std::size_t j=0;j<(i%13);++j) cps.push_back('a'+(j%26));
+				cps.push_back(samples[i%4]);
+			
+			}
+			auto expected=utf16.Encode(cps);
+			
+			THEN("The size of the encoded output is determined exactly") {
+			
+				REQUIRE(utf16.EncodedSize(Begin(cps),End(cps))==expected.size());
+			
+			}
+			
+			THEN("Encoding into a vector appends to it") {
+			
+				std::vector<unsigned char> buffer={1,2,3};
+				utf16.Encode(Begin(cps),End(cps),buffer);
+				REQUIRE(buffer.size()==(expected.size()+3));
+				REQUIRE(std::equal(expected.begin(),expected.end(),buffer.begin()+3));
+			
+			}
+			
+			THEN("Encoding into a string appends to it") {
+			
+				std::string str("abc");
+				utf16.Encode(Begin(cps),End(cps),str);
+				REQUIRE(str.size()==(expected.size()+3));
+				REQUIRE(std::memcmp(str.data()+3,Begin(expected),expected.size())==0);
+			
+			}
+			
+			THEN("Encoding into a buffer large enough fills it exactly") {
+			
+				std::vector<unsigned char> buffer(expected.size()+1,0xAA);
+				REQUIRE(utf16.Encode(Begin(cps),End(cps),Begin(buffer),buffer.size())==expected.size());
+				REQUIRE(std::equal(expected.begin(),expected.end(),buffer.begin()));
+				REQUIRE(buffer.back()==0xAA);
+			
+			}
+			
+			THEN("Encoding into a buffer too small reports the size required") {
+			
+				std::vector<unsigned char> buffer(expected.size()/2);
+				REQUIRE(utf16.Encode(Begin(cps),End(cps),Begin(buffer),buffer.size())==expected.size());
+				REQUIRE(utf16.Encode(Begin(cps),End(cps),nullptr,0)==expected.size());
+			
+			}
+			
+			GIVEN("Errors raise an exception") {
+			
+				utf16.UnicodeStrict.Throw();
+				
+				THEN("Determining the size of the encoded output raises an exception") {
+				
+					REQUIRE_THROWS_AS(utf16.EncodedSize(Begin(cps),End(cps)),EncodingError);
+				
+				}
+			
+			}
+			
+			GIVEN("That sequence encoded with an ill formed sequence and a truncated sequence") {
+			
+				auto b=expected;
+				b.insert(b.begin()+100,{0x00,0xDC});
+				b.push_back(0x3D);
+				b.push_back(0xD8);
+				auto decoded=utf16.Decode(Begin(b),End(b));
+				
+				THEN("The size of the decoded output is determined exactly") {
+				
+					REQUIRE(utf16.DecodedSize(Begin(b),End(b))==decoded.size());
+				
+				}
+				
+				THEN("Decoding into a vector appends to it") {
+				
+					std::vector<CodePoint> out={'a'};
+					utf16.Decode(Begin(b),End(b),out);
+					REQUIRE(out.size()==(decoded.size()+1));
+					REQUIRE(std::equal(decoded.begin(),decoded.end(),out.begin()+1));
+				
+				}
+				
+				THEN("Decoding into a buffer large enough fills it exactly") {
+				
+					std::vector<CodePoint> out(decoded.size());
+					REQUIRE(utf16.Decode(Begin(b),End(b),Begin(out),out.size())==decoded.size());
+					REQUIRE(out==decoded);
+				
+				}
+				
+				THEN("Decoding into a buffer too small reports the size required") {
+				
+					std::vector<CodePoint> out(decoded.size()-1);
+					REQUIRE(utf16.Decode(Begin(b),End(b),Begin(out),out.size())==decoded.size());
+				
+				}
+			
+			}
+		
+		}
+	
+	}
+
+}
+
+
+SCENARIO("Transcoding gives the same results as decoding and then encoding","[encoding]") {
+
+	GIVEN("Encoder/decoders for several encodings") {
+	
+		UTF8 utf8;
+		UTF16 utf16_be(Endianness::Big,Endianness::Big);
+		UTF16 utf16_le(Endianness::Little,Endianness::Little);
+		UTF32 utf32_be(Endianness::Big,Endianness::Big);
+		UTF32 utf32_le(Endianness::Little,Endianness::Little);
+		Latin1 latin1;
+		Encoding * encoders []={&utf8,&utf16_be,&utf16_le,&utf32_be,&utf32_le,&latin1};
+		for (auto encoder : encoders) {
+		
+			encoder->OutputBOM=false;
+			encoder->DetectBOM=false;
+		
+		}
+		
+		GIVEN("Buffers in each encoding with ill formed, invalid, and truncated sequences") {
+		
+			std::vector<CodePoint> cps;
+			const CodePoint::Type samples []={0xE9,0x200B,0x1D11E,0xFF21,0x4E2D,0xAC00,0xD7FF};
+			for (std::size_t i=0;cps.size()<5000;++i) {
+			
+				for (std::size_t j=0;j<(i%53);++j) cps.push_back('a'+(j%26));
+				for (std::size_t j=0;j<(i%11);++j) cps.push_back(samples[(i+j)%7]);
+			
+			}
+			
+			const std::vector<unsigned char> bad []={
+				{0x80},
+				{0x00,0xD8},
+				{0xFF,0xFF,0x00,0x00}
+			};
+			std::vector<std::vector<unsigned char>> buffers;
+			for (auto encoder : encoders) {
+			
+				std::vector<CodePoint> representable;
+				for (auto cp : cps) if (encoder->CanRepresent(cp)) representable.push_back(cp);
+				auto buffer=encoder->Encode(representable);
+				
+				for (std::size_t i=0;i<(sizeof(bad)/sizeof(*bad));++i) {
+				
+					auto offset=(buffer.size()/4)*(i+1);
+					buffer.insert(buffer.begin()+offset,bad[i].begin(),bad[i].end());
+				
+				}
+				buffer.pop_back();
+				buffers.push_back(std::move(buffer));
+			
+			}
+			
+			GIVEN("Errors result in a replacement and output begins with a BOM") {
+			
+				for (auto encoder : encoders) {
+				
+					encoder->Strict.Replace('?');
+					encoder->UnicodeStrict.Replace('?');
+					encoder->UnexpectedEnd.Replace('?');
+					encoder->Lossy.Replace('?');
+					encoder->OutputBOM=true;
+				
+				}
+				
+				THEN("Transcoding between each pair of encodings gives the same results as decoding and then encoding") {
+				
+					for (std::size_t i=0;i<buffers.size();++i) for (auto to : encoders) {
+					
+						auto & b=buffers[i];
+						REQUIRE(encoders[i]->Transcode(Begin(b),End(b),*to)==to->Encode(encoders[i]->Decode(Begin(b),End(b))));
+					
+					}
+				
+				}
+				
+				THEN("Transcoding into a string appends to it") {
+				
+					auto & b=buffers[1];
+					auto expected=utf8.Encode(utf16_be.Decode(Begin(b),End(b)));
+					std::string str("abc");
+					utf16_be.Transcode(Begin(b),End(b),utf8,str);
+					REQUIRE(str.size()==(expected.size()+3));
+					REQUIRE(std::memcmp(str.data()+3,Begin(expected),expected.size())==0);
+				
+				}
+			
+			}
+			
+			GIVEN("Errors are ignored") {
+			
+				for (auto encoder : encoders) {
+				
+					encoder->Strict.Ignore();
+					encoder->UnicodeStrict.Ignore();
+					encoder->UnexpectedEnd.Ignore();
+					encoder->Lossy.Ignore();
+				
+				}
+				
+				THEN("Transcoding between each pair of encodings gives the same results as decoding and then encoding") {
+				
+					for (std::size_t i=0;i<buffers.size();++i) for (auto to : encoders) {
+					
+						auto & b=buffers[i];
+						REQUIRE(encoders[i]->Transcode(Begin(b),End(b),*to)==to->Encode(encoders[i]->Decode(Begin(b),End(b))));
+					
+					}
+				
+				}
+			
+			}
+			
+			THEN("Transcoding raises an exception exactly when decoding and then encoding does") {
+			
+				for (std::size_t i=0;i<buffers.size();++i) for (auto to : encoders) {
+				
+					auto & b=buffers[i];
+					std::vector<unsigned char> expected;
+					try {
+					
+						expected=to->Encode(encoders[i]->Decode(Begin(b),End(b)));
+					
+					} catch (const EncodingError &) {
+					
+						REQUIRE_THROWS_AS(encoders[i]->Transcode(Begin(b),End(b),*to),EncodingError);
+						
+						continue;
+					
+					}
+					
+					REQUIRE(encoders[i]->Transcode(Begin(b),End(b),*to)==expected);
+				
+				}
+			
+			}
+		
+		}
+	
+	}
+
+}
+
+
+SCENARIO("Streams may be decoded in chunks of any size","[encoding]") {
+
+	GIVEN("Encoder/decoders for several encodings which detect the byte order from a BOM") {
+	
+		UTF8 utf8;
+		utf8.OutputBOM=true;
+		utf8.DetectBOM=true;
+		UTF16 utf16(Endianness::Little,Endianness::Big);
+		UTF32 utf32(Endianness::Little,Endianness::Big);
+		Latin1 latin1;
+		Encoding * encoders []={&utf8,&utf16,&utf32,&latin1};
+		
+		GIVEN("Buffers in each encoding beginning with a BOM with ill formed, invalid, and truncated sequences") {
+		
+			std::vector<CodePoint> cps;
+			const CodePoint::Type samples []={0xE9,0x200B,0x1D11E,0xFF21,0x4E2D};
+			for (std::size_t i=0;cps.size()<3000;++i) {
+			
+				for (std::size_t j=0;j<(i%29);++j) cps.push_back('a'+(j%26));
+				for (std::size_t j=0;j<(i%7);++j) cps.push_back(samples[(i+j)%5]);
+			
+			}
+			
+			const std::vector<unsigned char> bad []={
+				{0x80},
+				{0xDC,0x00},
+				{0xFF,0xFF,0x00,0x00}
+			};
+			std::vector<std::vector<unsigned char>> buffers;
+			for (auto encoder : encoders) {
+			
+				std::vector<CodePoint> representable;
+				for (auto cp : cps) if (encoder->CanRepresent(cp)) representable.push_back(cp);
+				auto buffer=encoder->Encode(representable);
+				
+				for (std::size_t i=0;i<(sizeof(bad)/sizeof(*bad));++i) {
+				
+					auto offset=(buffer.size()/4)*(i+1);
+					buffer.insert(buffer.begin()+offset,bad[i].begin(),bad[i].end());
+				
+				}
+				buffer.pop_back();
+				buffers.push_back(std::move(buffer));
+			
+			}
+			
+			const std::size_t sizes []={1,2,3,5,7,64,4099};
+			
+			GIVEN("Errors result in a replacement") {
+			
+				for (auto encoder : encoders) {
+				
+					encoder->Strict.Replace('?');
+					encoder->UnicodeStrict.Replace('?');
+					encoder->UnexpectedEnd.Replace('?');
+				
+				}
+				
+				THEN("Decoding each buffer in chunks gives the same results as decoding it at once") {
+				
+					for (std::size_t i=0;i<buffers.size();++i) for (auto size : sizes) {
+					
+						auto & b=buffers[i];
+						REQUIRE(DecodeChunks(*encoders[i],b,size)==encoders[i]->Decode(Begin(b),End(b)));
+					
+					}
+				
+				}
+				
+				THEN("A decoder may decode another stream after it's finished") {
+				
+					auto & b=buffers[1];
+					StreamDecoder decoder(utf16);
+					std::vector<CodePoint> decoded;
+					for (std::size_t i=0;i<2;++i) {
+					
+						decoder.Decode(Begin(b),End(b),decoded);
+						decoder.Finish(decoded);
+					
+					}
+					auto expected=utf16.Decode(Begin(b),End(b));
+					REQUIRE(decoded.size()==(expected.size()*2));
+					REQUIRE(std::equal(expected.begin(),expected.end(),decoded.begin()));
+					REQUIRE(std::equal(expected.begin(),expected.end(),decoded.begin()+expected.size()));
+				
+				}
+			
+			}
+			
+			GIVEN("Errors are ignored") {
+			
+				for (auto encoder : encoders) {
+				
+					encoder->Strict.Ignore();
+					encoder->UnicodeStrict.Ignore();
+					encoder->UnexpectedEnd.Ignore();
+				
+				}
+				
+				THEN("Decoding each buffer in chunks gives the same results as decoding it at once") {
+				
+					for (std::size_t i=0;i<buffers.size();++i) for (auto size : sizes) {
+					
+						auto & b=buffers[i];
+						REQUIRE(DecodeChunks(*encoders[i],b,size)==encoders[i]->Decode(Begin(b),End(b)));
+					
+					}
+				
+				}
+			
+			}
+			
+			THEN("Decoding each buffer in chunks raises an exception exactly when decoding it at once does") {
+			
+				for (std::size_t i=0;i<buffers.size();++i) for (auto size : sizes) {
+				
+					auto & b=buffers[i];
+					std::vector<CodePoint> expected;
+					try {
+					
+						expected=encoders[i]->Decode(Begin(b),End(b));
+					
+					} catch (const EncodingError &) {
+					
+						REQUIRE_THROWS_AS(DecodeChunks(*encoders[i],b,size),EncodingError);
+						
+						continue;
+					
+					}
+					
+					REQUIRE(DecodeChunks(*encoders[i],b,size)==expected);
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("A StreamDecoder") {
+		
+			StreamDecoder decoder(utf8);
+			std::vector<CodePoint> decoded;
+			
+			WHEN("A chunk ending partway through a sequence is decoded") {
+			
+				const unsigned char chunk []={'a',0xE2,0x82};
+				decoder.Decode(std::begin(chunk),std::end(chunk),decoded);
+				
+				THEN("Only the complete code points are decoded") {
+				
+					REQUIRE(decoded.size()==1U);
+					REQUIRE(decoded[0]=='a');
+				
+				}
+				
+				THEN("The incomplete sequence is carried") {
+				
+					REQUIRE(decoder.Pending()==2U);
+				
+				}
+				
+				AND_WHEN("The rest of the sequence is decoded") {
+				
+					const unsigned char rest []={0xAC};
+					decoder.Decode(std::begin(rest),std::end(rest),decoded);
+					
+					THEN("The sequence is decoded") {
+					
+						REQUIRE(decoded.size()==2U);
+						REQUIRE(decoded[1]==0x20AC);
+						REQUIRE(decoder.Pending()==0U);
+					
+					}
+				
+				}
+				
+				AND_WHEN("The stream is finished") {
+				
+					THEN("An exception is thrown") {
+					
+						REQUIRE_THROWS_AS(decoder.Finish(decoded),EncodingError);
+					
+					}
+				
+				}
+			
+			}
+			
+			WHEN("A chunk containing only part of a BOM is decoded") {
+			
+				const unsigned char chunk []={0xEF,0xBB};
+				decoder.Decode(std::begin(chunk),std::end(chunk),decoded);
+				
+				THEN("Nothing is decoded") {
+				
+					REQUIRE(decoded.empty());
+					REQUIRE(decoder.Pending()==2U);
+				
+				}
+				
+				AND_WHEN("The rest of the BOM and a code point are decoded") {
+				
+					const unsigned char rest []={0xBF,'a'};
+					decoder.Decode(std::begin(rest),std::end(rest),decoded);
+					
+					THEN("The BOM is skipped") {
+					
+						REQUIRE(decoded.size()==1U);
+						REQUIRE(decoded[0]=='a');
+					
+					}
+				
+				}
+			
+			}
+		
+		}
+	
+	}
+
+}
+
+
+SCENARIO("Large buffers may be decoded using several threads","[encoding]") {
+
+	GIVEN("Encoder/decoders for several encodings which detect the byte order from a BOM") {
+	
+		UTF8 utf8;
+		utf8.OutputBOM=true;
+		utf8.DetectBOM=true;
+		UTF16 utf16(Endianness::Little,Endianness::Big);
+		UTF32 utf32(Endianness::Little,Endianness::Big);
+		UCS2 ucs2(Endianness::Little,Endianness::Big);
+		Latin1 latin1;
+		Encoding * encoders []={&utf8,&utf16,&utf32,&ucs2,&latin1};
+		
+		GIVEN("Large buffers in each encoding with ill formed, invalid, and truncated sequences, and long runs of ill formed sequences") {
+		
+			std::vector<CodePoint> cps;
+			//	Mostly multi-byte sequences and surrogate pairs,
+			//	so that the divisions between chunks don't happen
+			//	to fall between sequences
+			const CodePoint::Type samples []={0xE9,0x1D11E,0x1F600,0x10348,0x4E2D};
+			for (std::size_t i=0;cps.size()<500000;++i) {
+			
+				for (std::size_t j=0;j<(i%7);++j) cps.push_back('a'+(j%26));
+				for (std::size_t j=0;j<(i%29);++j) cps.push_back(samples[(i+j)%5]);
+			
+			}
+			
+			const std::vector<unsigned char> bad []={
+				{0x80},
+				{0xDC,0x00},
+				{0xFF,0xFF,0x00,0x00}
+			};
+			std::vector<std::vector<unsigned char>> buffers;
+			for (auto encoder : encoders) {
+			
+				std::vector<CodePoint> representable;
+				for (auto cp : cps) if (encoder->CanRepresent(cp)) representable.push_back(cp);
+				auto buffer=encoder->Encode(representable);
+				
+				//	Single errors are scattered throughout the
+				//	second half, so that the first error isn't
+				//	in the first chunk, and runs of errors long
+				//	enough to span the divisions between chunks
+				//	are placed in the middle
+				for (std::size_t i=0;i<64;++i) {
+				
+					auto & b=bad[i%(sizeof(bad)/sizeof(*bad))];
+					auto offset=(buffer.size()/2)+((buffer.size()/128)*i)+((i*7919)%4096);
+					buffer.insert(buffer.begin()+offset,b.begin(),b.end());
+				
+				}
+				for (auto & b : bad) {
+				
+					std::vector<unsigned char> run;
+					for (std::size_t i=0;i<(1U<<17);++i) run.insert(run.end(),b.begin(),b.end());
+					buffer.insert(buffer.begin()+(buffer.size()/2),run.begin(),run.end());
+				
+				}
+				buffer.pop_back();
+				buffers.push_back(std::move(buffer));
+			
+			}
+			
+			const std::size_t threads []={2,3,4,7};
+			
+			GIVEN("Errors result in a replacement") {
+			
+				for (auto encoder : encoders) {
+				
+					encoder->Strict.Replace('?');
+					encoder->UnicodeStrict.Replace('?');
+					encoder->UnexpectedEnd.Replace('?');
+				
+				}
+				
+				THEN("Decoding each buffer using several threads gives the same results as decoding it on one") {
+				
+					for (std::size_t i=0;i<buffers.size();++i) for (auto n : threads) {
+					
+						auto & b=buffers[i];
+						REQUIRE(encoders[i]->ParallelDecode(Begin(b),End(b),n)==encoders[i]->Decode(Begin(b),End(b)));
+					
+					}
+				
+				}
+			
+			}
+			
+			GIVEN("Errors are ignored") {
+			
+				for (auto encoder : encoders) {
+				
+					encoder->Strict.Ignore();
+					encoder->UnicodeStrict.Ignore();
+					encoder->UnexpectedEnd.Ignore();
+				
+				}
+				
+				THEN("Decoding each buffer using several threads gives the same results as decoding it on one") {
+				
+					for (std::size_t i=0;i<buffers.size();++i) for (auto n : threads) {
+					
+						auto & b=buffers[i];
+						REQUIRE(encoders[i]->ParallelDecode(Begin(b),End(b),n)==encoders[i]->Decode(Begin(b),End(b)));
+					
+					}
+				
+				}
+			
+			}
+			
+			THEN("Decoding each buffer using several threads raises the same exception at the same location as decoding it on one") {
+			
+				for (std::size_t i=0;i<buffers.size();++i) for (auto n : threads) {
+				
+					auto & b=buffers[i];
+					std::optional<EncodingError> expected;
+					try {
+					
+						encoders[i]->Decode(Begin(b),End(b));
+					
+					} catch (const EncodingError & e) {
+					
+						expected=e;
+					
+					}
+					
+					if (expected) {
+					
+						std::optional<EncodingError> error;
+						try {
+						
+							encoders[i]->ParallelDecode(Begin(b),End(b),n);
+						
+						} catch (const EncodingError & e) {
+						
+							error=e;
+						
+						}
+						REQUIRE(error);
+						CHECK(error->type()==expected->type());
+						REQUIRE(error->where()==expected->where());
+					
+					} else {
+					
+						REQUIRE(encoders[i]->ParallelDecode(Begin(b),End(b),n)==encoders[i]->Decode(Begin(b),End(b)));
+					
+					}
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("A small buffer") {
+		
+			const unsigned char buffer []={'a',0xE2,0x82,0xAC};
+			
+			THEN("It is decoded") {
+			
+				REQUIRE(utf8.ParallelDecode(std::begin(buffer),std::end(buffer),4)==utf8.Decode(std::begin(buffer),std::end(buffer)));
+			
+			}
+		
+		}
+	
+	}
+
+}
+
+
+SCENARIO("Large ranges of code points may be encoded using several threads","[encoding]") {
+
+	GIVEN("Encoders for several encodings") {
+	
+		UTF8 utf8;
+		utf8.OutputBOM=true;
+		UTF16 utf16(Endianness::Little);
+		UTF32 utf32(Endianness::Big);
+		UCS2 ucs2(Endianness::Little);
+		Latin1 latin1;
+		ASCII ascii;
+		Encoding * encoders []={&utf8,&utf16,&utf32,&ucs2,&latin1,&ascii};
+		
+		GIVEN("A large range of code points including some which are invalid, and some which many encodings cannot represent") {
+		
+			std::vector<CodePoint> cps;
+			const CodePoint::Type samples []={0xE9,0x200B,0x1D11E,0xFF21,0x4E2D};
+			for (std::size_t i=0;cps.size()<500000;++i) {
+			
+				for (std::size_t j=0;j<(i%29);++j) cps.push_back('a'+(j%26));
+				for (std::size_t j=0;j<(i%7);++j) cps.push_back(samples[(i+j)%5]);
+				
+				//	The first error isn't in the first chunk
+				if (cps.size()>400000) {
+				
+					if ((i%97)==0) cps.push_back(0xD800);
+					if ((i%89)==0) cps.push_back(0xFFFE);
+				
+				}
+			
+			}
+			auto begin=Begin(cps);
+			auto end=End(cps);
+			
+			const std::size_t threads []={2,3,4,7};
+			
+			GIVEN("Errors result in a replacement") {
+			
+				for (auto encoder : encoders) {
+				
+					encoder->UnicodeStrict.Replace('?');
+					encoder->Lossy.Replace('?');
+				
+				}
+				
+				THEN("Encoding using several threads gives the same results as encoding on one") {
+				
+					for (auto encoder : encoders) for (auto n : threads) REQUIRE(encoder->ParallelEncode(begin,end,n)==encoder->Encode(begin,end));
+				
+				}
+			
+			}
+			
+			GIVEN("Errors are ignored") {
+			
+				for (auto encoder : encoders) {
+				
+					encoder->UnicodeStrict.Ignore();
+					encoder->Lossy.Ignore();
+				
+				}
+				
+				THEN("Encoding using several threads gives the same results as encoding on one") {
+				
+					for (auto encoder : encoders) for (auto n : threads) REQUIRE(encoder->ParallelEncode(begin,end,n)==encoder->Encode(begin,end));
+				
+				}
+			
+			}
+			
+			THEN("Encoding using several threads raises the same exception at the same location as encoding on one") {
+			
+				for (auto encoder : encoders) for (auto n : threads) {
+				
+					std::optional<EncodingError> expected;
+					try {
+					
+						encoder->Encode(begin,end);
+					
+					} catch (const EncodingError & e) {
+					
+						expected=e;
+					
+					}
+					REQUIRE(expected);
+					
+					std::optional<EncodingError> error;
+					try {
+					
+						encoder->ParallelEncode(begin,end,n);
+					
+					} catch (const EncodingError & e) {
+					
+						error=e;
+					
+					}
+					REQUIRE(error);
+					CHECK(error->type()==expected->type());
+					REQUIRE(error->where()==expected->where());
+				
+				}
+			
+			}
+		
+		}
+	
+	}
+
+}
+
+
+
+SCENARIO("Errors may be reported rather than thrown","[encoding]") {
+
+	GIVEN("A UTF-8 decoder which reports errors to a log") {
+	
+		UTF8 utf8;
+		
+		GIVEN("Bytes which contain invalid bytes, an incomplete sequence, and which end part way through a sequence") {
+		
+			const unsigned char bytes []={'a',0xFF,'b',0xC3,'c',0xE2,0x82};
+			auto begin=std::begin(bytes);
+			auto end=std::end(bytes);
+			EncodingErrorLog log(begin);
+			utf8.Sink=&log;
+			
+			WHEN("They are decoded") {
+			
+				auto cps=utf8.Decode(begin,end);
+				
+				THEN("Each error is replaced with U+FFFD") {
+				
+					std::vector<CodePoint> expected={'a',0xFFFD,'b',0xFFFD,'c',0xFFFD};
+					REQUIRE(cps==expected);
+				
+				}
+				
+				THEN("Each error is reported with its type and its offset") {
+				
+					REQUIRE(log.Entries.size()==3U);
+					CHECK(log.Entries[0].Type==EncodingErrorType::Strict);
+					CHECK(log.Entries[0].Offset==1U);
+					CHECK(log.Entries[1].Type==EncodingErrorType::Strict);
+					CHECK(log.Entries[1].Offset==3U);
+					CHECK(log.Entries[2].Type==EncodingErrorType::UnexpectedEnd);
+					CHECK(log.Entries[2].Offset==5U);
+				
+				}
+			
+			}
+			
+			GIVEN("Replacements for some errors") {
+			
+				utf8.Strict.Replace('?');
+				utf8.UnexpectedEnd.Nothing();
+				
+				WHEN("They are decoded") {
+				
+					auto cps=utf8.Decode(begin,end);
+					
+					THEN("Those replacements are made") {
+					
+						std::vector<CodePoint> expected={'a','?','b','?','c'};
+						REQUIRE(cps==expected);
+					
+					}
+					
+					THEN("Each error is reported") {
+					
+						REQUIRE(log.Entries.size()==3U);
+					
+					}
+				
+				}
+			
+			}
+			
+			GIVEN("Some errors are ignored") {
+			
+				utf8.Strict.Ignore();
+				
+				WHEN("They are decoded") {
+				
+					auto cps=utf8.Decode(begin,end);
+					
+					THEN("Errors which are ignored are not reported") {
+					
+						REQUIRE(log.Entries.size()==1U);
+						CHECK(log.Entries[0].Type==EncodingErrorType::UnexpectedEnd);
+						CHECK(cps.size()==4U);
+					
+					}
+				
+				}
+			
+			}
+			
+			GIVEN("A StreamDecoder with a log which records offsets in the stream") {
+			
+				StreamDecoder decoder(utf8);
+				EncodingErrorLog stream_log(decoder);
+				utf8.Sink=&stream_log;
+				
+				THEN("Decoding them in chunks of any size reports each error at its offset in the stream, even when it is split between chunks") {
+				
+					for (std::size_t size=1;size<=sizeof(bytes);++size) {
+					
+						stream_log.Entries.clear();
+						std::vector<CodePoint> cps;
+						for (auto b=begin;b!=end;) {
+						
+							auto e=b+std::min<std::size_t>(size,static_cast<std::size_t>(end-b));
+							decoder.Decode(b,e,cps);
+							b=e;
+						
+						}
+						decoder.Finish(cps);
+						
+						std::vector<CodePoint> expected={'a',0xFFFD,'b',0xFFFD,'c',0xFFFD};
+						CHECK(cps==expected);
+						REQUIRE(stream_log.Entries.size()==3U);
+						CHECK(stream_log.Entries[0].Type==EncodingErrorType::Strict);
+						CHECK(stream_log.Entries[0].Offset==1U);
+						CHECK(stream_log.Entries[1].Type==EncodingErrorType::Strict);
+						CHECK(stream_log.Entries[1].Offset==3U);
+						CHECK(stream_log.Entries[2].Type==EncodingErrorType::UnexpectedEnd);
+						CHECK(stream_log.Entries[2].Offset==5U);
+					
+					}
+				
+				}
+			
+			}
+		
+		}
+	
+	}
+	
+	GIVEN("Decoders for several encodings") {
+	
+		UTF8 utf8;
+		UTF16 utf16(Endianness::Little);
+		UTF32 utf32(Endianness::Big);
+		UCS2 ucs2(Endianness::Little);
+		ASCII ascii;
+		Encoding * decoders []={&utf8,&utf16,&utf32,&ucs2,&ascii};
+		
+		GIVEN("Bytes which are invalid in each of them in many places") {
+		
+			std::vector<unsigned char> bytes;
+			for (std::size_t i=0;bytes.size()<(1U<<20);++i) {
+			
+				bytes.push_back(static_cast<unsigned char>('a'+(i%26)));
+				if ((i%101)==0) bytes.push_back(0xFF);
+				if ((i%103)==0) bytes.push_back(0xD8);
+				if ((i%107)==0) bytes.push_back(0x00);
+			
+			}
+			bytes.push_back(0xDC);
+			auto begin=Begin(bytes);
+			auto end=End(bytes);
+			
+			THEN("Decoding while reporting errors gives the same results as replacing them with U+FFFD, and reports each error which would be thrown") {
+			
+				for (auto decoder : decoders) {
+				
+					EncodingErrorLog log(begin);
+					decoder->Sink=&log;
+					auto cps=decoder->Decode(begin,end);
+					auto parallel=decoder->ParallelDecode(begin,end,4);
+					decoder->Sink=nullptr;
+					
+					REQUIRE(parallel==cps);
+					//	Reporting errors forces decoding onto one
+					//	thread, so they're reported in the same order
+					//	both times
+					REQUIRE((log.Entries.size()%2)==0U);
+					auto half=log.Entries.size()/2;
+					REQUIRE(half!=0U);
+					REQUIRE(std::equal(
+						log.Entries.begin(),
+						log.Entries.begin()+half,
+						log.Entries.begin()+half,
+						[] (const EncodingErrorLog::Entry & a, const EncodingErrorLog::Entry & b) noexcept {	return (a.Type==b.Type) && (a.Offset==b.Offset);	}
+					));
+					
+					decoder->UnicodeStrict.Replace(0xFFFD);
+					decoder->Strict.Replace(0xFFFD);
+					decoder->UnexpectedEnd.Replace(0xFFFD);
+					REQUIRE(cps==decoder->Decode(begin,end));
+					
+					decoder->UnicodeStrict.Throw();
+					decoder->Strict.Throw();
+					decoder->UnexpectedEnd.Throw();
+					std::optional<EncodingError> error;
+					try {
+					
+						decoder->Decode(begin,end);
+					
+					} catch (const EncodingError & e) {
+					
+						error=e;
+					
+					}
+					REQUIRE(error);
+					CHECK(error->type()==log.Entries[0].Type);
+					CHECK(error->where()==begin+log.Entries[0].Offset);
+				
+				}
+			
+			}
+		
+		}
+	
+	}
+	
+	GIVEN("A range of code points including some which are invalid, and some which Latin-1 cannot represent") {
+	
+		const std::vector<CodePoint> cps={'a',0x4E2D,'b',0xD800,0xE9};
+		auto begin=Begin(cps);
+		auto end=End(cps);
+		EncodingErrorLog log(begin);
+		
+		GIVEN("A Latin-1 encoder which reports errors to a log") {
+		
+			Latin1 latin1;
+			latin1.Sink=&log;
+			
+			WHEN("They are encoded") {
+			
+				auto bytes=latin1.Encode(begin,end);
+				
+				THEN("Each error is replaced with a question mark, since U+FFFD cannot be represented") {
+				
+					std::vector<unsigned char> expected={'a','?','b','?',0xE9};
+					REQUIRE(bytes==expected);
+				
+				}
+				
+				THEN("Each error is reported with its type and the offset of its code point") {
+				
+					REQUIRE(log.Entries.size()==3U);
+					CHECK(log.Entries[0].Type==EncodingErrorType::Lossy);
+					CHECK(log.Entries[0].Offset==1U);
+					CHECK(log.Entries[1].Type==EncodingErrorType::UnicodeStrict);
+					CHECK(log.Entries[1].Offset==3U);
+					CHECK(log.Entries[2].Type==EncodingErrorType::Lossy);
+					CHECK(log.Entries[2].Offset==3U);
+				
+				}
+			
+			}
+			
+			GIVEN("A replacement for lossy errors which cannot be represented") {
+			
+				latin1.Lossy.Replace(0x4E2D);
+				
+				THEN("Code points which cannot be represented are removed rather than thrown") {
+				
+					std::vector<unsigned char> expected={'a','b',0xE9};
+					REQUIRE(latin1.Encode(begin,end)==expected);
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("A UTF-8 encoder which reports errors to a log") {
+		
+			UTF8 utf8;
+			utf8.Sink=&log;
+			
+			WHEN("They are encoded") {
+			
+				auto bytes=utf8.Encode(begin,end);
+				
+				THEN("Invalid code points are replaced with U+FFFD") {
+				
+					std::vector<CodePoint> expected={'a',0x4E2D,'b',0xFFFD,0xE9};
+					REQUIRE(utf8.Decode(Begin(bytes),End(bytes))==expected);
+				
+				}
+				
+				THEN("Each error is reported with its type and the offset of its code point") {
+				
+					REQUIRE(log.Entries.size()==1U);
+					CHECK(log.Entries[0].Type==EncodingErrorType::UnicodeStrict);
+					CHECK(log.Entries[0].Offset==3U);
+				
+				}
+			
+			}
+		
+		}
+	
+	}
+
+}
+
+
+SCENARIO("Bytes may be validated and measured without being decoded","[encoding]") {
+
+	GIVEN("A UTF-8 decoder") {
+	
+		UTF8 utf8;
+		
+		GIVEN("Valid UTF-8 containing each kind of line terminator") {
+		
+			String s("a\r\nb\nc\rd\u0085e\u2028f\u2029g\x0B\x0Ch\xC3\xA9\xF0\x9F\x98\x80");
+			auto bytes=utf8.Encode(s);
+			auto begin=Begin(bytes);
+			auto end=End(bytes);
+			
+			THEN("Measuring it finds no error and counts its code points") {
+			
+				auto m=utf8.Measure(begin,end);
+				CHECK(!m.Error);
+				CHECK(m.CodePoints==s.Size());
+				CHECK(m.Lines==0U);
+			
+			}
+			
+			THEN("Measuring it may count its line terminators, counting CR LF as one") {
+			
+				auto m=utf8.Measure(begin,end,true);
+				CHECK(!m.Error);
+				CHECK(m.CodePoints==s.Size());
+				CHECK(m.Lines==8U);
+			
+			}
+		
+		}
+		
+		GIVEN("UTF-8 containing an invalid byte") {
+		
+			const unsigned char bytes []={'a',0xC3,0xA9,'\n',0xFF,'b','\n'};
+			auto begin=std::begin(bytes);
+			auto end=std::end(bytes);
+			
+			THEN("Measuring it finds the first error and counts what precedes it") {
+			
+				auto m=utf8.Measure(begin,end,true);
+				REQUIRE(m.Error);
+				CHECK(m.Error->Type==EncodingErrorType::Strict);
+				CHECK(m.Error->Offset==4U);
+				CHECK(m.CodePoints==3U);
+				CHECK(m.Lines==1U);
+			
+			}
+			
+			GIVEN("Such errors are replaced") {
+			
+				utf8.Strict.Replace('?');
+				
+				THEN("They are still found") {
+				
+					auto m=utf8.Measure(begin,end);
+					REQUIRE(m.Error);
+					CHECK(m.Error->Offset==4U);
+				
+				}
+			
+			}
+			
+			GIVEN("Such errors are ignored") {
+			
+				utf8.Strict.Ignore();
+				
+				THEN("They are skipped as they would be when decoding") {
+				
+					auto m=utf8.Measure(begin,end,true);
+					CHECK(!m.Error);
+					CHECK(m.CodePoints==5U);
+					CHECK(m.Lines==2U);
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("UTF-8 which ends part way through a sequence") {
+		
+			const unsigned char bytes []={'a','b',0xE2,0x82};
+			auto begin=std::begin(bytes);
+			auto end=std::end(bytes);
+			
+			THEN("Measuring it finds an unexpected end") {
+			
+				auto m=utf8.Measure(begin,end);
+				REQUIRE(m.Error);
+				CHECK(m.Error->Type==EncodingErrorType::UnexpectedEnd);
+				CHECK(m.Error->Offset==2U);
+				CHECK(m.CodePoints==2U);
+			
+			}
+		
+		}
+	
+	}
+	
+	GIVEN("Decoders for several encodings") {
+	
+		UTF8 utf8;
+		UTF16 utf16(Endianness::Little);
+		UTF32 utf32(Endianness::Big);
+		UCS2 ucs2(Endianness::Little);
+		Latin1 latin1;
+		Encoding * decoders []={&utf8,&utf16,&utf32,&ucs2,&latin1};
+		
+		GIVEN("Long text including line terminators, encoded in each of them") {
+		
+			std::vector<CodePoint> cps;
+			const CodePoint::Type samples []={0xE9,'\r','\n',0x4E2D,0x1D11E,0x85,0x2028,0xFF21};
+			for (std::size_t i=0;cps.size()<20000;++i) {
+			
+				for (std::size_t j=0;j<(i%23);++j) cps.push_back('a'+(j%26));
+				for (std::size_t j=0;j<(i%5);++j) cps.push_back(samples[(i+j)%8]);
+			
+			}
+			
+			THEN("Measuring each gives the same results as decoding and then counting") {
+			
+				for (auto decoder : decoders) {
+				
+					decoder->Lossy.Ignore();
+					auto bytes=decoder->Encode(Begin(cps),End(cps));
+					auto begin=Begin(bytes);
+					auto end=End(bytes);
+					auto decoded=decoder->Decode(begin,end);
+					std::size_t lines=0;
+					const CodePoint * e=End(decoded);
+					for (const CodePoint * b=Begin(decoded);(b=FindLineTerminator(b,e))!=e;++lines) {
+					
+						if ((*b=='\r') && ((b+1)!=e) && (b[1]=='\n')) ++b;
+						++b;
+					
+					}
+					
+					auto m=decoder->Measure(begin,end,true);
+					CHECK(!m.Error);
+					CHECK(m.CodePoints==decoded.size());
+					CHECK(m.Lines==lines);
+					
+					//	Breaking the encoding anywhere is found
+					//	at the same location decoding throws
+					for (std::size_t i=1;i<bytes.size();i+=997) {
+					
+						auto broken=bytes;
+						broken[i]=0xFF;
+						broken[i-1]=0xDF;
+						
+						std::optional<EncodingError> error;
+						try {
+						
+							decoder->Decode(Begin(broken),End(broken));
+						
+						} catch (const EncodingError & e) {
+						
+							error=e;
+						
+						}
+						
+						m=decoder->Measure(Begin(broken),End(broken));
+						REQUIRE(static_cast<bool>(m.Error)==static_cast<bool>(error));
+						if (!error) continue;
+						CHECK(m.Error->Type==error->type());
+						CHECK((Begin(broken)+m.Error->Offset)==error->where());
+					
+					}
+				
+				}
+			
+			}
+		
+		}
+	
+	}
+
+}
+
+//
+//	FLOATING POINT CONVERSION
+//
+
+
+SCENARIO("Floating point values may be converted to strings","[converter]") {
+
+	GIVEN("A float converter") {
+	
+		Converter<float> c;
+		
+		GIVEN("The largest float value") {
+		
+			auto f=std::numeric_limits<float>::max();
+			
+			GIVEN("A string containing this value") {
+			
+				auto s=Get(f);
+				
+				THEN("Converting the former to a Unicode string results in the latter") {
+				
+					REQUIRE(IsEqual(c(f),s));
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("The smallest float value") {
+		
+			auto f=std::numeric_limits<float>::min();
+			
+			GIVEN("A string containing this value") {
+			
+				auto s=Get(f);
+				
+				THEN("Converting the former to a Unicode string results in the latter") {
+				
+					REQUIRE(IsEqual(c(f),s));
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("The epsilon value") {
+		
+			auto f=std::numeric_limits<float>::epsilon();
+			
+			GIVEN("A string containing this value") {
+			
+				auto s=Get(f);
+				
+				THEN("Converting the former to a Unicode string results in the latter") {
+				
+					REQUIRE(IsEqual(c(f),s));
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("The infinity value") {
+		
+			auto f=std::numeric_limits<float>::infinity();
+			
+			GIVEN("A string containing this value") {
+			
+				auto s=Get(f);
+				
+				THEN("Converting the former to a Unicode string results in the latter") {
+				
+					REQUIRE(IsEqual(c(f),s));
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("The NaN value") {
+		
+			auto f=std::numeric_limits<float>::quiet_NaN();
+		
+			GIVEN("A string containing this value") {
+			
+				auto s=Get(f);
+				
+				THEN("Converting the former to a Unicode string results in the latter") {
+				
+					REQUIRE(IsEqual(c(f),s));
+				
+				}
+			
+			}
+		
+		}
+	
+	}
+
+}
+
+
+SCENARIO("Strings may be converted to floating point values","[converter]") {
+
+	GIVEN("A float converter") {
+	
+		Converter<float> c;
+		
+		THEN("The empty string represented as two null pointers is not found to represent an integer") {
+		
+			REQUIRE_THROWS_AS(c(nullptr,nullptr),ConversionError);
 		
 		}
 		
@@ -1955,6 +4091,110 @@ SCENARIO("Unicode code points may be extracted from C++ streams","[iostream]") {
 }
 
 
+SCENARIO("Lines and code points may be extracted from long C++ streams","[iostream]") {
+
+	GIVEN("Many lines of various lengths, some longer than the blocks in which streams are read, separated by every kind of line terminator") {
+	
+		std::vector<String> lines;
+		String text;
+		const char * const terminators []={"\n","\r\n","\r",u8"\u0085",u8"\u2028","\v"};
+		for (std::size_t i=0;i<600;++i) {
+		
+			String line;
+			auto length=(i%50==0) ? 5000 : (i*7)%97;
+			for (std::size_t j=0;j<length;++j) line << CodePoint((j%3==0) ? U'é' : ((j%3==1) ? U'中' : U'\U0001D11E'));
+			
+			if (i!=0) text << String(terminators[i%6]);
+			text << line;
+			lines.push_back(std::move(line));
+		
+		}
+		
+		GIVEN("An 8-bit character input/output stream containing the lines") {
+		
+			std::stringstream ss;
+			ss << text;
+			
+			THEN("Each line may be extracted") {
+			
+				std::vector<String> out;
+				for (String line;ss >> line;) out.push_back(line);
+				
+				REQUIRE(out.size()==lines.size());
+				for (std::size_t i=0;i<lines.size();++i) REQUIRE(IsEqual(out[i],lines[i]));
+			
+			}
+		
+		}
+		
+		GIVEN("A 16-bit character input/output stream containing the lines") {
+		
+			std::basic_stringstream<char16_t> ss;
+			ss << text;
+			
+			THEN("Each line may be extracted") {
+			
+				std::vector<String> out;
+				for (String line;ss >> line;) out.push_back(line);
+				
+				REQUIRE(out.size()==lines.size());
+				for (std::size_t i=0;i<lines.size();++i) REQUIRE(IsEqual(out[i],lines[i]));
+			
+			}
+		
+		}
+	
+	}
+	
+	GIVEN("An 8-bit character input/output stream containing a CR and LF which are read in different blocks") {
+	
+		std::stringstream ss;
+		ss << std::string(4095,'a') << "\r\nb";
+		
+		THEN("They are a single line terminator") {
+		
+			String out1;
+			String out2;
+			ss >> out1 >> out2;
+			
+			CHECK(out1.Size()==4095U);
+			CHECK(IsEqual(out2,String("b")));
+			CHECK(ss.eof());
+			CHECK(ss);
+		
+		}
+	
+	}
+	
+	GIVEN("An 8-bit character input/output stream containing several lines") {
+	
+		std::stringstream ss;
+		ss << String(u8"ab\nςd\ne");
+		
+		THEN("Extracting code points and lines may be interleaved") {
+		
+			CodePoint cp1;
+			String line1;
+			CodePoint cp2;
+			String line2;
+			String line3;
+			ss >> cp1 >> line1 >> cp2 >> line2 >> line3;
+			
+			CHECK(cp1=='a');
+			CHECK(IsEqual(line1,String("b")));
+			CHECK(cp2==U'ς');
+			CHECK(IsEqual(line2,String("d")));
+			CHECK(IsEqual(line3,String("e")));
+			CHECK(ss.eof());
+			CHECK(ss);
+		
+		}
+	
+	}
+
+}
+
+
 //
 //	INTEGER CONVERSION
 //
@@ -2501,6 +4741,152 @@ SCENARIO("Strings may be encoded to Latin-1","[latin1]") {
 }
 
 
+//
+//	LOAD FILE
+//
+
+
+SCENARIO("Text files may be loaded into strings","[loadfile]") {
+
+	GIVEN("A long string") {
+	
+		std::vector<CodePoint> cps;
+		const CodePoint::Type samples []={0xE9,0x200B,0x1D11E,0xFF21,0x4E2D};
+		for (std::size_t i=0;cps.size()<600000;++i) {
+		
+			for (std::size_t j=0;j<(i%29);++j) cps.push_back('a'+(j%26));
+			for (std::size_t j=0;j<(i%7);++j) cps.push_back(samples[(i+j)%5]);
+		
+		}
+		String str(cps);
+		const char * filename="test.txt";
+		
+		GIVEN("That string written to files with a BOM in several encodings") {
+		
+			UTF8 utf8;
+			utf8.OutputBOM=true;
+			UTF16 utf16be(Endianness::Big);
+			UTF16 utf16le(Endianness::Little);
+			UTF32 utf32be(Endianness::Big);
+			UTF32 utf32le(Endianness::Little);
+			const Encoding * encoders []={&utf8,&utf16be,&utf16le,&utf32be,&utf32le};
+			
+			THEN("Loading each file gives the string") {
+			
+				for (auto encoder : encoders) {
+				
+					WriteFile(filename,encoder->Encode(str));
+					REQUIRE(LoadFile(filename).CodePoints()==cps);
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("That string written to a file in UTF-8 without a BOM") {
+		
+			UTF8 utf8;
+			WriteFile(filename,utf8.Encode(str));
+			
+			THEN("Loading that file gives the string") {
+			
+				REQUIRE(LoadFile(filename).CodePoints()==cps);
+			
+			}
+		
+		}
+		
+		GIVEN("That string written to a file in Latin-1") {
+		
+			Latin1 latin1;
+			latin1.Lossy.Ignore();
+			auto buffer=latin1.Encode(str);
+			WriteFile(filename,buffer);
+			
+			THEN("Loading that file as Latin-1 gives the same results as decoding it") {
+			
+				REQUIRE(LoadFile(filename,latin1).CodePoints()==latin1.Decode(Begin(buffer),End(buffer)));
+			
+			}
+		
+		}
+		
+		std::remove(filename);
+	
+	}
+	
+	GIVEN("An empty file") {
+	
+		const char * filename="test.txt";
+		WriteFile(filename,{});
+		
+		THEN("Loading it gives the empty string") {
+		
+			REQUIRE(LoadFile(filename).Size()==0U);
+		
+		}
+		
+		std::remove(filename);
+	
+	}
+	
+	GIVEN("A file which does not exist") {
+	
+		THEN("It cannot be loaded") {
+		
+			REQUIRE_THROWS_AS(LoadFile("does not exist.txt"),std::runtime_error);
+		
+		}
+	
+	}
+	
+	#ifndef _WIN32
+	GIVEN("A named pipe to which a long string is written") {
+	
+		std::vector<CodePoint> cps;
+		for (std::size_t i=0;cps.size()<100000;++i) cps.push_back((i%7==0) ? 0x4E2D : ('a'+(i%26)));
+		UTF8 utf8;
+		auto buffer=utf8.Encode(cps);
+		const char * filename="test.fifo";
+		std::remove(filename);
+		REQUIRE(mkfifo(filename,0600)==0);
+		
+		THEN("Loading it gives the string") {
+		
+			//	Opening either end of the pipe blocks until
+			//	the other end is opened
+			std::thread writer([&] () {	WriteFile(filename,buffer);	});
+			auto str=LoadFile(filename);
+			writer.join();
+			
+			REQUIRE(str.CodePoints()==cps);
+		
+		}
+		
+		std::remove(filename);
+	
+	}
+	#endif
+	
+	#ifdef __linux__
+	GIVEN("A file in /proc, which reports a size of zero") {
+	
+		const char * filename="/proc/self/status";
+		
+		THEN("Loading it gives its contents") {
+		
+			auto str=LoadFile(filename);
+			REQUIRE(str.ToString().compare(0,5,"Name:")==0);
+		
+		}
+	
+	}
+	#endif
+
+}
+
+
 //
 //	LOCALE
 //
@@ -2555,18 +4941,395 @@ SCENARIO("Information about code points can be retrieved from the global locale"
 		THEN("Code points for which information exists may be looked up") {
 		
 			auto cpi=DefaultLocale.GetInfo('A');
+			auto record=DefaultLocale.GetRecord('A');
+			
+			REQUIRE(cpi!=nullptr);
+			REQUIRE(record!=nullptr);
+			REQUIRE(record->CodePoint==static_cast<unsigned char>('A'));
+			REQUIRE(&DefaultLocale.Info[record->Info]==cpi);
+			REQUIRE(DefaultLocale.GetName('A')=="LATIN CAPITAL LETTER A");
+		
+		}
+		
+		THEN("Code points with identical properties share information") {
+		
+			auto a=DefaultLocale.GetInfo(static_cast<CodePoint::Type>(0x2E81));
+			auto b=DefaultLocale.GetInfo(static_cast<CodePoint::Type>(0x2E82));
+			
+			REQUIRE(a!=nullptr);
+			REQUIRE(a==b);
+			CHECK(DefaultLocale.GetName(0x2E81)=="CJK RADICAL CLIFF");
+			REQUIRE(DefaultLocale.GetName(0x2E82)=="CJK RADICAL SECOND ONE");
+		
+		}
+		
+		THEN("The blocks and scripts of code points may be identified") {
+		
+			auto a=DefaultLocale.GetInfo('A');
+			auto han=DefaultLocale.GetInfo(static_cast<CodePoint::Type>(0x4E00));
+			
+			REQUIRE(a!=nullptr);
+			REQUIRE(han!=nullptr);
+			REQUIRE(DefaultLocale.BlockNames[0]==nullptr);
+			REQUIRE(DefaultLocale.ScriptNames[0]==nullptr);
+			REQUIRE(a->Block!=han->Block);
+			REQUIRE(a->Block==DefaultLocale.FindBlock("Basic Latin"));
+			REQUIRE(std::strcmp(DefaultLocale.BlockNames[a->Block],"Basic Latin")==0);
+			REQUIRE(a->Script==DefaultLocale.FindScript("Latin"));
+			REQUIRE(std::strcmp(DefaultLocale.ScriptNames[a->Script],"Latin")==0);
+			REQUIRE(han->Block==DefaultLocale.FindBlock("CJK Unified Ideographs"));
+			REQUIRE(han->Script==DefaultLocale.FindScript("Han"));
+			REQUIRE(DefaultLocale.FindBlock("No Such Block")==0);
+			REQUIRE(DefaultLocale.FindScript("No Such Script")==0);
+		
+		}
+		
+		THEN("Binary properties of code points may be tested together") {
+		
+			auto a=DefaultLocale.GetInfo('A');
+			auto space=DefaultLocale.GetInfo(' ');
+			
+			REQUIRE(a!=nullptr);
+			REQUIRE(space!=nullptr);
+			REQUIRE(a->HasAll(BinaryProperty::Alphabetic|BinaryProperty::Uppercase|BinaryProperty::Cased));
+			REQUIRE(a->HasAll(BinaryProperty::HexDigit|BinaryProperty::ASCIIHexDigit));
+			REQUIRE(!a->HasAll(BinaryProperty::Uppercase|BinaryProperty::Lowercase));
+			REQUIRE(a->HasAny(BinaryProperty::Cased|BinaryProperty::CaseIgnorable));
+			REQUIRE(!a->HasAny(BinaryProperty::WhiteSpace|BinaryProperty::Dash));
+			REQUIRE(space->HasAny(BinaryProperty::WhiteSpace));
+			REQUIRE(DefaultLocale.GetBinaryProperties('A')==a->Flags);
+			REQUIRE(DefaultLocale.GetBinaryProperties(static_cast<CodePoint::Type>(0x110000))==0);
+		
+		}
+		
+		THEN("Code points for which information does not exist cannot be looked up") {
+		
+			auto cpi=DefaultLocale.GetInfo(static_cast<CodePoint::Type>(0x10FFFE));
+			REQUIRE(cpi==nullptr);
+		
+		}
+		
+		THEN("Code points outside the Unicode code space cannot be looked up") {
+		
+			auto cpi=DefaultLocale.GetInfo(static_cast<CodePoint::Type>(0x110000));
+			REQUIRE(cpi==nullptr);
+		
+		}
+	
+	}
+
+}
+
+
+SCENARIO("Information about code points within ranges can be retrieved","[locale]") {
+
+	GIVEN("A code point within the CJK Unified Ideographs block") {
+	
+		CodePoint cp(0x4E01);
+		
+		THEN("Information about it may be looked up") {
+		
+			auto cpi=DefaultLocale.GetInfo(cp);
+			auto record=DefaultLocale.GetRecord(cp);
+			
+			REQUIRE(cpi!=nullptr);
+			REQUIRE(record!=nullptr);
+			REQUIRE(record->CodePoint<=cp);
+			REQUIRE(record->Last>=cp);
+			REQUIRE(cpi->HasAny(BinaryProperty::UnifiedIdeograph));
+			REQUIRE(cpi->GeneralCategory==GeneralCategory::Lo);
+		
+		}
+		
+		THEN("Its name is derived from its code point") {
+		
+			REQUIRE(cp.GetName()=="CJK UNIFIED IDEOGRAPH-4E01");
+		
+		}
+	
+	}
+	
+	GIVEN("A supplementary code point within a CJK Unified Ideographs Extension block") {
+	
+		CodePoint cp(0x20001);
+		
+		THEN("Its name is derived from its code point") {
+		
+			REQUIRE(cp.GetName()=="CJK UNIFIED IDEOGRAPH-20001");
+		
+		}
+	
+	}
+	
+	GIVEN("Hangul syllables") {
+	
+		CodePoint lv(0xAC00);
+		CodePoint lvt(0xAC01);
+		
+		THEN("Their names are derived from their jamo") {
+		
+			CHECK(lv.GetName()=="HANGUL SYLLABLE GA");
+			CHECK(lvt.GetName()=="HANGUL SYLLABLE GAG");
+			REQUIRE(CodePoint(0xD4DB).GetName()=="HANGUL SYLLABLE PWILH");
+		
+		}
+		
+		THEN("Properties which differ within the range are retrieved correctly") {
+		
+			CHECK(DefaultLocale.GetGraphemeClusterBreak(lv)==GraphemeClusterBreak::LV);
+			REQUIRE(DefaultLocale.GetGraphemeClusterBreak(lvt)==GraphemeClusterBreak::LVT);
+		
+		}
+	
+	}
+	
+	GIVEN("A private use code point") {
+	
+		CodePoint cp(0xE001);
+		
+		THEN("Information about it may be looked up") {
+		
+			auto cpi=DefaultLocale.GetInfo(cp);
 			
 			REQUIRE(cpi!=nullptr);
-			REQUIRE(cpi->Name!=nullptr);
-			REQUIRE(cpi->CodePoint==static_cast<unsigned char>('A'));
-			REQUIRE(std::strcmp(cpi->Name,"LATIN CAPITAL LETTER A")==0U);
+			REQUIRE(cpi->GeneralCategory==GeneralCategory::Co);
+		
+		}
+		
+		THEN("It has no name") {
+		
+			REQUIRE(cp.GetName().size()==0U);
+		
+		}
+	
+	}
+	
+	GIVEN("A code point which is not within a range") {
+	
+		THEN("Its name is retrieved") {
+		
+			REQUIRE(CodePoint('A').GetName()=="LATIN CAPITAL LETTER A");
+		
+		}
+	
+	}
+
+}
+
+
+SCENARIO("Looking up code points through lookup tables gives the same results as searching","[locale]") {
+
+	GIVEN("A locale without an index or a direct lookup table") {
+	
+		Locale l(DefaultLocale);
+		l.InfoIndex=CodePointIndex{};
+		l.Latin1Info={};
+		
+		THEN("The default locale has an index") {
+		
+			REQUIRE(!DefaultLocale.InfoIndex.IsEmpty());
+		
+		}
+		
+		THEN("The default locale has a direct lookup table for the Latin-1 range") {
+		
+			REQUIRE(DefaultLocale.Latin1Info.size()==256U);
+		
+		}
+		
+		THEN("Every code point is looked up identically in both locales") {
+		
+			CodePoint::Type mismatch=0;
+			bool matched=true;
+			for (CodePoint::Type cp=0;cp<=CodePoint::Max;++cp) if (DefaultLocale.GetInfo(cp)!=l.GetInfo(cp)) {
+			
+				mismatch=cp;
+				matched=false;
+				
+				break;
+			
+			}
+			
+			INFO("Mismatch at " << Catch::toString(CodePoint(mismatch)));
+			REQUIRE(matched);
+		
+		}
+	
+	}
+
+}
+
+
+SCENARIO("Packed properties give the same results as CodePointInfo structures","[locale]") {
+
+	GIVEN("A locale without packed property tables") {
+	
+		Locale l(DefaultLocale);
+		l.Properties=PropertyTables{};
+		
+		THEN("The default locale has packed property tables") {
+		
+			REQUIRE(!DefaultLocale.Properties.CanonicalCombiningClass.IsEmpty());
+			REQUIRE(!DefaultLocale.Properties.GraphemeClusterBreak.IsEmpty());
+			REQUIRE(!DefaultLocale.Properties.NFCQuickCheck.IsEmpty());
+		
+		}
+		
+		THEN("Every property of every code point is the same in both locales") {
+		
+			CodePoint::Type mismatch=0;
+			bool matched=true;
+			for (CodePoint::Type cp=0;cp<=CodePoint::Max;++cp) if (!(
+				(DefaultLocale.GetCanonicalCombiningClass(cp)==l.GetCanonicalCombiningClass(cp)) &&
+				(DefaultLocale.GetGeneralCategory(cp)==l.GetGeneralCategory(cp)) &&
+				(DefaultLocale.GetGraphemeClusterBreak(cp)==l.GetGraphemeClusterBreak(cp)) &&
+				(DefaultLocale.GetWordBreak(cp)==l.GetWordBreak(cp)) &&
+				(DefaultLocale.GetLineBreak(cp)==l.GetLineBreak(cp)) &&
+				(DefaultLocale.GetNFCQuickCheck(cp)==l.GetNFCQuickCheck(cp)) &&
+				(DefaultLocale.GetNFDQuickCheck(cp)==l.GetNFDQuickCheck(cp))
+			)) {
+			
+				mismatch=cp;
+				matched=false;
+				
+				break;
+			
+			}
+			
+			INFO("Mismatch at " << Catch::toString(CodePoint(mismatch)));
+			REQUIRE(matched);
+		
+		}
+	
+	}
+	
+	GIVEN("A code point with a non-zero canonical combining class") {
+	
+		CodePoint cp(0x301);
+		
+		THEN("Its canonical combining class is retrieved") {
+		
+			REQUIRE(DefaultLocale.GetCanonicalCombiningClass(cp)==230);
+		
+		}
+	
+	}
+	
+	GIVEN("A code point outside the Unicode code space") {
+	
+		CodePoint cp(0x110000);
+		
+		THEN("Its properties take on their default values") {
+		
+			REQUIRE(DefaultLocale.GetCanonicalCombiningClass(cp)==0);
+			REQUIRE(DefaultLocale.GetGeneralCategory(cp)==GeneralCategory::Cn);
+			REQUIRE(DefaultLocale.GetGraphemeClusterBreak(cp)==GraphemeClusterBreak::XX);
+			REQUIRE(DefaultLocale.GetNFCQuickCheck(cp)==QuickCheck::Yes);
+		
+		}
+	
+	}
+
+}
+
+
+SCENARIO("Properties of ranges of code points are the same as those of individual code points","[locale]") {
+
+	//	Every code point, followed by code points in
+	//	an order which alternates between blocks, and
+	//	code points outside the Unicode code space
+	std::vector<CodePoint> cps;
+	for (CodePoint::Type cp=0;cp<=CodePoint::Max;++cp) cps.push_back(cp);
+	for (CodePoint::Type cp=0;cp<0x400U;++cp) cps.push_back((cp*0x3F1U)&0xFFFFU);
+	cps.push_back(0x110000U);
+	cps.push_back(0xFFFFFFFFU);
+	auto begin=cps.data();
+	auto end=begin+cps.size();
+	
+	auto check=[&] (const Locale & l) {
+	
+		std::vector<const CodePointInfo *> info(cps.size());
+		l.GetInfo(begin,end,info.data());
+		std::vector<std::size_t> ccc(cps.size());
+		l.GetCanonicalCombiningClass(begin,end,ccc.data());
+		std::vector<GeneralCategory> gc(cps.size());
+		l.GetGeneralCategory(begin,end,gc.data());
+		std::vector<GraphemeClusterBreak> gcb(cps.size());
+		l.GetGraphemeClusterBreak(begin,end,gcb.data());
+		std::vector<WordBreak> wb(cps.size());
+		l.GetWordBreak(begin,end,wb.data());
+		std::vector<LineBreak> lb(cps.size());
+		l.GetLineBreak(begin,end,lb.data());
+		std::vector<QuickCheck> nfc(cps.size());
+		l.GetNFCQuickCheck(begin,end,nfc.data());
+		std::vector<QuickCheck> nfd(cps.size());
+		l.GetNFDQuickCheck(begin,end,nfd.data());
+		std::vector<std::uint64_t> flags(cps.size());
+		l.GetBinaryProperties(begin,end,flags.data());
+		
+		std::size_t mismatch=0;
+		bool matched=true;
+		for (std::size_t i=0;i<cps.size();++i) {
+		
+			auto cp=cps[i];
+			if (!(
+				(info[i]==l.GetInfo(cp)) &&
+				(ccc[i]==l.GetCanonicalCombiningClass(cp)) &&
+				(gc[i]==l.GetGeneralCategory(cp)) &&
+				(gcb[i]==l.GetGraphemeClusterBreak(cp)) &&
+				(wb[i]==l.GetWordBreak(cp)) &&
+				(lb[i]==l.GetLineBreak(cp)) &&
+				(nfc[i]==l.GetNFCQuickCheck(cp)) &&
+				(nfd[i]==l.GetNFDQuickCheck(cp)) &&
+				(flags[i]==l.GetBinaryProperties(cp))
+			)) {
+			
+				mismatch=i;
+				matched=false;
+				
+				break;
+			
+			}
+		
+		}
+		
+		INFO("Mismatch at " << Catch::toString(cps[mismatch]));
+		REQUIRE(matched);
+	
+	};
+	
+	GIVEN("The default locale") {
+	
+		THEN("Properties are retrieved identically") {
+		
+			check(DefaultLocale);
+		
+		}
+	
+	}
+	
+	GIVEN("A locale without packed property tables") {
+	
+		Locale l(DefaultLocale);
+		l.Properties=PropertyTables{};
+		
+		THEN("Properties are retrieved identically") {
+		
+			check(l);
 		
 		}
+	
+	}
+	
+	GIVEN("A locale without an index or a direct lookup table for the Latin-1 range") {
+	
+		Locale l(DefaultLocale);
+		l.InfoIndex=CodePointIndex{};
+		l.Latin1Info=decltype(l.Latin1Info){};
 		
-		THEN("Code points for which information does not exist cannot be looked up") {
+		THEN("Properties are retrieved identically") {
 		
-			auto cpi=DefaultLocale.GetInfo(static_cast<CodePoint::Type>(0x10FFFE));
-			REQUIRE(cpi==nullptr);
+			check(l);
 		
 		}
 	
@@ -2739,6 +5502,84 @@ SCENARIO("Strings may be placed in Normal Form Canonical Composition","[normaliz
 			
 		}
 	
+		
+		GIVEN("A string containing LATIN SMALL LETTER Q, COMBINING ACUTE ACCENT, LATIN SMALL LETTER E, COMBINING ACUTE ACCENT") {
+		
+			String s("q́é");
+			
+			GIVEN("A string containing LATIN SMALL LETTER Q, COMBINING ACUTE ACCENT, LATIN SMALL LETTER E WITH ACUTE") {
+			
+				String s2("q́é");
+				
+				THEN("They are congruent in Normal Form Canonical Composition") {
+				
+					REQUIRE(IsEqual(n.ToNFC(s.begin(),s.end()),s2));
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("A string containing HANGUL SYLLABLE HAN") {
+		
+			String s("한");
+			
+			THEN("It is considered to be in Normal Form Canonical Composition") {
+			
+				REQUIRE(n.IsNFC(s.begin(),s.end()));
+			
+			}
+			
+			GIVEN("A string containing HANGUL CHOSEONG HIEUH, HANGUL JUNGSEONG A, HANGUL JONGSEONG NIEUN") {
+			
+				String s2("한");
+				
+				THEN("The former decomposes to the latter") {
+				
+					REQUIRE(IsEqual(n.ToNFD(s.begin(),s.end()),s2));
+				
+				}
+				
+				THEN("The latter composes to the former") {
+				
+					REQUIRE(IsEqual(n.ToNFC(s2.begin(),s2.end()),s));
+				
+				}
+			
+			}
+			
+			GIVEN("A string containing HANGUL SYLLABLE HA, HANGUL JONGSEONG NIEUN") {
+			
+				String s2("한");
+				
+				THEN("The latter composes to the former") {
+				
+					REQUIRE(IsEqual(n.ToNFC(s2.begin(),s2.end()),s));
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("A string containing HANGUL CHOSEONG KIYEOK, HANGUL CHOSEONG KIYEOK, HANGUL JUNGSEONG A") {
+		
+			String s("ᄀ가");
+			
+			GIVEN("A string containing HANGUL CHOSEONG KIYEOK, HANGUL SYLLABLE GA") {
+			
+				String s2("ᄀ가");
+				
+				THEN("Only the adjacent jamo compose") {
+				
+					REQUIRE(IsEqual(n.ToNFC(s.begin(),s.end()),s2));
+				
+				}
+			
+			}
+		
+		}
 	}
 
 }
@@ -2921,6 +5762,260 @@ SCENARIO("Unicode code points may be output to C++ streams","[iostream]") {
 }
 
 
+//
+//	PACKED ARRAY
+//
+
+
+SCENARIO("Values may be retrieved from packed arrays","[packedarray]") {
+
+	GIVEN("An array of bytes") {
+	
+		const std::uint8_t bytes []={0xE4,0x1B};
+		
+		THEN("Two bit values are unpacked from the least significant bits first") {
+		
+			PackedArray<2> arr;
+			arr.Data=MakeArray(bytes);
+			
+			REQUIRE(arr[0]==0);
+			REQUIRE(arr[1]==1);
+			REQUIRE(arr[2]==2);
+			REQUIRE(arr[3]==3);
+			REQUIRE(arr[4]==3);
+			REQUIRE(arr[7]==0);
+		
+		}
+		
+		THEN("Four bit values are unpacked from the least significant bits first") {
+		
+			PackedArray<4> arr;
+			arr.Data=MakeArray(bytes);
+			
+			REQUIRE(arr[0]==0x4);
+			REQUIRE(arr[1]==0xE);
+			REQUIRE(arr[2]==0xB);
+			REQUIRE(arr[3]==0x1);
+		
+		}
+		
+		THEN("Eight bit values are the bytes themselves") {
+		
+			PackedArray<8> arr;
+			arr.Data=MakeArray(bytes);
+			
+			REQUIRE(arr[0]==0xE4);
+			REQUIRE(arr[1]==0x1B);
+		
+		}
+	
+	}
+
+}
+
+
+//
+//	SINGLE BYTE
+//
+
+
+SCENARIO("Windows code pages may be decoded and encoded","[singlebyte]") {
+
+	GIVEN("A Windows-1252 encoder/decoder") {
+	
+		SingleByte encoder(SingleByte::Windows1252);
+		
+		GIVEN("Bytes containing ASCII and characters outside Latin-1") {
+		
+			//	EURO SIGN (U+20AC), LATIN SMALL LETTER E WITH
+			//	ACUTE (U+00E9), and LEFT DOUBLE QUOTATION MARK
+			//	(U+201C)
+			std::vector<unsigned char> buffer={'a',0x80,0xE9,0x93};
+			std::vector<CodePoint> cps={'a',0x20ACU,0xE9U,0x201CU};
+			
+			THEN("Decoding them gives the code points they represent") {
+			
+				REQUIRE(encoder.Decode(Begin(buffer),End(buffer))==cps);
+			
+			}
+			
+			THEN("Encoding the code points gives the bytes") {
+			
+				REQUIRE(encoder.Encode(Begin(cps),End(cps))==buffer);
+			
+			}
+		
+		}
+		
+		GIVEN("Bytes which represent no code point") {
+		
+			std::vector<unsigned char> buffer={'a',0x81,'b'};
+			
+			THEN("Decoding them results in an exception") {
+			
+				REQUIRE_THROWS_AS(encoder.Decode(Begin(buffer),End(buffer)),EncodingError);
+			
+			}
+			
+			GIVEN("Strict errors are being ignored") {
+			
+				encoder.Strict.Ignore();
+				
+				THEN("Decoding them skips the byte") {
+				
+					std::vector<CodePoint> cps={'a','b'};
+					REQUIRE(encoder.Decode(Begin(buffer),End(buffer))==cps);
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("A code point which cannot be represented") {
+		
+			//	CYRILLIC SMALL LETTER EM (U+043C)
+			CodePoint cp=0x43CU;
+			
+			THEN("It is identified as being unrepresentable") {
+			
+				CHECK(!encoder.CanRepresent(cp));
+				REQUIRE(encoder.Count(cp)==0U);
+			
+			}
+			
+			THEN("Encoding it results in an exception") {
+			
+				REQUIRE_THROWS_AS(encoder.Encode(&cp,&cp+1),EncodingError);
+			
+			}
+		
+		}
+	
+	}
+	
+	GIVEN("A Windows-1251 encoder/decoder") {
+	
+		SingleByte encoder(SingleByte::Windows1251);
+		
+		THEN("Cyrillic may be encoded") {
+		
+			//	CYRILLIC SMALL LETTER EM (U+043C)
+			CodePoint cp=0x43CU;
+			auto encoded=encoder.Encode(&cp,&cp+1);
+			REQUIRE(encoded.size()==1U);
+			REQUIRE(encoded[0]==0xECU);
+		
+		}
+	
+	}
+
+}
+
+
+SCENARIO("ISO-8859 encodings may be decoded and encoded","[singlebyte]") {
+
+	GIVEN("An ISO-8859-15 encoder/decoder") {
+	
+		SingleByte encoder(SingleByte::ISO8859_15);
+		
+		THEN("The byte which represents CURRENCY SIGN (U+00A4) in Latin-1 represents EURO SIGN (U+20AC)") {
+		
+			std::vector<unsigned char> buffer={0xA4};
+			auto decoded=encoder.Decode(Begin(buffer),End(buffer));
+			REQUIRE(decoded.size()==1U);
+			REQUIRE(decoded[0]==0x20ACU);
+		
+		}
+		
+		THEN("CURRENCY SIGN (U+00A4) cannot be represented") {
+		
+			CodePoint cp=0xA4U;
+			REQUIRE(!encoder.CanRepresent(cp));
+		
+		}
+	
+	}
+	
+	GIVEN("An ISO-8859-5 encoder/decoder") {
+	
+		SingleByte encoder(SingleByte::ISO8859_5);
+		
+		GIVEN("A string containing Cyrillic") {
+		
+			String s(u8"мир");
+			
+			THEN("Encoding and then decoding it recovers the string") {
+			
+				auto encoded=encoder.Encode(s);
+				REQUIRE(encoded.size()==3U);
+				REQUIRE(encoder.Decode(Begin(encoded),End(encoded))==s);
+			
+			}
+		
+		}
+	
+	}
+
+}
+
+
+SCENARIO("Every byte of a single byte encoding which represents a code point may be encoded and decoded in bulk","[singlebyte]") {
+
+	const SingleByteTable * tables []={
+		&SingleByte::Windows1250,
+		&SingleByte::Windows1251,
+		&SingleByte::Windows1252,
+		&SingleByte::Windows1253,
+		&SingleByte::Windows1254,
+		&SingleByte::Windows1255,
+		&SingleByte::Windows1256,
+		&SingleByte::Windows1257,
+		&SingleByte::Windows1258,
+		&SingleByte::ISO8859_2,
+		&SingleByte::ISO8859_3,
+		&SingleByte::ISO8859_4,
+		&SingleByte::ISO8859_5,
+		&SingleByte::ISO8859_6,
+		&SingleByte::ISO8859_7,
+		&SingleByte::ISO8859_8,
+		&SingleByte::ISO8859_9,
+		&SingleByte::ISO8859_10,
+		&SingleByte::ISO8859_11,
+		&SingleByte::ISO8859_13,
+		&SingleByte::ISO8859_14,
+		&SingleByte::ISO8859_15,
+		&SingleByte::ISO8859_16
+	};
+	
+	for (auto table : tables) {
+	
+		SingleByte encoder(*table);
+		
+		//	Long runs of ASCII followed by every byte which
+		//	represents a code point, so that both the
+		//	vectorized and table driven paths are taken
+		std::vector<unsigned char> buffer;
+		for (std::size_t i=0;i<4;++i) {
+		
+			buffer.insert(buffer.end(),37,'x');
+			for (std::size_t b=0;b<256;++b) if (table->Decode[b]!=SingleByteTable::Unmapped) buffer.push_back(static_cast<unsigned char>(b));
+		
+		}
+		
+		auto decoded=encoder.Decode(Begin(buffer),End(buffer));
+		CHECK(decoded==DecodeEach(encoder,Begin(buffer),End(buffer)));
+		for (auto cp : decoded) CHECK(encoder.CanRepresent(cp));
+		
+		auto encoded=encoder.Encode(Begin(decoded),End(decoded));
+		CHECK(encoded==EncodeEach(encoder,decoded));
+		REQUIRE(encoded==buffer);
+	
+	}
+
+}
+
+
 //
 //	STRING
 //
@@ -3558,6 +6653,59 @@ SCENARIO("Strings may be converted to C style strings","[string]") {
 }
 
 
+SCENARIO("Strings may be converted to C++ style strings","[string]") {
+
+	GIVEN("A string containing only ASCII") {
+	
+		String s("Hello world");
+		
+		THEN("Converting it to a std::string gives the same code units") {
+		
+			REQUIRE(s.ToString()==std::string("Hello world"));
+		
+		}
+	
+	}
+	
+	GIVEN("A string containing code points which require more than one code unit") {
+	
+		String s(u8"Привет мир \U0001D11E");
+		
+		THEN("Converting it to a std::string gives its UTF-8 encoding") {
+		
+			REQUIRE(s.ToString()==std::string(u8"Привет мир \U0001D11E"));
+		
+		}
+		
+		THEN("Converting it to a std::u16string gives its UTF-16 encoding") {
+		
+			REQUIRE(s.ToString<char16_t>()==std::u16string(u"Привет мир \U0001D11E"));
+		
+		}
+		
+		THEN("Converting it to a std::u32string gives its UTF-32 encoding") {
+		
+			REQUIRE(s.ToString<char32_t>()==std::u32string(U"Привет мир \U0001D11E"));
+		
+		}
+	
+	}
+	
+	GIVEN("An empty string") {
+	
+		String s;
+		
+		THEN("Converting it to a std::string gives an empty string") {
+		
+			REQUIRE(s.ToString().empty());
+		
+		}
+	
+	}
+
+}
+
+
 SCENARIO("Strings may be converted to strings suitable for consumption by operating system APIs","[string]") {
 
 	#ifdef _WIN32
@@ -3711,15 +6859,29 @@ SCENARIO("Strings may be trimmed","[string]") {
 		//	NO-BREAK SPACE (U+00A0)
 		String s(" hello ");
 		
-		GIVEN("The same string, with all leading and trailing white space removed") {
+		GIVEN("The same string, with all leading and trailing white space removed") {
+		
+			String s2("hello");
+			
+			THEN("They are equivalent after being trimmed") {
+			
+				REQUIRE(s.Trim()==s2);
+			
+			}
+		
+		}
+	
+	}
+	
+	GIVEN("A string with leading and trailing white space which uses a locale with no information about any code point") {
+	
+		Locale l;
+		String s("  hello  ");
+		s.SetLocale(l);
+		
+		THEN("Trimming it does not change it") {
 		
-			String s2("hello");
-			
-			THEN("They are equivalent after being trimmed") {
-			
-				REQUIRE(s.Trim()==s2);
-			
-			}
+			REQUIRE(s.Trim().Size()==s.Size());
 		
 		}
 	
@@ -4348,6 +7510,127 @@ SCENARIO("UCS-2 strings may be decoded","[ucs2]") {
 }
 
 
+SCENARIO("Decoding UCS-2 in bulk gives the same results as decoding one code point at a time","[ucs2]") {
+
+	GIVEN("A UCS-2 encoder/decoder") {
+	
+		UCS2 encoder;
+		
+		GIVEN("A long buffer containing runs of code units of various lengths in each byte order") {
+		
+			std::vector<CodePoint> cps;
+			const CodePoint::Type singles []={'a',0xE5,0x4E2D,0xAC00,0xD7FF,0xE000,0xFDCF,0xFDF0,0xFF21,0xFFFD};
+			for (std::size_t i=0;cps.size()<6000;++i) {
+			
+				for (std::size_t j=0;j<(i%41);++j) cps.push_back(singles[(i+j)%10]);
+				cps.push_back(0x3000);
+			
+			}
+			std::vector<std::vector<unsigned char>> buffers;
+			const Endianness orders []={Endianness::Big,Endianness::Little};
+			encoder.OutputBOM=false;
+			for (auto order : orders) {
+			
+				encoder.OutputOrder=order;
+				buffers.push_back(encoder.Encode(cps));
+			
+			}
+			
+			THEN("Decoding each buffer recovers the code points") {
+			
+				for (std::size_t i=0;i<2;++i) {
+				
+					encoder.InputOrder=orders[i];
+					REQUIRE(encoder.Decode(Begin(buffers[i]),End(buffers[i]))==cps);
+				
+				}
+			
+			}
+			
+			GIVEN("Surrogates and noncharacters at various offsets in each buffer") {
+			
+				const UCS2::CodeUnit bad []={0xD800,0xDBFF,0xDC00,0xDFFF,0xFDD0,0xFDEF,0xFFFE,0xFFFF};
+				std::vector<std::vector<unsigned char>> big;
+				std::vector<std::vector<unsigned char>> little;
+				//	At the very beginning some of these would be
+				//	detected as a byte order mark
+				for (auto cu : bad) for (std::size_t offset=1;offset<=(buffers[0].size()/2);offset+=offset/2+1) {
+				
+					const unsigned char b []={static_cast<unsigned char>(cu>>8),static_cast<unsigned char>(cu&255)};
+					auto copy=buffers[0];
+					copy.insert(copy.begin()+(offset*2),std::begin(b),std::end(b));
+					big.push_back(std::move(copy));
+					copy=buffers[1];
+					copy.insert(copy.begin()+(offset*2),std::rbegin(b),std::rend(b));
+					little.push_back(std::move(copy));
+				
+				}
+				
+				THEN("Decoding each buffer raises an exception exactly when decoding one code point at a time does") {
+				
+					for (auto * bs : {&big,&little}) {
+					
+						encoder.InputOrder=(bs==&big) ? Endianness::Big : Endianness::Little;
+						for (auto & b : *bs) RequireDecodesAsEach(encoder,Begin(b),End(b));
+					
+					}
+				
+				}
+				
+				GIVEN("Errors result in a replacement") {
+				
+					encoder.Strict.Replace(0xFFFD);
+					encoder.UnicodeStrict.Replace(0xFFFD);
+					encoder.UnexpectedEnd.Replace(0xFFFD);
+					
+					THEN("Decoding each buffer gives the same results as decoding one code point at a time") {
+					
+						for (auto * bs : {&big,&little}) {
+						
+							encoder.InputOrder=(bs==&big) ? Endianness::Big : Endianness::Little;
+							for (auto & b : *bs) RequireDecodesAsEach(encoder,Begin(b),End(b));
+						
+						}
+					
+					}
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("Surrogates at and on either side of the edges of each vector") {
+		
+			auto runs=SurrogatesAtEdges();
+			
+			THEN("Decoding each run raises an exception exactly when decoding one code point at a time does") {
+			
+				RequireDecodesAsEach(encoder,runs);
+			
+			}
+			
+			GIVEN("Errors result in a replacement") {
+			
+				encoder.Strict.Replace(0xFFFD);
+				encoder.UnicodeStrict.Replace(0xFFFD);
+				encoder.UnexpectedEnd.Replace(0xFFFD);
+				
+				THEN("Decoding each run gives the same results as decoding one code point at a time") {
+				
+					RequireDecodesAsEach(encoder,runs);
+				
+				}
+			
+			}
+		
+		}
+	
+	}
+
+}
+
+
 SCENARIO("Strings may be encoded to UCS-2","[ucs2]") {
 
 	GIVEN("A UCS-2 encoder/decoder") {
@@ -5685,6 +8968,106 @@ SCENARIO("UTF-8 strings may be decoded","[utf8]") {
 }
 
 
+SCENARIO("Decoding UTF-8 in bulk gives the same results as decoding one code point at a time","[utf8]") {
+
+	GIVEN("A UTF-8 encoder/decoder") {
+	
+		UTF8 encoder;
+		
+		GIVEN("A long buffer containing ASCII runs of various lengths and sequences of every length") {
+		
+			std::vector<CodePoint> cps;
+			const CodePoint::Type sequences []={0xE5,0x200B,0x1D11E};
+			for (std::size_t i=0;cps.size()<6000;++i) {
+			
+				for (std::size_t j=0;j<(i%41);++j) cps.push_back('a'+(j%26));
+				cps.push_back(sequences[i%3]);
+			
+			}
+			auto buffer=encoder.Encode(cps);
+			
+			THEN("Decoding the buffer recovers the code points") {
+			
+				REQUIRE(encoder.Decode(Begin(buffer),End(buffer))==cps);
+			
+			}
+			
+			THEN("Constructing a string from the buffer recovers the code points") {
+			
+				buffer.push_back(0);
+				String str(reinterpret_cast<const char *>(Begin(buffer)));
+				REQUIRE(str.CodePoints()==cps);
+			
+			}
+			
+			GIVEN("Ill formed, invalid, and truncated sequences at various offsets in the buffer") {
+			
+				const std::vector<unsigned char> bad []={
+					{0x80},
+					{0xC0,0x80},
+					{0xE2,0x80},
+					{0xED,0xA0,0x80},
+					{0xEF,0xB7,0x90},
+					{0xEF,0xBF,0xBF},
+					{0xF4,0x90,0x80,0x80},
+					{0xF8,0xBF,0xBF,0xBF,0xBF}
+				};
+				std::vector<std::vector<unsigned char>> buffers;
+				for (auto & b : bad) for (std::size_t offset=0;offset<buffer.size();offset+=offset/2+1) {
+				
+					auto copy=buffer;
+					copy.insert(copy.begin()+offset,b.begin(),b.end());
+					buffers.push_back(std::move(copy));
+					
+					//	At the end of the buffer
+					buffers.push_back(buffer);
+					buffers.back().insert(buffers.back().end(),b.begin(),b.end());
+				
+				}
+				
+				THEN("Decoding each buffer raises an exception exactly when decoding one code point at a time does") {
+				
+					for (auto & b : buffers) RequireDecodesAsEach(encoder,Begin(b),End(b));
+				
+				}
+				
+				GIVEN("Errors result in a replacement") {
+				
+					encoder.Strict.Replace(0xFFFD);
+					encoder.UnicodeStrict.Replace(0xFFFD);
+					encoder.UnexpectedEnd.Replace(0xFFFD);
+					
+					THEN("Decoding each buffer gives the same results as decoding one code point at a time") {
+					
+						for (auto & b : buffers) RequireDecodesAsEach(encoder,Begin(b),End(b));
+					
+					}
+				
+				}
+				
+				GIVEN("Errors are ignored") {
+				
+					encoder.Strict.Ignore();
+					encoder.UnicodeStrict.Ignore();
+					encoder.UnexpectedEnd.Ignore();
+					
+					THEN("Decoding each buffer gives the same results as decoding one code point at a time") {
+					
+						for (auto & b : buffers) RequireDecodesAsEach(encoder,Begin(b),End(b));
+					
+					}
+				
+				}
+			
+			}
+		
+		}
+	
+	}
+
+}
+
+
 SCENARIO("Strings may be encoded to UTF-8","[utf8]") {
 
 	GIVEN("A UTF-8 encoder/decoder") {
@@ -6458,6 +9841,160 @@ SCENARIO("UTF-16 strings may be decoded","[utf16]") {
 }
 
 
+SCENARIO("Decoding UTF-16 in bulk gives the same results as decoding one code point at a time","[utf16]") {
+
+	GIVEN("A UTF-16 encoder/decoder") {
+	
+		UTF16 encoder;
+		
+		GIVEN("A long buffer containing runs of code units of various lengths and surrogate pairs in each byte order") {
+		
+			std::vector<CodePoint> cps;
+			const CodePoint::Type singles []={'a',0xE5,0x4E2D,0xAC00,0xD7FF,0xE000,0xFDCF,0xFDF0,0xFF21,0xFFFD};
+			for (std::size_t i=0;cps.size()<6000;++i) {
+			
+				for (std::size_t j=0;j<(i%41);++j) cps.push_back(singles[(i+j)%10]);
+				cps.push_back(0x1F600);
+			
+			}
+			std::vector<std::vector<unsigned char>> buffers;
+			const Endianness orders []={Endianness::Big,Endianness::Little};
+			encoder.OutputBOM=false;
+			for (auto order : orders) {
+			
+				encoder.OutputOrder=order;
+				buffers.push_back(encoder.Encode(cps));
+			
+			}
+			
+			THEN("Decoding each buffer recovers the code points") {
+			
+				for (std::size_t i=0;i<2;++i) {
+				
+					encoder.InputOrder=orders[i];
+					REQUIRE(encoder.Decode(Begin(buffers[i]),End(buffers[i]))==cps);
+				
+				}
+			
+			}
+			
+			GIVEN("Orphaned surrogates and noncharacters at various offsets in each buffer") {
+			
+				const UTF16::CodeUnit bad []={0xD800,0xDBFF,0xDC00,0xDFFF,0xFDD0,0xFDEF,0xFFFE,0xFFFF};
+				std::vector<std::vector<unsigned char>> big;
+				std::vector<std::vector<unsigned char>> little;
+				//	At the very beginning some of these would be
+				//	detected as a byte order mark
+				for (auto cu : bad) for (std::size_t offset=1;offset<=(buffers[0].size()/2);offset+=offset/2+1) {
+				
+					const unsigned char b []={static_cast<unsigned char>(cu>>8),static_cast<unsigned char>(cu&255)};
+					auto copy=buffers[0];
+					copy.insert(copy.begin()+(offset*2),std::begin(b),std::end(b));
+					big.push_back(std::move(copy));
+					copy=buffers[1];
+					copy.insert(copy.begin()+(offset*2),std::rbegin(b),std::rend(b));
+					little.push_back(std::move(copy));
+				
+				}
+				
+				THEN("Decoding each buffer raises an exception exactly when decoding one code point at a time does") {
+				
+					for (auto * bs : {&big,&little}) {
+					
+						encoder.InputOrder=(bs==&big) ? Endianness::Big : Endianness::Little;
+						for (auto & b : *bs) RequireDecodesAsEach(encoder,Begin(b),End(b));
+					
+					}
+				
+				}
+				
+				GIVEN("Errors result in a replacement") {
+				
+					encoder.Strict.Replace(0xFFFD);
+					encoder.UnicodeStrict.Replace(0xFFFD);
+					encoder.UnexpectedEnd.Replace(0xFFFD);
+					
+					THEN("Decoding each buffer gives the same results as decoding one code point at a time") {
+					
+						for (auto * bs : {&big,&little}) {
+						
+							encoder.InputOrder=(bs==&big) ? Endianness::Big : Endianness::Little;
+							for (auto & b : *bs) RequireDecodesAsEach(encoder,Begin(b),End(b));
+						
+						}
+					
+					}
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("Surrogates at and on either side of the edges of each vector") {
+		
+			auto runs=SurrogatesAtEdges();
+			
+			THEN("Surrogate pairs which straddle the edge of a vector are decoded at even and odd addresses") {
+			
+				const Endianness orders []={Endianness::Big,Endianness::Little};
+				for (auto order : orders) for (std::size_t padding=0;padding<2;++padding) for (std::size_t i=0;i<31;++i) {
+				
+					std::vector<std::uint16_t> cus(32,'a');
+					cus[i]=0xD83D;
+					cus[i+1]=0xDE00;
+					std::vector<CodePoint> cps(31,'a');
+					cps[i]=0x1F600;
+					
+					encoder.InputOrder=order;
+					auto b=WriteCodeUnits(cus,order,padding);
+					REQUIRE(encoder.Decode(Begin(b)+padding,End(b))==cps);
+				
+				}
+			
+			}
+			
+			THEN("A lone surrogate in the last lane of a vector raises an exception") {
+			
+				encoder.InputOrder=Endianness::Little;
+				for (std::uint16_t cu : {0xD83D,0xDE00}) for (std::size_t i : {7,15}) {
+				
+					std::vector<std::uint16_t> cus(32,'a');
+					cus[i]=cu;
+					auto b=WriteCodeUnits(cus,Endianness::Little,1);
+					REQUIRE_THROWS_AS(encoder.Decode(Begin(b)+1,End(b)),EncodingError);
+				
+				}
+			
+			}
+			
+			THEN("Decoding each run raises an exception exactly when decoding one code point at a time does") {
+			
+				RequireDecodesAsEach(encoder,runs);
+			
+			}
+			
+			GIVEN("Errors result in a replacement") {
+			
+				encoder.Strict.Replace(0xFFFD);
+				encoder.UnicodeStrict.Replace(0xFFFD);
+				encoder.UnexpectedEnd.Replace(0xFFFD);
+				
+				THEN("Decoding each run gives the same results as decoding one code point at a time") {
+				
+					RequireDecodesAsEach(encoder,runs);
+				
+				}
+			
+			}
+		
+		}
+	
+	}
+
+}
+
+
 SCENARIO("Strings may be encoded to UTF-16","[utf16]") {
 
 	GIVEN("A UTF-16 encoder/decoder") {
@@ -7305,3 +10842,90 @@ SCENARIO("Strings may be encoded to UTF-32","[utf32]") {
 	}
 
 }
+
+
+SCENARIO("UTF-32 is validated in bulk exactly as it is one code point at a time","[utf32]") {
+
+	GIVEN("UTF-32 encoder/decoders in each byte order") {
+	
+		UTF32 be(Endianness::Big,Endianness::Big);
+		UTF32 le(Endianness::Little,Endianness::Little);
+		UTF32 * encoders []={&be,&le};
+		for (auto encoder : encoders) {
+		
+			encoder->OutputBOM=false;
+			encoder->DetectBOM=false;
+		
+		}
+		
+		GIVEN("Code points on either side of each range of invalid code points") {
+		
+			std::vector<CodePoint> cps;
+			const CodePoint::Type samples []={0xD7FF,0xE000,0xFDCF,0xFDF0,0xFFFD,0x10000,0x10FFFD};
+			for (std::size_t i=0;cps.size()<1000;++i) {
+			
+				for (std::size_t j=0;j<(i%11);++j) cps.push_back('a'+(j%26));
+				cps.push_back(samples[i%7]);
+			
+			}
+			
+			THEN("Encoding and then decoding them recovers the code points") {
+			
+				for (auto encoder : encoders) {
+				
+					auto encoded=encoder->Encode(cps);
+					REQUIRE(encoded.size()==(cps.size()*4));
+					CHECK(encoder->Decode(Begin(encoded),End(encoded))==cps);
+					
+					auto m=encoder->Measure(Begin(encoded),End(encoded));
+					CHECK(!m.Error);
+					CHECK(m.CodePoints==cps.size());
+				
+				}
+			
+			}
+		
+		}
+		
+		GIVEN("Buffers with an invalid code unit at various offsets") {
+		
+			const CodePoint::Type invalid []={0xD800,0xDFFF,0xFDD0,0xFDEF,0xFFFE,0x1FFFF,0x10FFFF,0x110000,0xFFFFFFFF};
+			
+			THEN("Decoding and measuring each buffer finds the invalid code unit") {
+			
+				for (auto encoder : encoders) for (std::size_t i=0;i<(sizeof(invalid)/sizeof(*invalid));++i) {
+				
+					std::vector<CodePoint> cps(37,'a');
+					auto offset=(i*5)%cps.size();
+					auto buffer=encoder->Encode(cps);
+					auto cu=invalid[i];
+					unsigned char bytes []={
+						static_cast<unsigned char>(cu>>24),
+						static_cast<unsigned char>(cu>>16),
+						static_cast<unsigned char>(cu>>8),
+						static_cast<unsigned char>(cu)
+					};
+					if (encoder==&le) std::reverse(std::begin(bytes),std::end(bytes));
+					std::copy(std::begin(bytes),std::end(bytes),buffer.begin()+(offset*4));
+					
+					REQUIRE_THROWS_AS(encoder->Decode(Begin(buffer),End(buffer)),EncodingError);
+					
+					auto m=encoder->Measure(Begin(buffer),End(buffer));
+					REQUIRE(m.Error);
+					CHECK(m.Error->Offset==(offset*4));
+					CHECK(m.CodePoints==offset);
+					
+					encoder->UnicodeStrict.Replace(0xFFFD);
+					cps[offset]=0xFFFDU;
+					CHECK(encoder->Decode(Begin(buffer),End(buffer))==cps);
+					encoder->UnicodeStrict.Throw();
+				
+				}
+			
+			}
+		
+		}
+	
+	}
+
+}
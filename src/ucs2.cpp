@@ -15,6 +15,26 @@ namespace Unicode {
 	}
 	
 	
+	const CodePoint * UCS2::BulkCounter (std::size_t & bytes, const CodePoint * begin, const CodePoint * end) const {
+	
+		auto last=begin;
+		for (;(last!=end) && last->IsValid() && (*last<=0xFFFFU);++last);
+		bytes=static_cast<std::size_t>(last-begin)*sizeof(CodeUnit);
+		
+		return last;
+	
+	}
+	
+	
+	void UCS2::BulkEncoder (unsigned char * out, const CodePoint * begin, const CodePoint * end) const {
+	
+		auto reverse=Reverse(OutputOrder);
+		
+		for (;begin!=end;++begin,out+=sizeof(CodeUnit)) Write(out,static_cast<CodeUnit>(*begin),reverse);
+	
+	}
+	
+	
 	std::optional<EncodingErrorType> UCS2::Decoder (
 		CodePoint & cp,
 		const unsigned char * & begin,
@@ -43,6 +63,29 @@ namespace Unicode {
 	}
 	
 	
+	const unsigned char * UCS2::BulkDecoder (
+		CodePoint * & out,
+		const unsigned char * begin,
+		const unsigned char * limit,
+		const unsigned char *,
+		std::optional<Unicode::Endianness> order
+	) const {
+	
+		//	Without a byte order Decoder must raise
+		//	an error
+		if (!order) {
+		
+			if (!InputOrder) return begin;
+			
+			order=*InputOrder;
+		
+		}
+		
+		return DecodeSingle(out,begin,limit,Reverse(*order));
+	
+	}
+	
+	
 	ByteOrderMark UCS2::BOM () const noexcept {
 	
 		return bom;
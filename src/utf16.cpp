@@ -1,4 +1,8 @@
 #include <unicode/utf16.hpp>
+#include "simd.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 
 
 namespace Unicode {
@@ -40,6 +44,140 @@ namespace Unicode {
 	}
 	
 	
+	#ifdef UNICODE_SSE2
+	//	Determines which of four code points are below
+	//	the surrogates, there's no unsigned comparison so
+	//	the sign bit is flipped on both sides
+	static __m128i is_below_surrogates (__m128i v) noexcept {
+	
+		auto sign=_mm_set1_epi32(std::numeric_limits<std::int32_t>::min());
+		
+		return _mm_cmplt_epi32(
+			_mm_xor_si128(v,sign),
+			_mm_xor_si128(_mm_set1_epi32(0xD800),sign)
+		);
+	
+	}
+	#endif
+	
+	
+	//	Finds the end of the run of code points below the
+	//	surrogates (each of which is valid and requires
+	//	exactly one code unit) at the beginning of a range
+	//	of code points
+	static const CodePoint * skip_single (const CodePoint * begin, const CodePoint * end) noexcept {
+	
+		#ifdef UNICODE_SSE2
+		for (;(end-begin)>=4;begin+=4) {
+		
+			auto v=_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+			if (_mm_movemask_epi8(is_below_surrogates(v))!=0xFFFF) break;
+		
+		}
+		#endif
+		
+		for (;(begin!=end) && (*begin<0xD800U);++begin);
+		
+		return begin;
+	
+	}
+	
+	
+	#ifdef UNICODE_SSE2
+	//	Encodes code points below the surrogates eight at
+	//	a time, stops at the first group of eight which
+	//	contains any other code point
+	static void encode_single (unsigned char * & out, const CodePoint * & begin, const CodePoint * end, bool reverse) noexcept {
+	
+		auto bias=_mm_set1_epi32(0x8000);
+		auto unbias=_mm_set1_epi16(std::numeric_limits<std::int16_t>::min());
+		
+		for (;(end-begin)>=8;begin+=8,out+=16) {
+		
+			auto in=reinterpret_cast<const __m128i *>(begin);
+			auto a=_mm_loadu_si128(in);
+			auto b=_mm_loadu_si128(in+1);
+			if (_mm_movemask_epi8(_mm_and_si128(is_below_surrogates(a),is_below_surrogates(b)))!=0xFFFF) break;
+			
+			//	The narrowing saturates signed values, so
+			//	values are shifted into that range and back
+			auto v=_mm_xor_si128(
+				_mm_packs_epi32(_mm_sub_epi32(a,bias),_mm_sub_epi32(b,bias)),
+				unbias
+			);
+			if (reverse) v=_mm_or_si128(_mm_slli_epi16(v,8),_mm_srli_epi16(v,8));
+			
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(out),v);
+		
+		}
+	
+	}
+	#endif
+	
+	
+	const CodePoint * UTF16::BulkCounter (std::size_t & bytes, const CodePoint * begin, const CodePoint * end) const {
+	
+		std::size_t units=0;
+		for (;;) {
+		
+			auto single=skip_single(begin,end);
+			units+=static_cast<std::size_t>(single-begin);
+			begin=single;
+			
+			if ((begin==end) || !begin->IsValid()) break;
+			
+			units+=(*(begin++)>0xFFFFU) ? 2 : 1;
+		
+		}
+		bytes=units*sizeof(CodeUnit);
+		
+		return begin;
+	
+	}
+	
+	
+	void UTF16::BulkEncoder (unsigned char * out, const CodePoint * begin, const CodePoint * end) const {
+	
+		auto reverse=Reverse(OutputOrder);
+		
+		while (begin!=end) {
+		
+			#ifdef UNICODE_SSE2
+			encode_single(out,begin,end,reverse);
+			#endif
+			
+			//	Whatever couldn't be encoded a vector at a
+			//	time is encoded one code point at a time, a
+			//	vector's worth before trying again
+			auto last=begin+std::min<std::ptrdiff_t>(end-begin,8);
+			for (;begin!=last;++begin) {
+			
+				CodePoint::Type cp=*begin;
+				
+				//	Inside BMP, trivial
+				if (cp<=0xFFFFU) {
+				
+					Write(out,static_cast<CodeUnit>(cp),reverse);
+					out+=sizeof(CodeUnit);
+					
+					continue;
+				
+				}
+				
+				//	Outside BMP, surrogates required
+				cp-=0x10000;
+				Write(out,static_cast<CodeUnit>((cp>>10)+0xD800),reverse);
+				out+=sizeof(CodeUnit);
+				Write(out,static_cast<CodeUnit>((cp&0x3FF)+0xDC00),reverse);
+				out+=sizeof(CodeUnit);
+			
+			}
+		
+		}
+	
+	}
+	
+	
 	static bool is_lead (UTF16::CodeUnit cu) noexcept {
 	
 		return (cu>=0xD800) && (cu<=0xDBFF);
@@ -124,6 +262,89 @@ namespace Unicode {
 	}
 	
 	
+	const unsigned char * UTF16::BulkDecoder (
+		CodePoint * & out,
+		const unsigned char * begin,
+		const unsigned char * limit,
+		const unsigned char * end,
+		std::optional<Unicode::Endianness> order
+	) const {
+	
+		//	Without a byte order Decoder must raise
+		//	an error
+		if (!order) {
+		
+			if (!InputOrder) return begin;
+			
+			order=*InputOrder;
+		
+		}
+		auto reverse=Reverse(*order);
+		
+		while (begin<limit) {
+		
+			//	Runs of code units which are code points by
+			//	themselves are decoded a vector at a time
+			begin=DecodeSingle(out,begin,limit,reverse);
+			if (begin==limit) break;
+			
+			auto lead=Read<CodeUnit>(begin,reverse);
+			CodePoint cp(lead);
+			std::size_t len=sizeof(CodeUnit);
+			
+			if (is_lead(lead)) {
+			
+				if (static_cast<std::size_t>(end-begin)<(sizeof(CodeUnit)*2)) break;
+				
+				auto trail=Read<CodeUnit>(begin+sizeof(CodeUnit),reverse);
+				if (!is_trail(trail)) break;
+				
+				cp=((static_cast<CodePoint::Type>(lead-0xD800)<<10)|(trail-0xDC00))+0x10000;
+				len*=2;
+			
+			}
+			
+			//	This also catches orphaned trail surrogates
+			if (!cp.IsValid()) break;
+			
+			*(out++)=cp;
+			begin+=len;
+		
+		}
+		
+		return begin;
+	
+	}
+	
+	
+	//	The decoder only ever consumes a trail surrogate
+	//	after a lead surrogate, so every code unit which
+	//	isn't a trail surrogate begins a sequence
+	const unsigned char * UTF16::Boundary (
+		const unsigned char * begin,
+		const unsigned char * where,
+		const unsigned char * end,
+		std::optional<Unicode::Endianness> order
+	) const {
+	
+		where=Encoding::Boundary(begin,where,end,order);
+		
+		if (!order) {
+		
+			if (!InputOrder) return where;
+			
+			order=*InputOrder;
+		
+		}
+		auto reverse=Reverse(*order);
+		
+		for (;static_cast<std::size_t>(end-where)>=sizeof(CodeUnit);where+=sizeof(CodeUnit)) if (!is_trail(Read<CodeUnit>(where,reverse))) return where;
+		
+		return end;
+	
+	}
+	
+	
 	ByteOrderMark UTF16::BOM () const noexcept {
 	
 		return bom;
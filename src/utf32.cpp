@@ -1,4 +1,7 @@
 #include <unicode/utf32.hpp>
+#include "simd.hpp"
+#include <cstdint>
+#include <limits>
 
 
 namespace Unicode {
@@ -8,6 +11,52 @@ namespace Unicode {
 	static const ByteOrderMark bom(bom_array);
 	
 	
+	#ifdef UNICODE_SSE2
+	//	Determines which of four 32 bit integers are
+	//	less than some value, treating both as unsigned
+	static __m128i is_below (__m128i v, std::uint32_t n) noexcept {
+	
+		auto sign=_mm_set1_epi32(std::numeric_limits<std::int32_t>::min());
+		
+		return _mm_cmplt_epi32(
+			_mm_xor_si128(v,sign),
+			_mm_xor_si128(_mm_set1_epi32(static_cast<int>(n)),sign)
+		);
+	
+	}
+	
+	
+	//	Determines which of four code points are valid,
+	//	exactly as CodePoint::IsValid does
+	static bool is_valid (__m128i v) noexcept {
+	
+		auto invalid=_mm_or_si128(
+			_mm_or_si128(
+				//	Surrogates
+				is_below(_mm_sub_epi32(v,_mm_set1_epi32(0xD800)),0x800),
+				//	The contiguous range of non-characters
+				is_below(_mm_sub_epi32(v,_mm_set1_epi32(0xFDD0)),0x20)
+			),
+			//	The last two code points of each plane
+			_mm_cmpgt_epi32(_mm_and_si128(v,_mm_set1_epi32(0xFFFF)),_mm_set1_epi32(0xFFFD))
+		);
+		
+		return _mm_movemask_epi8(_mm_andnot_si128(invalid,is_below(v,CodePoint::Max+1)))==0xFFFF;
+	
+	}
+	
+	
+	//	Reverses the bytes of four 32 bit integers
+	static __m128i swap (__m128i v) noexcept {
+	
+		v=_mm_shufflehi_epi16(_mm_shufflelo_epi16(v,_MM_SHUFFLE(2,3,0,1)),_MM_SHUFFLE(2,3,0,1));
+		
+		return _mm_or_si128(_mm_slli_epi16(v,8),_mm_srli_epi16(v,8));
+	
+	}
+	#endif
+	
+	
 	void UTF32::Encoder (std::vector<unsigned char> & buffer, CodePoint cp) const {
 	
 		Get(buffer,static_cast<CodeUnit>(cp));
@@ -15,6 +64,41 @@ namespace Unicode {
 	}
 	
 	
+	const CodePoint * UTF32::BulkCounter (std::size_t & bytes, const CodePoint * begin, const CodePoint * end) const {
+	
+		auto last=begin;
+		#ifdef UNICODE_SSE2
+		for (;(end-last)>=4;last+=4) if (!is_valid(_mm_loadu_si128(reinterpret_cast<const __m128i *>(last)))) break;
+		#endif
+		for (;(last!=end) && last->IsValid();++last);
+		bytes=static_cast<std::size_t>(last-begin)*sizeof(CodeUnit);
+		
+		return last;
+	
+	}
+	
+	
+	void UTF32::BulkEncoder (unsigned char * out, const CodePoint * begin, const CodePoint * end) const {
+	
+		auto reverse=Reverse(OutputOrder);
+		
+		//	Every code point has already been checked, so
+		//	in the native byte order this is a copy
+		#ifdef UNICODE_SSE2
+		for (;(end-begin)>=4;begin+=4,out+=16) {
+		
+			auto v=_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+			if (reverse) v=swap(v);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(out),v);
+		
+		}
+		#endif
+		
+		for (;begin!=end;++begin,out+=sizeof(CodeUnit)) Write(out,static_cast<CodeUnit>(*begin),reverse);
+	
+	}
+	
+	
 	std::optional<EncodingErrorType> UTF32::Decoder (
 		CodePoint & cp,
 		const unsigned char * & begin,
@@ -43,6 +127,99 @@ namespace Unicode {
 	}
 
 
+	const unsigned char * UTF32::BulkDecoder (
+		CodePoint * & out,
+		const unsigned char * begin,
+		const unsigned char * limit,
+		const unsigned char *,
+		std::optional<Unicode::Endianness> order
+	) const {
+	
+		//	Without a byte order Decoder must raise
+		//	an error
+		if (!order) {
+		
+			if (!InputOrder) return begin;
+			
+			order=*InputOrder;
+		
+		}
+		auto reverse=Reverse(*order);
+		
+		//	Code units are validated four at a time and,
+		//	unless their bytes must be reversed, copied
+		//	as is
+		#ifdef UNICODE_SSE2
+		for (;(limit-begin)>=16;begin+=16,out+=4) {
+		
+			auto v=_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+			if (reverse) v=swap(v);
+			if (!is_valid(v)) break;
+			
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(out),v);
+		
+		}
+		#endif
+		
+		for (;begin!=limit;begin+=sizeof(CodeUnit)) {
+		
+			CodePoint cp(Read<CodeUnit>(begin,reverse));
+			if (!cp.IsValid()) break;
+			
+			*(out++)=cp;
+		
+		}
+		
+		return begin;
+	
+	}
+	
+	
+	const unsigned char * UTF32::BulkMeasurer (
+		std::size_t & cps,
+		std::size_t * lines,
+		const unsigned char * begin,
+		const unsigned char * limit,
+		const unsigned char * end,
+		std::optional<Unicode::Endianness> order
+	) const {
+	
+		//	Counting lines requires looking at each code
+		//	point
+		if (lines!=nullptr) return Encoding::BulkMeasurer(cps,lines,begin,limit,end,order);
+		
+		if (!order) {
+		
+			if (!InputOrder) return begin;
+			
+			order=*InputOrder;
+		
+		}
+		auto reverse=Reverse(*order);
+		
+		//	Every valid code unit is a code point, so only
+		//	validation is required
+		auto start=begin;
+		auto last=begin+((limit-begin)/sizeof(CodeUnit))*sizeof(CodeUnit);
+		#ifdef UNICODE_SSE2
+		for (;(last-begin)>=16;begin+=16) {
+		
+			auto v=_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+			if (reverse) v=swap(v);
+			if (!is_valid(v)) break;
+		
+		}
+		#endif
+		
+		for (;begin!=last;begin+=sizeof(CodeUnit)) if (!CodePoint(Read<CodeUnit>(begin,reverse)).IsValid()) break;
+		
+		cps+=static_cast<std::size_t>(begin-start)/sizeof(CodeUnit);
+		
+		return begin;
+	
+	}
+	
+	
 	ByteOrderMark UTF32::BOM () const noexcept {
 	
 		return bom;
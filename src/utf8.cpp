@@ -1,4 +1,9 @@
 #include <unicode/utf8.hpp>
+#include "simd.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 
 
 namespace Unicode {
@@ -62,6 +67,62 @@ namespace Unicode {
 	}
 	
 	
+	//	Gets the number of bytes in the UTF-8 encoding
+	//	of a valid code point
+	static std::size_t count_bytes (CodePoint::Type cp) noexcept {
+	
+		return 1+
+			((cp>=0x80U) ? 1 : 0)+
+			((cp>=0x800U) ? 1 : 0)+
+			((cp>=0x10000U) ? 1 : 0);
+	
+	}
+	
+	
+	const CodePoint * UTF8::BulkCounter (std::size_t & bytes, const CodePoint * begin, const CodePoint * end) const {
+	
+		std::size_t units=0;
+		while (begin!=end) {
+		
+			//	Each code point in a run of ASCII requires
+			//	exactly one byte
+			auto ascii=skip_below(begin,end,0x80U);
+			units+=static_cast<std::size_t>(ascii-begin);
+			begin=ascii;
+			
+			//	Whatever stops a run of other code points
+			//	before the end is invalid
+			for (;(begin!=end) && (*begin>=0x80U) && begin->IsValid();++begin) units+=count_bytes(*begin);
+			if ((begin!=end) && (*begin>=0x80U)) break;
+		
+		}
+		bytes=units;
+		
+		return begin;
+	
+	}
+	
+	
+	void UTF8::BulkEncoder (unsigned char * out, const CodePoint * begin, const CodePoint * end) const {
+	
+		while (begin!=end) {
+		
+			encode_ascii(out,begin,end);
+			
+			for (;(begin!=end) && (*begin>=0x80U);++begin) {
+			
+				CodePoint::Type cp=*begin;
+				auto len=count_bytes(cp);
+				*(out++)=get_leading_byte(len,cp);
+				while ((len--)>1) *(out++)=get_continuation_byte(len,cp);
+			
+			}
+		
+		}
+	
+	}
+	
+	
 	//	Gets the number of bytes in the UTF-8 encoding
 	//	of a code point, based on the leading byte
 	static std::size_t count (unsigned char b) noexcept {
@@ -172,6 +233,516 @@ namespace Unicode {
 	}
 	
 	
+	//	Bulk decoding
+	//
+	//	Runs of ASCII are validated and widened a vector at
+	//	a time, and all other sequences are decoded directly
+	//	rather than through Decoder.  Decoding stops at the
+	//	first sequence which is not a well formed UTF-8
+	//	encoding of a valid code point (this includes overlong
+	//	sequences, surrogates, non-characters, sequences of
+	//	more than four bytes, and truncated sequences), which
+	//	leaves Decoder and the EncodingActions to handle it
+	//	exactly as they would have without bulk decoding
+	
+	
+	static bool is_continuation_byte (unsigned char b) noexcept {
+	
+		return (b&static_cast<unsigned char>(192))==128;
+	
+	}
+	
+	
+	static CodePoint::Type get_continuation_bits (unsigned char b) noexcept {
+	
+		return static_cast<CodePoint::Type>(b&static_cast<unsigned char>(63));
+	
+	}
+	
+	
+	//	Determines the length of a single multi-byte sequence
+	//	and the code point it encodes, returns zero if the
+	//	sequence must be handled by Decoder
+	static std::size_t get_sequence (CodePoint::Type & cp, const unsigned char * begin, const unsigned char * end) noexcept {
+	
+		auto avail=static_cast<std::size_t>(end-begin);
+		CodePoint::Type lead=*begin;
+		std::size_t len;
+		
+		//	Continuation bytes, and leading bytes which
+		//	may only begin overlong two byte sequences
+		if (lead<0xC2U) return 0;
+		
+		if (lead<0xE0U) {
+		
+			if (!((avail>=2) && is_continuation_byte(begin[1]))) return 0;
+			
+			cp=((lead&0x1FU)<<6)|get_continuation_bits(begin[1]);
+			len=2;
+		
+		} else if (lead<0xF0U) {
+		
+			if (!(
+				(avail>=3) &&
+				is_continuation_byte(begin[1]) &&
+				is_continuation_byte(begin[2])
+			)) return 0;
+			
+			cp=((lead&0x0FU)<<12)|(get_continuation_bits(begin[1])<<6)|get_continuation_bits(begin[2]);
+			
+			//	Overlong sequences and surrogates
+			if ((cp<0x800U) || ((cp>=0xD800U) && (cp<=0xDFFFU))) return 0;
+			
+			len=3;
+		
+		} else if (lead<0xF5U) {
+		
+			if (!(
+				(avail>=4) &&
+				is_continuation_byte(begin[1]) &&
+				is_continuation_byte(begin[2]) &&
+				is_continuation_byte(begin[3])
+			)) return 0;
+			
+			cp=((lead&0x07U)<<18)|(get_continuation_bits(begin[1])<<12)|(get_continuation_bits(begin[2])<<6)|get_continuation_bits(begin[3]);
+			
+			//	Overlong sequences and code points too
+			//	large to be valid Unicode
+			if ((cp<0x10000U) || (cp>CodePoint::Max)) return 0;
+			
+			len=4;
+		
+		//	Leading bytes which may only begin sequences
+		//	which are too large to be valid Unicode
+		} else {
+		
+			return 0;
+		
+		}
+		
+		//	Non-characters
+		if (((cp>=0xFDD0U) && (cp<=0xFDEFU)) || ((cp&0xFFFEU)==0xFFFEU)) return 0;
+		
+		return len;
+	
+	}
+	
+	
+	//	Decodes a single multi-byte sequence, returns begin
+	//	if the sequence must be handled by Decoder
+	static const unsigned char * decode_sequence (CodePoint * & out, const unsigned char * begin, const unsigned char * end) noexcept {
+	
+		CodePoint::Type cp;
+		auto len=get_sequence(cp,begin,end);
+		if (len==0) return begin;
+		
+		*(out++)=cp;
+		
+		return begin+len;
+	
+	}
+	
+	
+	//	Decodes a run of ASCII, stops at the first byte
+	//	which is not ASCII or at limit
+	static const unsigned char * decode_ascii (CodePoint * & out, const unsigned char * begin, const unsigned char * limit) noexcept {
+	
+		//	Check eight bytes at a time
+		for (;(limit-begin)>=8;begin+=8) {
+		
+			std::uint64_t word;
+			std::memcpy(&word,begin,sizeof(word));
+			
+			if ((word&0x8080808080808080ULL)!=0) break;
+			
+			for (std::size_t i=0;i<8;++i) *(out++)=begin[i];
+		
+		}
+		
+		for (;(begin!=limit) && (*begin<128);++begin) *(out++)=*begin;
+		
+		return begin;
+	
+	}
+	
+	
+	#ifdef UNICODE_SSE2
+	static const unsigned char * decode_ascii_sse2 (CodePoint * & out, const unsigned char * begin, const unsigned char * limit) noexcept {
+	
+		while ((limit-begin)>=16) {
+		
+			auto v=_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+			
+			//	Widen all sixteen bytes unconditionally, there's
+			//	always room for them since no byte decodes to
+			//	more than one code point
+			widen(out,v);
+			
+			//	Keep only those code points which precede
+			//	the first byte which is not ASCII
+			auto mask=static_cast<unsigned int>(_mm_movemask_epi8(v));
+			if (mask!=0) {
+			
+				auto n=count_trailing_zeroes(mask);
+				out+=n;
+				
+				return begin+n;
+			
+			}
+			
+			out+=16;
+			begin+=16;
+		
+		}
+		
+		return decode_ascii(out,begin,limit);
+	
+	}
+	#endif
+	
+	
+	#ifdef UNICODE_AVX2
+	__attribute__((target("avx2")))
+	static const unsigned char * decode_ascii_avx2 (CodePoint * & out, const unsigned char * begin, const unsigned char * limit) noexcept {
+	
+		while ((limit-begin)>=32) {
+		
+			auto v=_mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+			
+			auto lo=_mm256_castsi256_si128(v);
+			auto hi=_mm256_extracti128_si256(v,1);
+			auto o=reinterpret_cast<__m256i *>(out);
+			_mm256_storeu_si256(o,_mm256_cvtepu8_epi32(lo));
+			_mm256_storeu_si256(o+1,_mm256_cvtepu8_epi32(_mm_srli_si128(lo,8)));
+			_mm256_storeu_si256(o+2,_mm256_cvtepu8_epi32(hi));
+			_mm256_storeu_si256(o+3,_mm256_cvtepu8_epi32(_mm_srli_si128(hi,8)));
+			
+			auto mask=static_cast<unsigned int>(_mm256_movemask_epi8(v));
+			if (mask!=0) {
+			
+				auto n=count_trailing_zeroes(mask);
+				out+=n;
+				
+				return begin+n;
+			
+			}
+			
+			out+=32;
+			begin+=32;
+		
+		}
+		
+		return decode_ascii(out,begin,limit);
+	
+	}
+	#endif
+	
+	
+	//	Decodes sequences which begin before limit (but
+	//	which may end anywhere before end) until an
+	//	error is encountered
+	template <const unsigned char * (* ascii) (CodePoint * &, const unsigned char *, const unsigned char *) noexcept>
+	static const unsigned char * decode_kernel (CodePoint * & out, const unsigned char * begin, const unsigned char * limit, const unsigned char * end) noexcept {
+	
+		while (begin<limit) {
+		
+			if (*begin<128) {
+			
+				begin=ascii(out,begin,limit);
+				
+				continue;
+			
+			}
+			
+			auto next=decode_sequence(out,begin,end);
+			if (next==begin) break;
+			
+			begin=next;
+		
+		}
+		
+		return begin;
+	
+	}
+	
+	
+	typedef const unsigned char * (* kernel_type) (CodePoint * &, const unsigned char *, const unsigned char *, const unsigned char *) noexcept;
+	
+	
+	//	Chooses the best kernel supported by the processor
+	//	on which we're running
+	static kernel_type get_kernel () noexcept {
+	
+		#ifdef UNICODE_AVX2
+		if (__builtin_cpu_supports("avx2")) return decode_kernel<decode_ascii_avx2>;
+		#endif
+		
+		#ifdef UNICODE_SSE2
+		return decode_kernel<decode_ascii_sse2>;
+		#else
+		return decode_kernel<decode_ascii>;
+		#endif
+	
+	}
+	
+	
+	const unsigned char * UTF8::BulkDecoder (CodePoint * & out, const unsigned char * begin, const unsigned char * limit, const unsigned char * end, std::optional<Unicode::Endianness>) const {
+	
+		static const kernel_type kernel=get_kernel();
+		
+		return kernel(out,begin,limit,end);
+	
+	}
+	
+	
+	//	Bulk measuring
+	//
+	//	Sequences are validated exactly as they are when
+	//	decoding in bulk, but nothing is written.  Sixteen
+	//	bytes at a time are checked to consist of well formed
+	//	sequences of valid code points, and the code points
+	//	they contain are counted by counting the bytes which
+	//	aren't continuation bytes.  Whatever can't be checked
+	//	that way is checked one sequence at a time
+	
+	
+	//	Every code point which terminates a line is in
+	//	the range U+000A through U+000D, or is U+0085,
+	//	U+2028, or U+2029
+	static bool is_line_terminator (CodePoint::Type cp) noexcept {
+	
+		return ((cp>=0x0AU) && (cp<=0x0DU)) || (cp==0x85U) || ((cp|1U)==0x2029U);
+	
+	}
+	
+	
+	//	Measures sequences which begin before limit (but
+	//	which may end anywhere before end) one at a time
+	//	until an error is encountered
+	static const unsigned char * measure_sequences (std::size_t & cps, std::size_t * lines, const unsigned char * begin, const unsigned char * limit, const unsigned char * end) noexcept {
+	
+		while (begin<limit) {
+		
+			CodePoint::Type cp=*begin;
+			std::size_t len=1;
+			if (cp>=128) {
+			
+				len=get_sequence(cp,begin,end);
+				if (len==0) break;
+			
+			}
+			begin+=len;
+			
+			++cps;
+			
+			//	A CR immediately followed by a LF is counted
+			//	at the LF
+			if (
+				(lines!=nullptr) &&
+				is_line_terminator(cp) &&
+				!((cp==0x0DU) && (begin!=end) && (*begin==0x0AU))
+			) ++*lines;
+		
+		}
+		
+		return begin;
+	
+	}
+	
+	
+	#ifdef UNICODE_SSE2
+	//	Sums the bytes in each half of a vector, which
+	//	are each either zero or one
+	static __m128i sum (__m128i v) noexcept {
+	
+		return _mm_sad_epu8(v,_mm_setzero_si128());
+	
+	}
+	
+	
+	static std::size_t extract (__m128i v) noexcept {
+	
+		std::uint64_t halves [2];
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(halves),v);
+		
+		return static_cast<std::size_t>(halves[0]+halves[1]);
+	
+	}
+	
+	
+	static __m128i is (__m128i v, unsigned char b) noexcept {
+	
+		return _mm_cmpeq_epi8(v,_mm_set1_epi8(static_cast<char>(b)));
+	
+	}
+	
+	
+	static __m128i is_at_least (__m128i v, unsigned char b) noexcept {
+	
+		auto m=_mm_set1_epi8(static_cast<char>(b));
+		
+		return _mm_cmpeq_epi8(_mm_max_epu8(v,m),v);
+	
+	}
+	
+	
+	//	Measures sixteen bytes at a time, stops at the first
+	//	sixteen bytes which may not be valid
+	static const unsigned char * measure_sse2 (std::size_t & cps, std::size_t * lines, const unsigned char * begin, const unsigned char * limit, const unsigned char * end) noexcept {
+	
+		auto start=begin;
+		auto prev=_mm_setzero_si128();
+		auto one=_mm_set1_epi8(1);
+		auto counted=_mm_setzero_si128();
+		auto terminators=_mm_setzero_si128();
+		
+		//	The byte after each sixteen is examined to find
+		//	a LF following a CR
+		while (((limit-begin)>=16) && ((end-begin)>=17)) {
+		
+			auto v=_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+			
+			//	The bytes one, two, and three before each byte
+			auto p1=_mm_or_si128(_mm_slli_si128(v,1),_mm_srli_si128(prev,15));
+			auto p2=_mm_or_si128(_mm_slli_si128(v,2),_mm_srli_si128(prev,14));
+			auto p3=_mm_or_si128(_mm_slli_si128(v,3),_mm_srli_si128(prev,13));
+			
+			//	Continuation bytes are exactly those which are
+			//	required by the leading bytes which precede them
+			auto continuation=_mm_cmplt_epi8(v,_mm_set1_epi8(static_cast<char>(0xC0)));
+			auto required=_mm_or_si128(
+				is_at_least(p1,0xC0),
+				_mm_or_si128(is_at_least(p2,0xE0),is_at_least(p3,0xF0))
+			);
+			auto error=_mm_xor_si128(continuation,required);
+			
+			//	Leading bytes which may only begin overlong two
+			//	byte sequences or sequences too large to be valid
+			//	Unicode
+			error=_mm_or_si128(error,_mm_or_si128(
+				is(_mm_and_si128(v,_mm_set1_epi8(static_cast<char>(0xFE))),0xC0),
+				is_at_least(v,0xF5)
+			));
+			
+			//	Overlong sequences, surrogates, and code points
+			//	too large to be valid Unicode are recognizable
+			//	from their first two bytes
+			auto a0=is_at_least(v,0xA0);
+			auto n90=is_at_least(v,0x90);
+			error=_mm_or_si128(error,_mm_or_si128(
+				_mm_or_si128(_mm_andnot_si128(a0,is(p1,0xE0)),_mm_and_si128(a0,is(p1,0xED))),
+				_mm_or_si128(_mm_andnot_si128(n90,is(p1,0xF0)),_mm_and_si128(n90,is(p1,0xF4)))
+			));
+			
+			//	Non-characters are U+FDD0 through U+FDEF, and
+			//	the last two code points of each plane
+			auto be=_mm_and_si128(is(p1,0xBF),is_at_least(v,0xBE));
+			error=_mm_or_si128(error,_mm_and_si128(
+				is(p2,0xEF),
+				_mm_or_si128(
+					_mm_and_si128(is(p1,0xB7),_mm_andnot_si128(is_at_least(v,0xB0),n90)),
+					be
+				)
+			));
+			error=_mm_or_si128(error,_mm_and_si128(
+				_mm_and_si128(is_at_least(p3,0xF0),is(_mm_and_si128(p2,_mm_set1_epi8(0x0F)),0x0F)),
+				be
+			));
+			
+			if (_mm_movemask_epi8(error)!=0) break;
+			
+			counted=_mm_add_epi64(counted,sum(_mm_andnot_si128(continuation,one)));
+			
+			if (lines!=nullptr) {
+			
+				//	U+0085 is counted at its second byte, and
+				//	U+2028 and U+2029 at their third
+				auto next=_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin+1));
+				auto ascii=_mm_andnot_si128(
+					_mm_or_si128(is_at_least(v,0x0E),_mm_and_si128(is(v,0x0D),is(next,0x0A))),
+					is_at_least(v,0x0A)
+				);
+				auto nel=_mm_and_si128(is(v,0x85),is(p1,0xC2));
+				auto separators=_mm_and_si128(
+					is(_mm_or_si128(v,_mm_set1_epi8(1)),0xA9),
+					_mm_and_si128(is(p1,0x80),is(p2,0xE2))
+				);
+				terminators=_mm_add_epi64(
+					terminators,
+					sum(_mm_and_si128(_mm_or_si128(ascii,_mm_or_si128(nel,separators)),one))
+				);
+			
+			}
+			
+			prev=v;
+			begin+=16;
+		
+		}
+		
+		cps+=extract(counted);
+		if (lines!=nullptr) *lines+=extract(terminators);
+		
+		//	A sequence which begins in the last three bytes
+		//	counted may end after them, in which case its
+		//	remaining bytes weren't checked, so it must be
+		//	measured again
+		if (begin!=start) {
+		
+			const unsigned char leads []={0xC0,0xE0,0xF0};
+			for (std::size_t i=0;i<3;++i) if (*(begin-i-1)>=leads[i]) {
+			
+				--cps;
+				
+				return begin-i-1;
+			
+			}
+		
+		}
+		
+		return begin;
+	
+	}
+	#endif
+	
+	
+	const unsigned char * UTF8::BulkMeasurer (std::size_t & cps, std::size_t * lines, const unsigned char * begin, const unsigned char * limit, const unsigned char * end, std::optional<Unicode::Endianness>) const {
+	
+		while (begin<limit) {
+		
+			#ifdef UNICODE_SSE2
+			begin=measure_sse2(cps,lines,begin,limit,end);
+			#endif
+			
+			//	Whatever couldn't be measured sixteen bytes at
+			//	a time is measured a sequence at a time, a little
+			//	more than sixteen bytes' worth before trying
+			//	again
+			auto last=begin+std::min<std::ptrdiff_t>(limit-begin,32);
+			auto next=measure_sequences(cps,lines,begin,last,end);
+			if (next<last) return next;
+			
+			begin=next;
+		
+		}
+		
+		return begin;
+	
+	}
+	
+	
+	//	The decoder only ever consumes continuation bytes
+	//	after the first byte of a sequence, even when the
+	//	sequence is malformed, so every other byte begins
+	//	a sequence
+	const unsigned char * UTF8::Boundary (const unsigned char *, const unsigned char * where, const unsigned char * end, std::optional<Unicode::Endianness>) const {
+	
+		while ((where!=end) && is_continuation_byte(*where)) ++where;
+		
+		return where;
+	
+	}
+	
+	
 	ByteOrderMark UTF8::BOM () const noexcept {
 	
 		return bom;